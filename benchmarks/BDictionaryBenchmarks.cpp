@@ -0,0 +1,95 @@
+/**
+* @file      BDictionaryBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of lookups in dictionaries.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "Decoder.h"
+#include "Encoder.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+/**
+* @brief Returns @a count pseudo-random 20-byte keys (like info hashes).
+*/
+std::vector<std::string> createInfoHashes(std::size_t count) {
+	std::vector<std::string> infoHashes;
+	std::uint64_t x = 88172645463325252ULL;
+	for (std::size_t i = 0; i < count; ++i) {
+		std::string infoHash(20, char());
+		for (auto &c : infoHash) {
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+			c = static_cast<char>(x);
+		}
+		infoHashes.push_back(infoHash);
+	}
+	return infoHashes;
+}
+
+} // anonymous namespace
+
+BENCHMARK(WideDictionaryLookup) {
+	const std::size_t numOfKeys = 100000;
+	auto infoHashes = createInfoHashes(numOfKeys);
+
+	// The same data in a std::map ordered by the string values, which is
+	// what the lookups in BDictionary cost without the hash index.
+	std::map<std::string, std::shared_ptr<BItem>> orderedMap;
+	auto dictionary = BDictionary::create();
+	for (std::size_t i = 0; i < numOfKeys; ++i) {
+		auto value = BInteger::create(static_cast<BInteger::ValueType>(i));
+		orderedMap[infoHashes[i]] = value;
+		(*dictionary)[infoHashes[i]] = value;
+	}
+
+	measure("std::map lookups (100k keys)", 0, [&]() {
+		std::size_t found = 0;
+		for (const auto &infoHash : infoHashes) {
+			found += orderedMap.find(infoHash) != orderedMap.end();
+		}
+		doNotOptimizeAway(found);
+	});
+
+	measure("hash-indexed BDictionary lookups (100k keys)", 0, [&]() {
+		std::size_t found = 0;
+		for (const auto &infoHash : infoHashes) {
+			found += dictionary->find(infoHash) != dictionary->end();
+		}
+		doNotOptimizeAway(found);
+	});
+}
+
+BENCHMARK(WideDictionaryDecoding) {
+	const std::size_t numOfKeys = 100000;
+	auto infoHashes = createInfoHashes(numOfKeys);
+	auto dictionary = BDictionary::create();
+	for (std::size_t i = 0; i < numOfKeys; ++i) {
+		(*dictionary)[infoHashes[i]] =
+			BInteger::create(static_cast<BInteger::ValueType>(i));
+	}
+	// Encoded dictionaries have their keys sorted.
+	std::string encodedDictionary = encode(dictionary);
+
+	measure("decode (100k sorted keys)", encodedDictionary.size(), [&]() {
+		doNotOptimizeAway(decode(encodedDictionary)->as<BDictionary>()->size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,245 @@
+/**
+* @file      BItemBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of casting items and dispatching over their types.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BItemDispatch.h"
+#include "BItemVisitor.h"
+#include "BList.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "Decoder.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+/**
+* @brief Keys of a torrent.
+*
+* They are created in advance, as a program looking up the same keys over and
+* over does, so that the measured time is spent in the lookups and casts.
+*/
+struct TorrentKeys {
+	BDictionary::key_type info = BString::create("info");
+	BDictionary::key_type files = BString::create("files");
+	BDictionary::key_type length = BString::create("length");
+	BDictionary::key_type path = BString::create("path");
+};
+
+/**
+* @brief Returns the total length of the files in the given torrent.
+*
+* The fields are accessed and cast as they were before the items had a type
+* tag, i.e. with @c dynamic_pointer_cast.
+*/
+BInteger::ValueType totalLengthByDynamicCasts(
+		const std::shared_ptr<BDictionary> &torrent, const TorrentKeys &keys) {
+	auto info = std::dynamic_pointer_cast<BDictionary>(
+		torrent->find(keys.info)->second);
+	auto files = std::dynamic_pointer_cast<BList>(info->find(keys.files)->second);
+	BInteger::ValueType length = 0;
+	for (const auto &file : *files) {
+		auto fileDict = std::dynamic_pointer_cast<BDictionary>(file);
+		length += std::dynamic_pointer_cast<BInteger>(
+			fileDict->find(keys.length)->second)->value();
+		length += static_cast<BInteger::ValueType>(
+			std::dynamic_pointer_cast<BList>(fileDict->find(keys.path)->second)->size());
+	}
+	return length;
+}
+
+/**
+* @brief Like totalLengthByDynamicCasts(), but by using getValue().
+*/
+BInteger::ValueType totalLengthByGetValue(
+		const std::shared_ptr<BDictionary> &torrent, const TorrentKeys &keys) {
+	auto files = torrent->getValue<BDictionary>(keys.info)->getValue<BList>(keys.files);
+	BInteger::ValueType length = 0;
+	for (std::size_t i = 0, e = files->size(); i < e; ++i) {
+		auto file = files->getItem<BDictionary>(i);
+		length += file->getValue<BInteger>(keys.length)->value();
+		length += static_cast<BInteger::ValueType>(
+			file->getValue<BList>(keys.path)->size());
+	}
+	return length;
+}
+
+/**
+* @brief Like totalLengthByGetValue(), but by using getValuePtr().
+*/
+BInteger::ValueType totalLengthByGetValuePtr(
+		const std::shared_ptr<BDictionary> &torrent, const TorrentKeys &keys) {
+	auto files = torrent->getValuePtr<BDictionary>(keys.info)->getValuePtr<BList>(keys.files);
+	BInteger::ValueType length = 0;
+	for (std::size_t i = 0, e = files->size(); i < e; ++i) {
+		auto file = files->getItemPtr<BDictionary>(i);
+		length += file->getValuePtr<BInteger>(keys.length)->value();
+		length += static_cast<BInteger::ValueType>(
+			file->getValuePtr<BList>(keys.path)->size());
+	}
+	return length;
+}
+
+/**
+* @brief Visitor computing the sum of the integers and the lengths of the
+*        strings in the visited item.
+*/
+class SummingVisitor: public BItemVisitor {
+public:
+	virtual void visit(BDictionary *bDictionary) override {
+		for (const auto &item : *bDictionary) {
+			item.second->accept(this);
+		}
+	}
+
+	virtual void visit(BInteger *bInteger) override {
+		sum += static_cast<std::size_t>(bInteger->value());
+	}
+
+	virtual void visit(BList *bList) override {
+		for (const auto &item : *bList) {
+			item->accept(this);
+		}
+	}
+
+	virtual void visit(BString *bString) override {
+		sum += bString->length();
+	}
+
+public:
+	/// The computed sum.
+	std::size_t sum = 0;
+};
+
+/**
+* @brief The same as SummingVisitor, but to be used with dispatch().
+*/
+class SummingFunction {
+public:
+	std::size_t operator()(const BDictionary &bDictionary) const {
+		std::size_t sum = 0;
+		for (const auto &item : bDictionary) {
+			sum += dispatch(*item.second, *this);
+		}
+		return sum;
+	}
+
+	std::size_t operator()(const BInteger &bInteger) const {
+		return static_cast<std::size_t>(bInteger.value());
+	}
+
+	std::size_t operator()(const BList &bList) const {
+		std::size_t sum = 0;
+		for (const auto &item : bList) {
+			sum += dispatch(*item, *this);
+		}
+		return sum;
+	}
+
+	std::size_t operator()(const BString &bString) const {
+		return bString.length();
+	}
+};
+
+} // anonymous namespace
+
+BENCHMARK(ItemCasting) {
+	const std::size_t numOfItems = 1000000;
+	auto list = BList::create();
+	for (std::size_t i = 0; i < numOfItems; ++i) {
+		list->push_back(BInteger::create(static_cast<BInteger::ValueType>(i)));
+	}
+	const std::size_t bytesPerRun = numOfItems * sizeof(BList::value_type);
+
+	// Summing the integers in a list, as a single-threaded transform does.
+	measure("dynamic_pointer_cast<T>() (baseline, 1M items)", bytesPerRun, [&]() {
+		BInteger::ValueType sum = 0;
+		for (const auto &item : *list) {
+			sum += std::dynamic_pointer_cast<BInteger>(item)->value();
+		}
+		doNotOptimizeAway(static_cast<std::size_t>(sum));
+	});
+
+	measure("as<T>() (1M items)", bytesPerRun, [&]() {
+		BInteger::ValueType sum = 0;
+		for (const auto &item : *list) {
+			sum += item->as<BInteger>()->value();
+		}
+		doNotOptimizeAway(static_cast<std::size_t>(sum));
+	});
+
+	measure("itemCast<T>() (1M items)", bytesPerRun, [&]() {
+		BInteger::ValueType sum = 0;
+		for (const auto &item : *list) {
+			sum += itemCast<BInteger>(item)->value();
+		}
+		doNotOptimizeAway(static_cast<std::size_t>(sum));
+	});
+
+	measure("asPtr<T>() (1M items)", bytesPerRun, [&]() {
+		BInteger::ValueType sum = 0;
+		for (const auto &item : *list) {
+			sum += item->asPtr<BInteger>()->value();
+		}
+		doNotOptimizeAway(static_cast<std::size_t>(sum));
+	});
+
+	measure("failed as<T>() (1M items)", bytesPerRun, [&]() {
+		std::size_t numOfLists = 0;
+		for (const auto &item : *list) {
+			numOfLists += item->as<BList>() ? 1 : 0;
+		}
+		doNotOptimizeAway(numOfLists);
+	});
+}
+
+BENCHMARK(FieldAccess) {
+	std::string torrent(createTorrent(100000, 0));
+	auto root = decode(torrent)->as<BDictionary>();
+	TorrentKeys keys;
+	// Without this, the first run would also convert the packed paths.
+	totalLengthByGetValue(root, keys);
+
+	// Summing the lengths of the files in a decoded torrent. The throughputs
+	// are relative to the size of the bencoded torrent.
+	measure("dynamic_pointer_cast<T>() (baseline)", torrent.size(), [&]() {
+		doNotOptimizeAway(static_cast<std::size_t>(totalLengthByDynamicCasts(root, keys)));
+	});
+
+	measure("getValue<T>() and getItem<T>()", torrent.size(), [&]() {
+		doNotOptimizeAway(static_cast<std::size_t>(totalLengthByGetValue(root, keys)));
+	});
+
+	measure("getValuePtr<T>() and getItemPtr<T>()", torrent.size(), [&]() {
+		doNotOptimizeAway(static_cast<std::size_t>(totalLengthByGetValuePtr(root, keys)));
+	});
+}
+
+BENCHMARK(ItemDispatch) {
+	std::string torrent(createTorrent(100000, 0));
+	auto root = decode(torrent);
+	root->freeze();
+
+	measure("BItemVisitor (baseline)", torrent.size(), [&]() {
+		SummingVisitor visitor;
+		root->accept(&visitor);
+		doNotOptimizeAway(visitor.sum);
+	});
+
+	measure("dispatch()", torrent.size(), [&]() {
+		doNotOptimizeAway(dispatch(*root, SummingFunction()));
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,97 @@
+/**
+* @file      BListBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of bulk modifications of lists.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "BInteger.h"
+#include "BList.h"
+#include "BenchmarkUtils.h"
+#include "Decoder.h"
+#include "Encoder.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+/**
+* @brief Creates a list of @a count integers (peers are usually stored as a
+*        list of small items, so the type of the items is not important).
+*/
+std::shared_ptr<BList> createList(std::size_t count) {
+	auto list = BList::create();
+	for (std::size_t i = 0; i < count; ++i) {
+		list->push_back(BInteger::create(static_cast<BInteger::ValueType>(i)));
+	}
+	return list;
+}
+
+} // anonymous namespace
+
+BENCHMARK(ListBulkModifications) {
+	const std::size_t numOfItems = 1000000;
+	auto original = createList(numOfItems);
+	const std::size_t bytesPerRun = numOfItems * sizeof(BList::value_type);
+
+	// Every run modifies a fresh copy, so the cost of copying is measured
+	// separately and has to be subtracted from the other results.
+	measure("copy (1M items)", bytesPerRun, [&]() {
+		auto list = BList::create(original->value());
+		doNotOptimizeAway(list->size());
+	});
+
+	measure("range_erase of middle half (1M items)", bytesPerRun, [&]() {
+		auto list = BList::create(original->value());
+		list->range_erase(numOfItems / 4, numOfItems / 4 * 3);
+		doNotOptimizeAway(list->size());
+	});
+
+	measure("remove_if of odd items (1M items)", bytesPerRun, [&]() {
+		auto list = BList::create(original->value());
+		list->remove_if([](const BList::value_type &item) {
+			return item->as<BInteger>()->value() % 2 != 0;
+		});
+		doNotOptimizeAway(list->size());
+	});
+
+	auto inserted = createList(numOfItems / 2);
+	measure("insert of 500k items (1M items)", bytesPerRun, [&]() {
+		auto list = BList::create(original->value());
+		list->insert(list->begin() + numOfItems / 2, inserted->begin(),
+			inserted->end());
+		doNotOptimizeAway(list->size());
+	});
+}
+
+BENCHMARK(PackedListDecoding) {
+	// A list of 1M integers occupies about 8 MB in the packed form, compared
+	// to more than 50 MB when every integer is a separate BInteger.
+	const std::size_t numOfItems = 1000000;
+	std::string encodedList = encode(createList(numOfItems));
+
+	auto decoder = Decoder::create();
+	measure("decode into items (1M integers)", encodedList.size(), [&]() {
+		decoder->setListPacking(false);
+		doNotOptimizeAway(decoder->decode(encodedList)->as<BList>()->size());
+	});
+
+	measure("decode into packed list (1M integers)", encodedList.size(), [&]() {
+		decoder->setListPacking(true);
+		doNotOptimizeAway(decoder->decode(encodedList)->as<BList>()->size());
+	});
+
+	decoder->setListPacking(true);
+	auto packedList = decoder->decode(encodedList);
+	measure("encode packed list (1M integers)", encodedList.size(), [&]() {
+		doNotOptimizeAway(encode(packedList).size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,130 @@
+/**
+* @file      BenchmarkUtils.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the benchmark utilities and of the benchmarker.
+*/
+
+#include "BenchmarkUtils.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+/// Minimal duration of a single measurement.
+const std::chrono::milliseconds MIN_MEASUREMENT_TIME(300);
+
+/// Registered benchmarks (name, function).
+std::vector<std::pair<const char *, void (*)()>> &registeredBenchmarks() {
+	static std::vector<std::pair<const char *, void (*)()>> benchmarks;
+	return benchmarks;
+}
+
+/// Sink for results that have to be computed.
+volatile std::size_t sink;
+
+} // anonymous namespace
+
+/**
+* @brief Registers the given @a benchmark under the given @a name.
+*/
+BenchmarkRegistration::BenchmarkRegistration(const char *name,
+		void (*benchmark)()) {
+	registeredBenchmarks().emplace_back(name, benchmark);
+}
+
+/**
+* @brief Repeatedly calls @a run and prints the average time per run.
+*
+* @param[in] label Label of the measurement.
+* @param[in] bytesPerRun Number of bytes processed in a single run (used to
+*                        print throughput, pass @c 0 to omit it).
+* @param[in] run Function to be measured.
+*/
+void measure(const std::string &label, std::size_t bytesPerRun,
+		const std::function<void ()> &run) {
+	using Clock = std::chrono::steady_clock;
+
+	// Warm up caches and allocators.
+	run();
+
+	std::size_t runs = 0;
+	auto start = Clock::now();
+	auto elapsed = Clock::duration::zero();
+	do {
+		run();
+		++runs;
+		elapsed = Clock::now() - start;
+	} while (elapsed < MIN_MEASUREMENT_TIME);
+
+	double nsPerRun = std::chrono::duration<double, std::nano>(elapsed).count() / runs;
+	std::printf("  %-48s %14.1f ns/run", label.c_str(), nsPerRun);
+	if (bytesPerRun > 0) {
+		std::printf(" %10.1f MB/s", bytesPerRun / nsPerRun * 1e3);
+	}
+	std::printf("\n");
+}
+
+/**
+* @brief Makes sure that the computation of @a value is not optimized away.
+*/
+void doNotOptimizeAway(std::size_t value) {
+	sink = sink + value;
+}
+
+/**
+* @brief Returns bencoded metadata of a torrent with @a numOfFiles files and
+*        @a numOfPieces pieces.
+*
+* The path of every file consists of a directory and a name. The hashes of
+* the pieces are pseudorandom, so like in real torrents, they are binary data
+* rather than text.
+*/
+std::string createTorrent(std::size_t numOfFiles, std::size_t numOfPieces) {
+	std::string pieces(numOfPieces * 20, char());
+	std::uint64_t x = 88172645463325252ULL;
+	for (auto &c : pieces) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		c = static_cast<char>(x);
+	}
+
+	std::string data("d8:announce31:http://tracker.example.com:6969"
+		"4:infod5:filesl");
+	for (std::size_t i = 0; i < numOfFiles; ++i) {
+		std::string name("file" + std::to_string(i) + ".txt");
+		data += "d6:lengthi" + std::to_string(i * 1000 + 1) + "e4:pathl" +
+			"9:directory" + std::to_string(name.size()) + ":" + name + "ee";
+	}
+	data += "e4:name7:torrent12:piece lengthi262144e6:pieces" +
+		std::to_string(pieces.size()) + ":" + pieces + "ee";
+	return data;
+}
+
+} // namespace benchmarks
+} // namespace bencoding
+
+/**
+* @brief Runs all registered benchmarks whose name contains the first argument
+*        (or all benchmarks when there is no argument).
+*/
+int main(int argc, char **argv) {
+	using namespace bencoding::benchmarks;
+
+	const char *filter = argc > 1 ? argv[1] : "";
+	for (const auto &benchmark : registeredBenchmarks()) {
+		if (std::strstr(benchmark.first, filter)) {
+			std::printf("%s\n", benchmark.first);
+			benchmark.second();
+		}
+	}
+	return 0;
+}
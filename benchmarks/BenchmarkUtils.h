@@ -0,0 +1,53 @@
+/**
+* @file      BenchmarkUtils.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmark utilities.
+*/
+
+#ifndef BENCODING_BENCHMARK_UTILS_H
+#define BENCODING_BENCHMARK_UTILS_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/**
+* @brief Defines a benchmark with the given @a name.
+*
+* Usage:
+* @code
+* BENCHMARK(EncodingOfIntegers) {
+*     // Prepare data.
+*     measure("encode", dataSize, [&]() { ... });
+* }
+* @endcode
+*/
+#define BENCHMARK(name) \
+	void name(); \
+	static ::bencoding::benchmarks::BenchmarkRegistration \
+		name##Registration(#name, name); \
+	void name()
+
+namespace bencoding {
+namespace benchmarks {
+
+/**
+* @brief Registers a benchmark so that it is run by the benchmarker.
+*/
+class BenchmarkRegistration {
+public:
+	BenchmarkRegistration(const char *name, void (*benchmark)());
+};
+
+void measure(const std::string &label, std::size_t bytesPerRun,
+	const std::function<void ()> &run);
+void doNotOptimizeAway(std::size_t value);
+
+std::string createTorrent(std::size_t numOfFiles, std::size_t numOfPieces);
+
+} // namespace benchmarks
+} // namespace bencoding
+
+#endif
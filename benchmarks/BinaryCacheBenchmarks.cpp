@@ -0,0 +1,52 @@
+/**
+* @file      BinaryCacheBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of the binary cache of decoded data.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "BDictionary.h"
+#include "BList.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "BinaryCache.h"
+#include "Decoder.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+BENCHMARK(BinaryCacheLoading) {
+	std::string torrent(createTorrent(100000, 100000));
+	std::string image(bencodeToBinaryCache(torrent));
+
+	measure("creation from bencode", torrent.size(), [&]() {
+		doNotOptimizeAway(bencodeToBinaryCache(torrent).size());
+	});
+
+	// Loading the torrent and reading its name and the number of its files.
+	// The throughputs are relative to the size of the bencoded torrent.
+	measure("decode() + lookups (baseline)", torrent.size(), [&]() {
+		auto root = decode(torrent)->as<BDictionary>();
+		auto info = (*root)[BString::create("info")]->as<BDictionary>();
+		auto files = (*info)[BString::create("files")]->as<BList>();
+		doNotOptimizeAway(files->size() +
+			(*info)[BString::create("name")]->as<BString>()->value()->size());
+	});
+
+	measure("opening a cache + lookups", torrent.size(), [&]() {
+		auto info = BinaryCache(image).root().find("info");
+		auto files = info.find("files");
+		doNotOptimizeAway(files.size() + info.find("name").stringValue().size());
+	});
+
+	measure("conversion to bencode", torrent.size(), [&]() {
+		doNotOptimizeAway(binaryCacheToBencode(BinaryCache(image).root()).size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,72 @@
+/**
+* @file      CompactPeersBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of decoding and encoding compact peers.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "CompactPeers.h"
+#include "Encoder.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+BENCHMARK(CompactPeers) {
+	const std::size_t numOfAnnounces = 10000;
+	const std::size_t numOfPeers = 200;
+	std::vector<IPv4Peer> peers(numOfPeers);
+	for (std::size_t i = 0; i < numOfPeers; ++i) {
+		peers[i].address = static_cast<std::uint32_t>(0x0a000000 + i);
+		peers[i].port = static_cast<std::uint16_t>(6881 + i);
+	}
+
+	measure("BString + encode() (10k x 200 peers)", 0, [&]() {
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < numOfAnnounces; ++i) {
+			std::string compactPeers;
+			for (const auto &peer : peers) {
+				compactPeers += static_cast<char>(peer.address >> 24);
+				compactPeers += static_cast<char>(peer.address >> 16);
+				compactPeers += static_cast<char>(peer.address >> 8);
+				compactPeers += static_cast<char>(peer.address);
+				compactPeers += static_cast<char>(peer.port >> 8);
+				compactPeers += static_cast<char>(peer.port);
+			}
+			size += encode(BString::create(compactPeers)).size();
+		}
+		doNotOptimizeAway(size);
+	});
+
+	char buffer[numOfPeers * COMPACT_IPV4_PEER_SIZE + 16];
+	measure("writeCompactPeers() (10k x 200 peers)", 0, [&]() {
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < numOfAnnounces; ++i) {
+			EncodedWriter writer(buffer);
+			writeCompactPeers(writer, peers.data(), peers.size());
+			size += writer.size();
+		}
+		doNotOptimizeAway(size);
+	});
+
+	EncodedWriter writer(buffer);
+	writeCompactPeers(writer, peers.data(), peers.size());
+	StringRef compactPeers(buffer + 4, numOfPeers * COMPACT_IPV4_PEER_SIZE);
+	std::vector<IPv4Peer> decodedPeers;
+	measure("decodeCompactPeers() (10k x 200 peers)",
+			numOfAnnounces * compactPeers.size(), [&]() {
+		for (std::size_t i = 0; i < numOfAnnounces; ++i) {
+			decodeCompactPeers(compactPeers, decodedPeers);
+		}
+		doNotOptimizeAway(decodedPeers.back().port);
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,52 @@
+/**
+* @file      EncodedWriterBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of writing messages with a fixed structure.
+*/
+
+#include <cstddef>
+#include <string>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "EncodedWriter.h"
+#include "Encoder.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+BENCHMARK(TrackerResponseEncoding) {
+	const std::size_t numOfResponses = 10000;
+	// 50 peers in the compact form.
+	std::string peers(50 * 6, 'p');
+
+	measure("BDictionary + encode() (10k responses)", 0, [&]() {
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < numOfResponses; ++i) {
+			auto response = BDictionary::create();
+			(*response)["interval"] = BInteger::create(1800);
+			(*response)["peers"] = BString::create(peers);
+			size += encode(response).size();
+		}
+		doNotOptimizeAway(size);
+	});
+
+	measure("FixedString + EncodedWriter (10k responses)", 0, [&]() {
+		constexpr auto prefix = fixedString("d") + encodedString("interval") +
+			encodedInteger<1800>() + encodedString("peers");
+		char buffer[512];
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < numOfResponses; ++i) {
+			EncodedWriter writer(buffer);
+			writer.write(prefix).writeString(peers).write(fixedString("e"));
+			size += writer.size();
+		}
+		doNotOptimizeAway(size);
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,105 @@
+/**
+* @file      IntegerFormattingBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of the formatting of integers.
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "Encoder.h"
+#include "PrettyPrinter.h"
+#include "Utils.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+/**
+* @brief Creates a scrape response with @a numOfFiles files.
+*
+* Every file is keyed by a 20-byte info hash and has the @c complete, @c
+* downloaded, and @c incomplete counters, so the response is dominated by
+* integers.
+*/
+std::shared_ptr<BDictionary> createScrapeResponse(std::size_t numOfFiles) {
+	auto files = BDictionary::create();
+	std::uint64_t x = 88172645463325252ULL;
+	for (std::size_t i = 0; i < numOfFiles; ++i) {
+		std::string infoHash(20, char());
+		for (auto &c : infoHash) {
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+			c = static_cast<char>(x);
+		}
+		auto file = BDictionary::create();
+		(*file)["complete"] = BInteger::create(static_cast<std::int64_t>(x % 100000));
+		(*file)["downloaded"] = BInteger::create(static_cast<std::int64_t>(x % 10000000));
+		(*file)["incomplete"] = BInteger::create(static_cast<std::int64_t>(x % 1000));
+		(*files)[BString::create(infoHash)] = file;
+	}
+	auto response = BDictionary::create();
+	(*response)["files"] = files;
+	return response;
+}
+
+/**
+* @brief Returns integers of various magnitudes (and signs).
+*/
+std::vector<std::int64_t> createIntegers(std::size_t count) {
+	std::vector<std::int64_t> integers;
+	std::int64_t magnitude = 1;
+	for (std::size_t i = 0; i < count; ++i) {
+		magnitude = magnitude > INT64_MAX / 10 ? 1 : magnitude * 10;
+		std::int64_t value = magnitude + static_cast<std::int64_t>(i);
+		integers.push_back(i % 3 == 0 ? -value : value);
+	}
+	return integers;
+}
+
+} // anonymous namespace
+
+BENCHMARK(IntegerFormatting) {
+	auto integers = createIntegers(10000);
+
+	measure("std::to_string (10k integers)", 0, [&]() {
+		std::size_t total = 0;
+		for (auto i : integers) {
+			total += std::to_string(i).size();
+		}
+		doNotOptimizeAway(total);
+	});
+
+	measure("writeDecimal (10k integers)", 0, [&]() {
+		std::size_t total = 0;
+		char buffer[MAX_DECIMAL_LENGTH];
+		for (auto i : integers) {
+			total += writeDecimal(buffer, i);
+		}
+		doNotOptimizeAway(total);
+	});
+}
+
+BENCHMARK(ScrapeResponseWriting) {
+	auto response = createScrapeResponse(100000);
+	std::size_t encodedSize = encode(response).size();
+
+	measure("encode (100k files)", encodedSize, [&]() {
+		doNotOptimizeAway(encode(response).size());
+	});
+
+	measure("getPrettyRepr (100k files)", encodedSize, [&]() {
+		doNotOptimizeAway(getPrettyRepr(response).size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,130 @@
+/**
+* @file      JsonBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of the transcoding between bencoded data and JSON.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BList.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "Decoder.h"
+#include "Encoder.h"
+#include "Json.h"
+#include "PrettyPrinter.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+/**
+* @brief Returns a tracker response in JSON with @a numOfPeers peers.
+*
+* When @a sortedKeys is @c false, the keys of the objects are not sorted.
+*/
+std::string createJsonTrackerResponse(std::size_t numOfPeers,
+		bool sortedKeys) {
+	std::string json(sortedKeys ?
+		"{\"complete\": 100, \"interval\": 1800, \"peers\": [" :
+		"{\"peers\": [");
+	for (std::size_t i = 0; i < numOfPeers; ++i) {
+		std::string ip("\"10.0." + std::to_string(i / 256 % 256) + "." +
+			std::to_string(i % 256) + "\"");
+		std::string peerId("\"-XX0001-" + std::to_string(100000000000 + i) +
+			"\"");
+		std::string port(std::to_string(6881 + i % 1000));
+		json += i > 0 ? ", " : "";
+		json += sortedKeys ?
+			"{\"ip\": " + ip + ", \"peer id\": " + peerId + ", \"port\": " +
+				port + "}" :
+			"{\"port\": " + port + ", \"peer id\": " + peerId + ", \"ip\": " +
+				ip + "}";
+	}
+	json += sortedKeys ? "]}" : "], \"interval\": 1800, \"complete\": 100}";
+	return json;
+}
+
+/**
+* @brief Returns a tracker response with @a numOfPeers peers built from
+*        items.
+*/
+std::shared_ptr<BDictionary> createTrackerResponse(std::size_t numOfPeers) {
+	auto response = BDictionary::create();
+	auto peers = BList::create();
+	for (std::size_t i = 0; i < numOfPeers; ++i) {
+		auto peer = BDictionary::create();
+		(*peer)[BString::create("ip")] = BString::create("10.0." +
+			std::to_string(i / 256 % 256) + "." + std::to_string(i % 256));
+		(*peer)[BString::create("peer id")] = BString::create("-XX0001-" +
+			std::to_string(100000000000 + i));
+		(*peer)[BString::create("port")] = BInteger::create(
+			static_cast<BInteger::ValueType>(6881 + i % 1000));
+		peers->push_back(peer);
+	}
+	(*response)[BString::create("complete")] = BInteger::create(100);
+	(*response)[BString::create("interval")] = BInteger::create(1800);
+	(*response)[BString::create("peers")] = peers;
+	return response;
+}
+
+} // anonymous namespace
+
+BENCHMARK(BencodeToJson) {
+	std::string torrent(createTorrent(50000, 100000));
+
+	measure("transcoding into a string", torrent.size(), [&]() {
+		doNotOptimizeAway(bencodeToJson(torrent).size());
+	});
+
+	measure("transcoding into a stream", torrent.size(), [&]() {
+		std::ostringstream output;
+		bencodeToJson(torrent, output);
+		doNotOptimizeAway(static_cast<std::size_t>(output.tellp()));
+	});
+
+	measure("transcoding with hex binary strings", torrent.size(), [&]() {
+		doNotOptimizeAway(bencodeToJson(torrent, JsonBinaryStrings::Hex).size());
+	});
+
+	auto printer = PrettyPrinter::create();
+	measure("decode() + getPrettyRepr() (baseline)", torrent.size(), [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(decode(torrent)).size());
+	});
+}
+
+BENCHMARK(JsonToBencode) {
+	const std::size_t numOfPeers = 100000;
+	std::string sortedJson(createJsonTrackerResponse(numOfPeers, true));
+	std::string unsortedJson(createJsonTrackerResponse(numOfPeers, false));
+
+	measure("transcoding (sorted keys)", sortedJson.size(), [&]() {
+		doNotOptimizeAway(jsonToBencode(sortedJson).size());
+	});
+
+	measure("transcoding (unsorted keys)", unsortedJson.size(), [&]() {
+		doNotOptimizeAway(jsonToBencode(unsortedJson).size());
+	});
+
+	measure("transcoding into a stream", unsortedJson.size(), [&]() {
+		std::ostringstream output;
+		jsonToBencode(unsortedJson, output);
+		doNotOptimizeAway(static_cast<std::size_t>(output.tellp()));
+	});
+
+	// What a caller without the transcoder does after parsing the JSON:
+	// building items for every key and value and encoding them.
+	measure("building items + encode() (baseline)", sortedJson.size(), [&]() {
+		doNotOptimizeAway(encode(createTrackerResponse(numOfPeers)).size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,59 @@
+/**
+* @file      KrpcBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of decoding and encoding KRPC messages.
+*/
+
+#include <cstddef>
+#include <string>
+
+#include "BDictionary.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "Decoder.h"
+#include "Encoder.h"
+#include "Krpc.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+BENCHMARK(KrpcMessages) {
+	const std::size_t numOfMessages = 100000;
+	const std::string query("d1:ad2:id20:abcdefghij01234567899:info_hash"
+		"20:mnopqrstuvwxyz123456e1:q9:get_peers1:t2:aa1:y1:qe");
+
+	measure("decode() + encode() (100k queries)", 0, [&]() {
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < numOfMessages; ++i) {
+			auto message = decode(query)->as<BDictionary>();
+			auto response = BDictionary::create();
+			auto returnValues = BDictionary::create();
+			(*returnValues)["id"] = (*(*message)["a"]->as<BDictionary>())["id"];
+			(*response)["r"] = returnValues;
+			(*response)["t"] = (*message)["t"];
+			(*response)["y"] = BString::create("r");
+			size += encode(response).size();
+		}
+		doNotOptimizeAway(size);
+	});
+
+	measure("KRPC codec (100k queries)", 0, [&]() {
+		char buffer[KrpcMessage::MAX_SIZE];
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < numOfMessages; ++i) {
+			auto message = decodeKrpcMessage(query);
+			KrpcMessage response;
+			response.type = KrpcMessage::Type::Response;
+			response.transactionId = message.transactionId;
+			response.addArgument("id", *message.find("id"));
+			EncodedWriter writer(buffer);
+			encodeKrpcMessage(response, writer);
+			size += writer.size();
+		}
+		doNotOptimizeAway(size);
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
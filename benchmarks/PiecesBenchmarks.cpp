@@ -0,0 +1,54 @@
+/**
+* @file      PiecesBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of piece verification.
+*/
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "Pieces.h"
+#include "Sha.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+BENCHMARK(PieceVerification) {
+	const std::size_t pieceLength = 256 * 1024;
+	const std::size_t numOfPieces = 256;
+	std::string path("bencoding-benchmark-payload");
+	std::string hashes;
+	{
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		std::string piece(pieceLength, char());
+		for (std::size_t i = 0; i < numOfPieces; ++i) {
+			piece[0] = static_cast<char>(i);
+			file << piece;
+			hashes += sha1(piece);
+		}
+	}
+	std::vector<PayloadFile> files{PayloadFile{path, pieceLength * numOfPieces}};
+
+	measure("verify (64 MB, 1 thread)", pieceLength * numOfPieces, [&]() {
+		doNotOptimizeAway(verifyPieces(files, pieceLength,
+			PieceHashes(hashes), 1).size());
+	});
+
+	std::string label("verify (64 MB, " +
+		std::to_string(std::thread::hardware_concurrency()) + " threads)");
+	measure(label, pieceLength * numOfPieces, [&]() {
+		doNotOptimizeAway(verifyPieces(files, pieceLength,
+			PieceHashes(hashes)).size());
+	});
+
+	std::remove(path.c_str());
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -0,0 +1,88 @@
+/**
+* @file      PrettyPrinterBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of pretty printing.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BList.h"
+#include "BString.h"
+#include "BenchmarkUtils.h"
+#include "PrettyPrinter.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+BENCHMARK(PrettyPrinting) {
+	// Deeply nested lists with a few items on every level.
+	std::shared_ptr<BList> nested(BList::create());
+	std::shared_ptr<BList> current(nested);
+	for (std::size_t i = 0; i < 500; ++i) {
+		auto inner = BList::create();
+		current->push_back(BInteger::create(1));
+		current->push_back(inner);
+		current->push_back(BInteger::create(2));
+		current = inner;
+	}
+
+	// A wide dictionary of small dictionaries (like files of a torrent).
+	std::shared_ptr<BDictionary> wide(BDictionary::create());
+	for (std::size_t i = 0; i < 20000; ++i) {
+		auto file = BDictionary::create();
+		(*file)["length"] = BInteger::create(static_cast<BInteger::ValueType>(i));
+		(*file)["path"] = BString::create("file" + std::to_string(i));
+		(*wide)["item" + std::to_string(i)] = file;
+	}
+
+	auto printer = PrettyPrinter::create();
+	std::string nestedRepr = printer->getPrettyRepr(nested);
+	measure("nested lists (500 levels)", nestedRepr.size(), [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(nested).size());
+	});
+
+	std::string wideRepr = printer->getPrettyRepr(wide);
+	measure("wide dictionary (20k items)", wideRepr.size(), [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(wide).size());
+	});
+
+	// Pieces of a large torrent (100k SHA-1 hashes) and a long text.
+	std::string pieces(100000 * 20, char());
+	std::uint64_t x = 88172645463325252ULL;
+	for (auto &c : pieces) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		c = static_cast<char>(x);
+	}
+	std::shared_ptr<BItem> piecesString(BString::create(pieces));
+	std::shared_ptr<BItem> textString(BString::create(
+		std::string(2000000, 'x') + '"'));
+
+	measure("text string (2 MB)", 2000000, [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(textString).size());
+	});
+
+	measure("escaped pieces (2 MB)", pieces.size(), [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(piecesString).size());
+	});
+
+	printer->setBinaryStringFormat(BinaryStringFormat::Hex);
+	measure("hex pieces (2 MB)", pieces.size(), [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(piecesString).size());
+	});
+
+	printer->setBinaryStringFormat(BinaryStringFormat::Summary);
+	measure("summarized pieces (2 MB)", pieces.size(), [&]() {
+		doNotOptimizeAway(printer->getPrettyRepr(piecesString).size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
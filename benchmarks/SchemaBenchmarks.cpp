@@ -0,0 +1,81 @@
+/**
+* @file      SchemaBenchmarks.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Benchmarks of decoding into bound structures.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BDictionary.h"
+#include "BList.h"
+#include "BenchmarkUtils.h"
+#include "Decoder.h"
+#include "Schema.h"
+
+namespace bencoding {
+namespace benchmarks {
+
+namespace {
+
+struct FileEntry {
+	std::int64_t length = 0;
+	std::vector<std::string> path;
+};
+
+BENCODING_SCHEMA(FileEntry,
+	BENCODING_FIELD(FileEntry, "length", length),
+	BENCODING_FIELD(FileEntry, "path", path)
+);
+
+struct TorrentInfo {
+	std::vector<FileEntry> files;
+	std::string name;
+	std::int64_t pieceLength = 0;
+	std::string pieces;
+};
+
+BENCODING_SCHEMA(TorrentInfo,
+	BENCODING_FIELD(TorrentInfo, "files", files),
+	BENCODING_FIELD(TorrentInfo, "name", name),
+	BENCODING_FIELD(TorrentInfo, "piece length", pieceLength),
+	BENCODING_FIELD(TorrentInfo, "pieces", pieces)
+);
+
+/**
+* @brief Returns an encoded info dictionary with @a numOfFiles files.
+*/
+std::string createEncodedInfo(std::size_t numOfFiles) {
+	TorrentInfo info;
+	for (std::size_t i = 0; i < numOfFiles; ++i) {
+		FileEntry file;
+		file.length = static_cast<std::int64_t>(i) * 1024;
+		file.path = {"directory", "file" + std::to_string(i) + ".txt"};
+		info.files.push_back(file);
+	}
+	info.name = "benchmark";
+	info.pieceLength = 16384;
+	info.pieces = std::string(20 * numOfFiles, 'x');
+	return encodeFrom(info);
+}
+
+} // anonymous namespace
+
+BENCHMARK(SchemaDecoding) {
+	std::string encodedInfo = createEncodedInfo(10000);
+
+	measure("decode into BItems (10k files)", encodedInfo.size(), [&]() {
+		auto info = decode(encodedInfo)->as<BDictionary>();
+		doNotOptimizeAway((*info)["files"]->as<BList>()->size());
+	});
+
+	measure("decode into structure (10k files)", encodedInfo.size(), [&]() {
+		doNotOptimizeAway(decodeAs<TorrentInfo>(encodedInfo).files.size());
+	});
+}
+
+} // namespace benchmarks
+} // namespace bencoding
@@ -12,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "BString.h"
 
 #include "BItem.h"
@@ -36,6 +37,22 @@ namespace bencoding {
 *  - The iterators return elements in a sorted order by the values of string
 *    keys, despite using smart pointers to index the dictionary.
 *
+* Once a dictionary has at least @c HASH_INDEX_THRESHOLD items, the first
+* lookup builds a hash index of the items, and the index is then kept up to
+* date by all the modifications. Lookups (find(), operator[], hasKey(),
+* getValue(), erase()) then take constant time on average instead of doing a
+* logarithmic number of string comparisons. The index only refers to the
+* items, so the iteration order is not affected. Since the index may be built
+* in @c const functions, a dictionary must not be accessed from multiple
+* threads without synchronization unless it is frozen.
+*
+* A dictionary can be cloned and frozen (see BItem::clone() and
+* BItem::freeze()). Freezing a dictionary freezes its keys and values as well
+* and builds the hash index in advance, so the @c const functions (find(),
+* hasKey(), getValue()) of a frozen dictionary may be called from multiple
+* threads at once. The modifiers of a frozen dictionary, including the
+* non-constant operator[], throw FrozenItemError.
+*
 * Use create() to create instances of the class.
 */
 
@@ -61,6 +78,8 @@ private:
 	using BItemMap = std::map<std::shared_ptr<BString>, std::shared_ptr<BItem>, BStringByValueComparator>;
 
 public:
+	/// Type of the item (see BItem::type()).
+	static const Type ITEM_TYPE = Type::Dictionary;
 
 	/// Key type.
 	using key_type = BItemMap::key_type;
@@ -86,47 +105,67 @@ public:
 	/// Constant iterator.
 	using const_iterator = BItemMap::const_iterator;
 
+	/// Minimal number of items for which a hash index is built.
+	static const size_type HASH_INDEX_THRESHOLD = 1024;
+
 public:
 	static std::shared_ptr<BDictionary> create();
 	static std::shared_ptr<BDictionary> create(std::initializer_list<value_type> items);
+	static std::shared_ptr<BDictionary> create(std::vector<value_type> items);
 
     // mapped_type getValue(std::string key, std::shared_ptr<BItem> value);
     // mapped_type getValue(key_type key, mapped_type value);
 
     template <typename T>
-    std::shared_ptr<T> getValue(std::string key) {
+    std::shared_ptr<T> getValue(const std::string &key) const {
+        auto i = find(key);
+        return i != end() ? itemCast<T>(i->second) : nullptr;
+    }
 
-        return getValue<T>(BString::create(key));
+    template <typename T>
+    std::shared_ptr<T> getValue(key_type key) const {
+        auto i = find(key);
+        return i != end() ? itemCast<T>(i->second) : nullptr;
     }
 
+    /// Like getValue(), but without sharing the ownership (see
+    /// BItem::asPtr()).
     template <typename T>
-    std::shared_ptr<T> getValue(key_type key) {
-        if (this->hasKey(key)) {
-            return itemMap[key]->as<T>();
-        }
+    T *getValuePtr(const std::string &key) const {
+        auto i = find(key);
+        return i != end() && i->second ? i->second->asPtr<T>() : nullptr;
+    }
 
-        return nullptr;
+    template <typename T>
+    T *getValuePtr(const key_type &key) const {
+        auto i = find(key);
+        return i != end() && i->second ? i->second->asPtr<T>() : nullptr;
     }
 
     template <typename T>
-    std::shared_ptr<T> getValue(std::string key, std::shared_ptr<T> value) {
+    std::shared_ptr<T> getValue(const std::string &key, std::shared_ptr<T> value) const {
+        auto i = find(key);
+        if (i == end()) {
+            return value;
+        }
 
-        return getValue<T>(BString::create(key), value);
+        return itemCast<T>(i->second);
     }
 
     template <typename T>
-    std::shared_ptr<T> getValue(key_type key, std::shared_ptr<T> value) {
-        if (itemMap.find(key) == itemMap.end()) {
+    std::shared_ptr<T> getValue(key_type key, std::shared_ptr<T> value) const {
+        auto i = find(key);
+        if (i == end()) {
             return value;
         }
 
-        return itemMap[key]->as<T>();
+        return itemCast<T>(i->second);
     }
 
     mapped_type setDefault(key_type key, mapped_type value);
     mapped_type setDefault(std::string key, std::shared_ptr<BItem> value);
-    bool hasKey(std::string key);
-    bool hasKey(key_type key);
+    bool hasKey(const std::string &key) const;
+    bool hasKey(const key_type &key) const;
 
     size_type erase(const key_type& __k);
     size_type erase(const std::string __k);
@@ -143,6 +182,7 @@ public:
     // }
 
     void setValue(key_type key, mapped_type value){
+        checkNotFrozen();
         (*this)[key] = value;
     }
 
@@ -160,6 +200,24 @@ public:
 	/// @{
 	mapped_type &operator[](key_type key);
     mapped_type &operator[](std::string key);
+	iterator insert(const_iterator hint, value_type item);
+	/// @}
+
+	/// @name Lookup
+	/// @{
+	iterator find(const key_type &key);
+	const_iterator find(const key_type &key) const;
+	iterator find(const std::string &key);
+	const_iterator find(const std::string &key) const;
+	bool isHashIndexed() const;
+	/// @}
+
+	/// @name Structural Sharing
+	/// @{
+	std::shared_ptr<BDictionary> clone() const;
+	virtual void freeze() override;
+	mapped_type unfrozenValue(const key_type &key);
+	mapped_type unfrozenValue(const std::string &key);
 	/// @}
 
 	/// @name Iterators
@@ -181,9 +239,33 @@ private:
 	BDictionary();
 	explicit BDictionary(std::initializer_list<value_type> items);
 
+	virtual std::shared_ptr<BItem> cloneItem() const override;
+	iterator toIterator(const_iterator i);
+
+	/// @name Hash Index
+	/// @{
+	const_iterator findInHashIndex(const std::string &key) const;
+	void buildHashIndex() const;
+	void addToHashIndex(const_iterator item) const;
+	void removeFromHashIndex(const_iterator item) const;
+	/// @}
+
 private:
+	/// Slot of the hash index.
+	struct HashIndexSlot {
+		/// Hash of the key of @c item.
+		std::size_t hash;
+
+		/// Indexed item (@c end() for empty slots).
+		const_iterator item;
+	};
+
 	/// Underlying list of items.
 	BItemMap itemMap;
+
+	/// Open-addressing hash table (with linear probing) of the items, whose
+	/// size is a power of two. Empty when the dictionary is not indexed.
+	mutable std::vector<HashIndexSlot> hashIndex;
 };
 
 using BDictionaryPtr = std::shared_ptr<BDictionary>;
@@ -22,6 +22,9 @@ namespace bencoding {
 */
 class BInteger: public BItem {
 public:
+	/// Type of the item (see BItem::type()).
+	static const Type ITEM_TYPE = Type::Integer;
+
 	/// Type of the underlying integral value.
 	using ValueType = int64_t;
 
@@ -31,6 +34,8 @@ public:
 	ValueType value() const;
 	void setValue(ValueType value);
 
+	std::shared_ptr<BInteger> clone() const;
+
 	/// @name BItemVisitor Support
 	/// @{
 	virtual void accept(BItemVisitor *visitor) override;
@@ -39,6 +44,8 @@ public:
 private:
 	explicit BInteger(ValueType value);
 
+	virtual std::shared_ptr<BItem> cloneItem() const override;
+
 private:
 	ValueType _value;
 };
@@ -9,19 +9,61 @@
 #define BENCODING_BITEM_H
 
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace bencoding {
 
 class BItemVisitor;
 
+/**
+* @brief Exception thrown when a frozen item is about to be modified.
+*/
+class FrozenItemError: public std::logic_error {
+public:
+	explicit FrozenItemError(const std::string &what);
+};
+
 /**
 * @brief Base class for all items (integers, strings, etc.).
 */
 class BItem: public std::enable_shared_from_this<BItem> {
+public:
+	/// Type of an item.
+	enum class Type {
+		Integer,
+		String,
+		List,
+		Dictionary
+	};
 
 public:
 	virtual ~BItem() = 0;
 
+	/// @name Type
+	/// @{
+
+	Type type() const;
+
+	/**
+	* @brief Returns @c true if the item is of type @c T, @c false otherwise.
+	*
+	* @tparam T Subclass of BItem.
+	*
+	* The check compares the type of the item (see type()), so it is cheaper
+	* than @c dynamic_cast.
+	*/
+	template <typename T>
+	bool is() const {
+		static_assert(std::is_base_of<BItem, T>::value,
+			"T has to be a subclass of BItem");
+
+		return itemType == T::ITEM_TYPE;
+	}
+
+	/// @}
+
 	/// @name BItemVisitor Support
 	/// @{
 
@@ -39,30 +81,127 @@ public:
 
 	/// @}
 
+	/// @name Structural Sharing
+	/// @{
+
+	std::shared_ptr<BItem> clone() const;
+	virtual void freeze();
+	bool isFrozen() const;
+
+	/// @}
+
+	/// @name Casting
+	/// @{
+
 	/**
 	* @brief Casts the item to the given subclass of BItem.
 	*
 	* @tparam T Subclass of BItem.
+	*
+	* @return The item as @c T, or a null pointer when it is not of type @c T.
+	*
+	* The returned pointer shares the ownership of the item, which costs
+	* atomic updates of its reference count. When the item is kept alive
+	* anyway, use asPtr() instead.
 	*/
 	template <typename T>
 	std::shared_ptr<T> as() {
 		static_assert(std::is_base_of<BItem, T>::value,
 			"T has to be a subclass of BItem");
 
-		return std::dynamic_pointer_cast<T>(shared_from_this());
+		// Do not touch the reference count when the cast fails.
+		if (!is<T>()) {
+			return std::shared_ptr<T>();
+		}
+		return std::shared_ptr<T>(shared_from_this(), static_cast<T *>(this));
+	}
+
+	/**
+	* @brief Casts the item to the given subclass of BItem without sharing
+	*        its ownership.
+	*
+	* @tparam T Subclass of BItem.
+	*
+	* @return The item as @c T, or a null pointer when it is not of type @c T.
+	*
+	* In contrast to as(), the reference count of the item is not updated, so
+	* this is the cheaper choice when the item is owned by something that
+	* outlives the use of the pointer (e.g. by a tree that is being
+	* traversed). The pointer must not be stored past the lifetime of the
+	* item.
+	*/
+	template <typename T>
+	T *asPtr() {
+		static_assert(std::is_base_of<BItem, T>::value,
+			"T has to be a subclass of BItem");
+
+		return is<T>() ? static_cast<T *>(this) : nullptr;
+	}
+
+	/// @copydoc asPtr()
+	template <typename T>
+	const T *asPtr() const {
+		static_assert(std::is_base_of<BItem, T>::value,
+			"T has to be a subclass of BItem");
+
+		return is<T>() ? static_cast<const T *>(this) : nullptr;
 	}
 
+	/// @}
+
 protected:
-	BItem();
+	explicit BItem(Type type);
+
+	/**
+	* @brief Returns a copy of the item sharing its contents.
+	*
+	* See clone() for more details.
+	*/
+	virtual std::shared_ptr<BItem> cloneItem() const = 0;
+
+	void markAsFrozen();
+	void checkNotFrozen() const;
 
 private:
 	// Disable copy construction and assignment for this class and subclasses.
 	BItem(const BItem &) = delete;
 	BItem &operator=(const BItem &) = delete;
+
+private:
+	/// Type of the item.
+	const Type itemType;
+
+	/// Has the item been frozen?
+	bool frozen = false;
 };
 
+/// Every item is a BItem.
+template <>
+inline bool BItem::is<BItem>() const {
+	return true;
+}
+
 using BItemPtr = std::shared_ptr<BItem>;
 
+/**
+* @brief Casts the given @a item to the given subclass of BItem.
+*
+* @tparam T Subclass of BItem.
+*
+* @return The item as @c T, or a null pointer when it is not of type @c T or
+*         when @a item is a null pointer.
+*
+* The same as <tt>item->as<T>()</tt>, but cheaper because the ownership is
+* shared with @a item instead of being obtained by @c shared_from_this().
+*/
+template <typename T>
+std::shared_ptr<T> itemCast(const std::shared_ptr<BItem> &item) {
+	if (!item || !item->is<T>()) {
+		return std::shared_ptr<T>();
+	}
+	return std::static_pointer_cast<T>(item);
+}
+
 } // namespace bencoding
 
 #endif
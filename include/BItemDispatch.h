@@ -0,0 +1,81 @@
+/**
+* @file      BItemDispatch.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Dispatching over the types of items.
+*/
+
+#ifndef BENCODING_BITEMDISPATCH_H
+#define BENCODING_BITEMDISPATCH_H
+
+#include <utility>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BItem.h"
+#include "BList.h"
+#include "BString.h"
+
+namespace bencoding {
+
+/**
+* @brief Calls @a f with @a item cast to its actual type.
+*
+* @a f has to be callable with <tt>BInteger &</tt>, <tt>BString &</tt>,
+* <tt>BList &</tt>, and <tt>BDictionary &</tt> (e.g. an object with
+* overloaded call operators), and all the calls have to return the same type,
+* which is then returned.
+*
+* It is an alternative to BItemVisitor: the subclass is selected by a
+* @c switch over BItem::type() instead of by two virtual calls, @a f can be
+* inlined, and it can return a value instead of storing it in a member.
+*
+* Example:
+* @code
+* struct Counter {
+*     std::size_t operator()(BInteger &) { return 1; }
+*     std::size_t operator()(BString &) { return 1; }
+*     std::size_t operator()(BList &bList) { return bList.size(); }
+*     std::size_t operator()(BDictionary &bDictionary) { return bDictionary.size(); }
+* };
+* std::size_t count = dispatch(*item, Counter());
+* @endcode
+*/
+template <typename Function>
+auto dispatch(BItem &item, Function &&f) ->
+		decltype(f(std::declval<BInteger &>())) {
+	switch (item.type()) {
+		case BItem::Type::Integer:
+			return f(static_cast<BInteger &>(item));
+		case BItem::Type::String:
+			return f(static_cast<BString &>(item));
+		case BItem::Type::List:
+			return f(static_cast<BList &>(item));
+		default:
+			return f(static_cast<BDictionary &>(item));
+	}
+}
+
+/**
+* @brief Calls @a f with @a item cast to its actual (constant) type.
+*
+* See the non-constant overload for more details.
+*/
+template <typename Function>
+auto dispatch(const BItem &item, Function &&f) ->
+		decltype(f(std::declval<const BInteger &>())) {
+	switch (item.type()) {
+		case BItem::Type::Integer:
+			return f(static_cast<const BInteger &>(item));
+		case BItem::Type::String:
+			return f(static_cast<const BString &>(item));
+		case BItem::Type::List:
+			return f(static_cast<const BList &>(item));
+		default:
+			return f(static_cast<const BDictionary &>(item));
+	}
+}
+
+} // namespace bencoding
+
+#endif
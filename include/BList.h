@@ -8,20 +8,46 @@
 #ifndef BENCODING_BLIST_H
 #define BENCODING_BLIST_H
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "BInteger.h"
 #include "BItem.h"
 
 namespace bencoding {
 
+class BListSlice;
+
 /**
 * @brief Representation of a list.
 *
 * The interface models the interface of @c std::list.
 *
+* Lists of only integers or only strings can be stored in a packed form (see
+* Storage), where just the values are stored next to each other instead of
+* pointers to separate items. This is transparent: the first use of a
+* non-constant function that gives access to the items as BItems (iterators,
+* element access, modifiers) converts the list into the Storage::Items form,
+* as does unpack(). The @c const functions never convert the list, so they
+* may be called from multiple threads at once and they keep the references
+* returned by stringAt() valid. Instead, they return the items by value (see
+* const_iterator) and create a new item on every access to a packed value.
+* The packed values can be accessed without creating items by integerAt(),
+* stringAt(), packedIntegers(), and packedStrings().
+*
+* A frozen list (see BItem::freeze()) is never packed. Its modifiers and its
+* non-constant functions that give mutable access to the items (value(),
+* operator[], front(), back(), begin(), end()) throw FrozenItemError; use the
+* @c const functions or getItem() to read it.
+*
 * Use create() to create instances of the class.
 */
 class BList: public BItem {
@@ -30,6 +56,8 @@ private:
 	using BItemList = std::vector<std::shared_ptr<BItem>>;
 
 public:
+	/// Type of the item (see BItem::type()).
+	static const Type ITEM_TYPE = Type::List;
 
 	/// Value type.
 	using value_type = BItemList::value_type;
@@ -41,20 +69,92 @@ public:
 	using reference = BItemList::reference;
 
 	/// Constant reference.
-	using const_reference = BItemList::const_reference;
+	///
+	/// The items are returned by value from @c const functions, so that they
+	/// can be created from packed values without converting the list.
+	using const_reference = value_type;
 
-	/// Iterator (@c BidirectionalIterator).
+	/// Iterator (@c RandomAccessIterator).
 	using iterator = BItemList::iterator;
 
-	/// Constant iterator (constant @c BidirectionalIterator).
-	using const_iterator = BItemList::const_iterator;
+	/**
+	* @brief Constant iterator (constant @c RandomAccessIterator).
+	*
+	* It refers to a list and an index, so it reads packed values without
+	* converting the list. Dereferencing it returns the item by value; for a
+	* packed list, a new item is created on every dereference.
+	*/
+	class const_iterator {
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = BList::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = BList::const_reference;
+
+		/// Pointer-like access to a dereferenced item.
+		class pointer {
+		public:
+			explicit pointer(value_type item): item(std::move(item)) {}
+			const value_type *operator->() const { return &item; }
+
+		private:
+			value_type item;
+		};
+
+	public:
+		const_iterator(): list(nullptr), idx(0) {}
+		const_iterator(const BList *list, size_type idx): list(list), idx(idx) {}
+
+		reference operator*() const { return (*list)[idx]; }
+		pointer operator->() const { return pointer(**this); }
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		const_iterator &operator++() { ++idx; return *this; }
+		const_iterator operator++(int) { auto old = *this; ++idx; return old; }
+		const_iterator &operator--() { --idx; return *this; }
+		const_iterator operator--(int) { auto old = *this; --idx; return old; }
+		const_iterator &operator+=(difference_type n) { idx += n; return *this; }
+		const_iterator &operator-=(difference_type n) { idx -= n; return *this; }
+		const_iterator operator+(difference_type n) const { return const_iterator(list, idx + n); }
+		const_iterator operator-(difference_type n) const { return const_iterator(list, idx - n); }
+		difference_type operator-(const const_iterator &other) const {
+			return static_cast<difference_type>(idx) -
+				static_cast<difference_type>(other.idx);
+		}
+
+		bool operator==(const const_iterator &other) const { return idx == other.idx && list == other.list; }
+		bool operator!=(const const_iterator &other) const { return !(*this == other); }
+		bool operator<(const const_iterator &other) const { return idx < other.idx; }
+		bool operator>(const const_iterator &other) const { return idx > other.idx; }
+		bool operator<=(const const_iterator &other) const { return idx <= other.idx; }
+		bool operator>=(const const_iterator &other) const { return idx >= other.idx; }
+
+	private:
+		/// Iterated list.
+		const BList *list;
+
+		/// Index of the current item.
+		size_type idx;
+	};
+
+	/// Representation of the items in memory.
+	enum class Storage {
+		Items,          ///< Pointers to items of arbitrary types.
+		PackedIntegers, ///< Values of integers stored next to each other.
+		PackedStrings   ///< Contents of strings stored next to each other.
+	};
 
 public:
 	static std::shared_ptr<BList> create();
 	static std::shared_ptr<BList> create(std::vector<value_type> items);
+	static std::shared_ptr<BList> createPackedIntegers(
+		std::vector<BInteger::ValueType> integers);
+	static std::shared_ptr<BList> createPackedStrings(
+		std::vector<std::string> strings);
     BItemList &value();
 
     BList::reference &operator[](size_t idx);
+    const_reference operator[](size_t idx) const;
 
 	/// @name Capacity
 	/// @{
@@ -73,19 +173,59 @@ public:
 
 	template <typename T >
     std::shared_ptr<T> getItem(size_t idx) {
-        return (*this)[idx]->as<T>();
+        return itemCast<T>(unpackedItem(idx));
+    }
+
+	template <typename T >
+    std::shared_ptr<T> getItem(size_t idx) const {
+        return itemCast<T>((*this)[idx]);
+    }
+
+	/// Like getItem(), but without sharing the ownership (see BItem::asPtr()).
+	/// A packed list is converted, so that the item outlives the call.
+	template <typename T >
+    T *getItemPtr(size_t idx) {
+        return unpackedItem(idx)->asPtr<T>();
     }
 
     void setItem(size_t idx, BItemPtr item) {
         assert(idx <= this->size());
+        checkNotFrozen();
         (*this)[idx] = item;
     }
 
     std::shared_ptr<BList> range(int s_idx);
     std::shared_ptr<BList> range(int s_idx, int e_idx);
+    BListSlice slice(int s_idx) const;
+    BListSlice slice(int s_idx, int e_idx) const;
     void range_erase(int s_idx);
     void range_erase(int s_idx, int e_idx);
 
+	iterator insert(iterator pos, const value_type &bItem);
+	template <typename InputIterator>
+	iterator insert(iterator pos, InputIterator first, InputIterator last);
+	iterator erase(iterator pos);
+	iterator erase(iterator first, iterator last);
+	template <typename UnaryPredicate>
+	size_type remove_if(UnaryPredicate pred);
+
+	/// @}
+
+	/// @name Structural Sharing
+	/// @{
+	std::shared_ptr<BList> clone() const;
+	virtual void freeze() override;
+	value_type unfrozenItem(size_type idx);
+	/// @}
+
+	/// @name Packed Storage
+	/// @{
+	Storage storage() const;
+	const std::vector<BInteger::ValueType> &packedIntegers() const;
+	const std::vector<std::string> &packedStrings() const;
+	BInteger::ValueType integerAt(size_type idx) const;
+	const std::string &stringAt(size_type idx) const;
+	void unpack();
 	/// @}
 
 	/// @name Element Access
@@ -115,11 +255,70 @@ private:
 	BList();
 	explicit BList(std::vector<value_type> items);
 
+	virtual std::shared_ptr<BItem> cloneItem() const override;
+	void normalizeRange(int &s_idx, int &e_idx) const;
+	const value_type &unpackedItem(size_type idx);
+
 private:
-	/// Underlying list of items.
+	/// Current representation of the items.
+	Storage itemStorage = Storage::Items;
+
+	/// Underlying list of items (Storage::Items).
 	BItemList itemList;
+
+	/// Values of the integers (Storage::PackedIntegers).
+	std::vector<BInteger::ValueType> integers;
+
+	/// Contents of the strings (Storage::PackedStrings).
+	std::vector<std::string> strings;
 };
 
+/**
+* @brief Inserts copies of the items from [@a first, @a last) before @a pos.
+*
+* The items are moved by a single pass, so the insertion takes linear time in
+* the size of the list and the number of inserted items.
+*
+* @return Iterator to the first inserted item, or @a pos if the range is
+*         empty.
+*
+* @preconditions
+*  - all the inserted items are non-null
+*/
+template <typename InputIterator>
+BList::iterator BList::insert(iterator pos, InputIterator first,
+		InputIterator last) {
+	checkNotFrozen();
+
+	// No unpack() here: @a pos can only be obtained from an unpacked list.
+	size_type oldSize = itemList.size();
+	auto inserted = itemList.insert(pos, first, last);
+	auto insertedEnd = inserted + (itemList.size() - oldSize);
+	assert(std::find(inserted, insertedEnd, nullptr) == insertedEnd &&
+		"cannot add a null item to the list");
+	static_cast<void>(insertedEnd);
+	return inserted;
+}
+
+/**
+* @brief Removes all the items for which @a pred returns @c true.
+*
+* The remaining items keep their order. Every item is moved at most once, so
+* the removal takes linear time in the size of the list.
+*
+* @return Number of removed items.
+*/
+template <typename UnaryPredicate>
+BList::size_type BList::remove_if(UnaryPredicate pred) {
+	checkNotFrozen();
+
+	unpack();
+	auto newEnd = std::remove_if(itemList.begin(), itemList.end(), pred);
+	size_type numOfRemovedItems = itemList.end() - newEnd;
+	itemList.erase(newEnd, itemList.end());
+	return numOfRemovedItems;
+}
+
 using BListPtr = std::shared_ptr<BList>;
 
 } // namespace bencoding
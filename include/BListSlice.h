@@ -0,0 +1,78 @@
+/**
+* @file      BListSlice.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Non-owning view of a contiguous range of items in a list.
+*/
+
+#ifndef BENCODING_BLISTSLICE_H
+#define BENCODING_BLISTSLICE_H
+
+#include <memory>
+
+#include "BList.h"
+
+namespace bencoding {
+
+/**
+* @brief Non-owning view of a contiguous range of items in a list.
+*
+* In contrast to BList::range(), creating a slice copies neither the items nor
+* the pointers to them, so it takes constant time. The viewed list has to
+* outlive the slice and must not be modified while the slice is in use (the
+* slice stores iterators into the list). A packed list is not converted by
+* slicing; the items of the slice are created from the packed values when they
+* are accessed (see BList::const_iterator).
+*
+* Use BList::slice() to create slices of lists.
+*/
+class BListSlice {
+public:
+	/// Value type.
+	using value_type = BList::value_type;
+
+	/// Size type.
+	using size_type = BList::size_type;
+
+	/// Constant reference.
+	using const_reference = BList::const_reference;
+
+	/// Constant iterator (constant @c RandomAccessIterator).
+	using const_iterator = BList::const_iterator;
+
+public:
+	BListSlice();
+	BListSlice(const_iterator first, const_iterator last);
+
+	/// @name Capacity
+	/// @{
+	size_type size() const;
+	bool empty() const;
+	/// @}
+
+	/// @name Element Access
+	/// @{
+	const_reference operator[](size_type idx) const;
+	const_reference front() const;
+	const_reference back() const;
+	/// @}
+
+	/// @name Iterators
+	/// @{
+	const_iterator begin() const;
+	const_iterator end() const;
+	/// @}
+
+	std::shared_ptr<BList> toList() const;
+
+private:
+	/// First item of the slice.
+	const_iterator first;
+
+	/// Item following the last item of the slice.
+	const_iterator last;
+};
+
+} // namespace bencoding
+
+#endif
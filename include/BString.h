@@ -22,6 +22,9 @@ namespace bencoding {
 */
 class BString: public BItem {
 public:
+	/// Type of the item (see BItem::type()).
+	static const Type ITEM_TYPE = Type::String;
+
 	/// Type of the underlying string value.
 //	using ValueType = std::string;
     using ValueType = std::shared_ptr<std::string>;
@@ -34,6 +37,8 @@ public:
     void setValue(std::string value);
     int64_t length() const;
 
+	std::shared_ptr<BString> clone() const;
+
 	/// @name BItemVisitor Support
 	/// @{
 	virtual void accept(BItemVisitor *visitor) override;
@@ -43,8 +48,13 @@ private:
 	explicit BString(ValueType value);
     explicit BString(std::string value);
 
+	virtual std::shared_ptr<BItem> cloneItem() const override;
+
 private:
 	ValueType _value;
+
+	// Allowed to create temporary keys on the stack for lookups.
+	friend class BDictionary;
 };
 
 using BStringPtr = std::shared_ptr<BString>;
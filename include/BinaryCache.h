@@ -0,0 +1,170 @@
+/**
+* @file      BinaryCache.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Binary cache of decoded data that can be queried without
+*            parsing.
+*/
+
+#ifndef BENCODING_BINARY_CACHE_H
+#define BENCODING_BINARY_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Scanner.h"
+
+namespace bencoding {
+
+/**
+* @brief Item stored in a binary cache.
+*
+* It is a view of a part of the cache, so it is cheap to copy and the cache
+* has to outlive it. Accessing the item reads the cache in place; nothing is
+* parsed or allocated.
+*
+* An item may also be null, which is returned when a key is not found.
+*
+* When the cache is corrupted, the accessors throw DecodingError rather than
+* reading outside of the cache.
+*/
+class CachedItem {
+public:
+	/// Type of an item.
+	enum class Type {
+		Integer,
+		String,
+		List,
+		Dictionary
+	};
+
+public:
+	CachedItem();
+
+	explicit operator bool() const;
+
+	/// @name Type
+	/// @{
+	Type type() const;
+	bool isInteger() const;
+	bool isString() const;
+	bool isList() const;
+	bool isDictionary() const;
+	/// @}
+
+	/// @name Values
+	/// @{
+	std::int64_t integerValue() const;
+	StringRef stringValue() const;
+	/// @}
+
+	/// @name Containers
+	/// @{
+	std::size_t size() const;
+	bool empty() const;
+	CachedItem operator[](std::size_t index) const;
+	StringRef keyAt(std::size_t index) const;
+	CachedItem valueAt(std::size_t index) const;
+	CachedItem find(const StringRef &key) const;
+	/// @}
+
+private:
+	friend class BinaryCache;
+	friend std::string binaryCacheToBencode(const CachedItem &item);
+
+	CachedItem(const char *image, std::size_t imageSize, std::size_t offset);
+
+	void checkIndex(std::size_t index) const;
+	CachedItem uncheckedItem(std::size_t index) const;
+	StringRef uncheckedKey(std::size_t index) const;
+	CachedItem uncheckedValue(std::size_t index) const;
+	CachedItem itemAt(std::size_t tableOffset) const;
+	std::uint32_t readUint32(std::size_t offset) const;
+	void checkAvailable(std::size_t offset, std::size_t size) const;
+
+private:
+	/// The whole cache.
+	const char *image;
+
+	/// Size of the cache.
+	std::size_t imageSize;
+
+	/// Offset of the item in the cache.
+	std::size_t offset;
+};
+
+/**
+* @brief View of a binary cache of decoded data.
+*
+* The cache is a position-independent image of a decoded item. Containers
+* have tables of offsets of their items and dictionaries have a directory of
+* their keys sorted in the same way as in bencoded data, so items are
+* accessed in constant time and keys are found by a binary search. All
+* numbers are stored in little endian, so the cache can be stored into a
+* file, mapped into memory (see MappedBinaryCache), and queried directly.
+*
+* Use bencodeToBinaryCache() to create a cache and binaryCacheToBencode() to
+* get the bencoded data back.
+*/
+class BinaryCache {
+public:
+	BinaryCache(const char *data, std::size_t size);
+	explicit BinaryCache(const std::string &data);
+	// Temporary strings would be destroyed while they are being viewed.
+	BinaryCache(std::string &&data) = delete;
+
+	CachedItem root() const;
+
+private:
+	/// The viewed cache.
+	const char *data;
+
+	/// Size of the cache.
+	std::size_t size;
+
+	/// Offset of the root item.
+	std::size_t rootOffset;
+};
+
+/**
+* @brief Binary cache stored in a file that is mapped into memory.
+*
+* On systems without @c mmap(), the file is read into memory instead.
+*/
+class MappedBinaryCache {
+public:
+	explicit MappedBinaryCache(const std::string &path);
+	~MappedBinaryCache();
+
+	MappedBinaryCache(const MappedBinaryCache &) = delete;
+	MappedBinaryCache &operator=(const MappedBinaryCache &) = delete;
+
+	CachedItem root() const;
+
+private:
+	/// Contents of the file.
+	const char *data;
+
+	/// Size of the file.
+	std::size_t size;
+
+	/// Has the file been mapped into memory?
+	bool mapped;
+
+	/// Contents of the file when it has not been mapped.
+	std::string readData;
+};
+
+/// @name Conversions
+/// @{
+
+std::string bencodeToBinaryCache(const char *data, std::size_t size);
+std::string bencodeToBinaryCache(const std::string &data);
+std::string binaryCacheToBencode(const CachedItem &item);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
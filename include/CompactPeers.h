@@ -0,0 +1,62 @@
+/**
+* @file      CompactPeers.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Decoding and encoding of peers in the compact form.
+*/
+
+#ifndef BENCODING_COMPACT_PEERS_H
+#define BENCODING_COMPACT_PEERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EncodedWriter.h"
+#include "Scanner.h"
+
+namespace bencoding {
+
+/**
+* @brief IPv4 address and port of a peer (in the host byte order).
+*/
+struct IPv4Peer {
+	/// Address (e.g. @c 0x7f000001 for 127.0.0.1).
+	std::uint32_t address;
+
+	/// Port.
+	std::uint16_t port;
+};
+
+/**
+* @brief IPv6 address and port of a peer.
+*/
+struct IPv6Peer {
+	/// Bytes of the address in the network byte order (as in @c in6_addr).
+	std::uint8_t address[16];
+
+	/// Port (in the host byte order).
+	std::uint16_t port;
+};
+
+/// Size of an IPv4 peer in the compact form (the @c peers key).
+const std::size_t COMPACT_IPV4_PEER_SIZE = 6;
+
+/// Size of an IPv6 peer in the compact form (the @c peers6 key).
+const std::size_t COMPACT_IPV6_PEER_SIZE = 18;
+
+/// @name Compact Peers
+/// @{
+
+void decodeCompactPeers(const StringRef &peers, std::vector<IPv4Peer> &result);
+void decodeCompactPeers(const StringRef &peers, std::vector<IPv6Peer> &result);
+void writeCompactPeers(EncodedWriter &writer, const IPv4Peer *peers,
+	std::size_t count);
+void writeCompactPeers(EncodedWriter &writer, const IPv6Peer *peers,
+	std::size_t count);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
@@ -8,16 +8,19 @@
 #ifndef BENCODING_DECODER_H
 #define BENCODING_DECODER_H
 
+#include <cstddef>
 #include <exception>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
+#include "BInteger.h"
 #include "BItem.h"
 
 namespace bencoding {
 
 class BDictionary;
-class BInteger;
 class BList;
 class BString;
 
@@ -39,49 +42,97 @@ public:
 * Use create() to create instances.
 */
 class Decoder {
+public:
+	/// Value of the memory limit meaning that there is no limit.
+	static const std::size_t NO_MEMORY_LIMIT =
+		std::numeric_limits<std::size_t>::max();
+
+	/// Maximal number of characters read from a stream at once.
+	static const std::size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
 public:
 	static std::shared_ptr<Decoder> create();
 
 	std::shared_ptr<BItem> decode(const std::string &data);
 	std::shared_ptr<BItem> decode(std::istream &input);
 
+	/// @name Strict Mode
+	/// @{
+	void setStrictMode(bool strict);
+	bool isInStrictMode() const;
+	/// @}
+
+	/// @name Memory Limit
+	/// @{
+	void setMemoryLimit(std::size_t limit);
+	std::size_t getMemoryLimit() const;
+	/// @}
+
+	/// @name List Packing
+	/// @{
+	void setListPacking(bool enabled);
+	bool isListPackingEnabled() const;
+	/// @}
+
 private:
 	Decoder();
 
+	std::shared_ptr<BItem> decodeItem(std::istream &input);
+	void startDecoding(bool fromBuffer);
+	void chargeMemory(std::size_t size);
 	void readExpectedChar(std::istream &input, char expected_char) const;
 
-	/// @name Integer Decoding
+	/// @name Dictionary Decoding
 	/// @{
 	std::shared_ptr<BDictionary> decodeDictionary(std::istream &input);
 	std::shared_ptr<BDictionary> decodeDictionaryItemsIntoDictionary(
 		std::istream &input);
 	std::shared_ptr<BString> decodeDictionaryKey(std::istream &input);
+	void validateKeyOrder(const std::shared_ptr<BString> &previousKey,
+		const std::shared_ptr<BString> &key) const;
 	std::shared_ptr<BItem> decodeDictionaryValue(std::istream &input);
 	/// @}
 
 	/// @name Integer Decoding
 	/// @{
-	std::shared_ptr<BInteger> decodeInteger(std::istream &input) const;
-	std::string readEncodedInteger(std::istream &input) const;
-	std::shared_ptr<BInteger> decodeEncodedInteger(
-		const std::string &encodedInteger) const;
+	std::shared_ptr<BInteger> decodeInteger(std::istream &input);
+	BInteger::ValueType readInteger(std::istream &input) const;
+	std::size_t readDigits(std::istream &input, char *digits) const;
 	/// @}
 
 	/// @name List Decoding
 	/// @{
 	std::shared_ptr<BList> decodeList(std::istream &input);
 	std::shared_ptr<BList> decodeListItemsIntoList(std::istream &input);
+	std::shared_ptr<BList> decodePackedListItems(std::istream &input);
 	/// @}
 
 	/// @name String Decoding
 	/// @{
-	std::shared_ptr<BString> decodeString(std::istream &input) const;
+	std::shared_ptr<BString> decodeString(std::istream &input);
+	std::string readString(std::istream &input);
 	std::string::size_type readStringLength(std::istream &input) const;
 	std::string readStringOfGivenLength(std::istream &input,
-		std::string::size_type length) const;
+		std::string::size_type length);
 	/// @}
 
 	void validateInputDoesNotContainUndecodedCharacters(std::istream &input);
+
+private:
+	/// Reject data that are not canonically encoded?
+	bool strictMode = false;
+
+	/// Is the current input a buffer whose contents are all available?
+	bool decodingFromBuffer = false;
+
+	/// Maximal number of bytes the decoded data may occupy.
+	std::size_t memoryLimit = NO_MEMORY_LIMIT;
+
+	/// Number of bytes occupied by the data decoded so far.
+	std::size_t memoryUsage = 0;
+
+	/// Store homogeneous lists in the packed form?
+	bool listPacking = true;
 };
 
 /// @name Decoding Without Explicit Decoder Creation
@@ -0,0 +1,71 @@
+/**
+* @file      EncodedListView.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     View of the items of a bencoded list stored in a buffer.
+*/
+
+#ifndef BENCODING_ENCODEDLISTVIEW_H
+#define BENCODING_ENCODEDLISTVIEW_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Scanner.h"
+
+namespace bencoding {
+
+/**
+* @brief View of the items of a bencoded list stored in a buffer.
+*
+* The list is scanned once when the view is created and the encoded form of
+* every item is remembered as a StringRef. No item is decoded, so the view
+* allows paging through large encoded lists without building a BList. Items
+* can be decoded individually by decode() when they are needed, and a range
+* of items can be re-encoded as a list by copying the underlying bytes.
+*
+* The buffer has to outlive the view and all the references it has returned.
+*/
+class EncodedListView {
+public:
+	/// Constant iterator over the encoded items.
+	using const_iterator = std::vector<StringRef>::const_iterator;
+
+public:
+	EncodedListView(const char *data, std::size_t size);
+	explicit EncodedListView(const std::string &data);
+	// Temporary strings would be destroyed while they are being viewed.
+	EncodedListView(std::string &&data) = delete;
+
+	/// @name Capacity
+	/// @{
+	std::size_t size() const;
+	bool empty() const;
+	/// @}
+
+	/// @name Element Access
+	/// @{
+	StringRef operator[](std::size_t idx) const;
+	/// @}
+
+	/// @name Iterators
+	/// @{
+	const_iterator begin() const;
+	const_iterator end() const;
+	/// @}
+
+	/// @name Slices
+	/// @{
+	StringRef encodedItems(std::size_t first, std::size_t last) const;
+	std::string encodeSlice(std::size_t first, std::size_t last) const;
+	/// @}
+
+private:
+	/// Encoded forms of the items.
+	std::vector<StringRef> items;
+};
+
+} // namespace bencoding
+
+#endif
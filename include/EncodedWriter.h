@@ -0,0 +1,101 @@
+/**
+* @file      EncodedWriter.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Writer of bencoded data into a fixed buffer.
+*/
+
+#ifndef BENCODING_ENCODED_WRITER_H
+#define BENCODING_ENCODED_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FixedString.h"
+#include "Scanner.h"
+
+namespace bencoding {
+
+/**
+* @brief Writer of bencoded data into a fixed buffer provided by the caller.
+*
+* It is meant for hot paths emitting messages with a fixed structure. The
+* fixed parts are prepared at compile time as FixedString and the variable
+* parts are filled in at runtime, so no BItem is created and nothing is
+* allocated:
+* @code
+* constexpr auto prefix = fixedString("d") + encodedString("interval") +
+*     encodedInteger<1800>() + encodedString("peers");
+*
+* char buffer[512];
+* EncodedWriter writer(buffer);
+* writer.write(prefix).writeString(peers).write(fixedString("e"));
+* if (!writer.overflowed()) {
+*     send(writer.written());
+* }
+* @endcode
+*
+* When the buffer is full, the writer stops writing and overflowed() returns
+* @c true. It is not an error to continue writing, so the check can be done
+* once at the end.
+*
+* The writer only concatenates the written pieces, so it is up to the caller
+* to produce valid bencoded data (e.g. to write dictionary keys in the sorted
+* order).
+*/
+class EncodedWriter {
+public:
+	EncodedWriter(char *buffer, std::size_t capacity);
+
+	/**
+	* @brief Constructs a writer into the given @a buffer.
+	*/
+	template <std::size_t N>
+	explicit EncodedWriter(char (&buffer)[N]): EncodedWriter(buffer, N) {}
+
+	/// @name Writing
+	/// @{
+	/**
+	* @brief Writes the given bytes prepared at compile time.
+	*/
+	template <std::size_t Size>
+	EncodedWriter &write(const FixedString<Size> &bytes) {
+		return writeBytes(bytes.data(), Size);
+	}
+
+	EncodedWriter &writeBytes(const char *data, std::size_t size);
+	EncodedWriter &writeInteger(std::int64_t value);
+	EncodedWriter &writeString(const char *data, std::size_t size);
+	EncodedWriter &writeString(const StringRef &str);
+	char *writeStringHeader(std::size_t size);
+	/// @}
+
+	/// @name Status
+	/// @{
+	std::size_t size() const;
+	std::size_t capacity() const;
+	bool overflowed() const;
+	StringRef written() const;
+	void clear();
+	/// @}
+
+private:
+	char *reserve(std::size_t size);
+
+private:
+	/// Beginning of the buffer.
+	char *first;
+
+	/// Position of the next written byte.
+	char *current;
+
+	/// End of the buffer.
+	char *last;
+
+	/// Has some piece not fit into the buffer?
+	bool hasOverflowed;
+};
+
+} // namespace bencoding
+
+#endif
@@ -11,11 +11,13 @@
 #include <memory>
 #include <string>
 
+#include "BInteger.h"
 #include "BItemVisitor.h"
 
 namespace bencoding {
 
 class BItem;
+class BListSlice;
 
 /**
 * @brief Data encoder.
@@ -31,10 +33,14 @@ public:
 	static std::shared_ptr<Encoder> create();
 
 	std::string encode(std::shared_ptr<BItem> data);
+	std::string encode(const BListSlice &slice);
 
 private:
 	Encoder();
 
+	void encodeInteger(BInteger::ValueType value);
+	void encodeString(const std::string &value);
+
 	/// @name BItemVisitor Interface
 	/// @{
 	virtual void visit(BDictionary *bDictionary) override;
@@ -51,6 +57,7 @@ private:
 /// @name Encoding Without Explicit Encoder Creation
 /// @{
 std::string encode(std::shared_ptr<BItem> data);
+std::string encode(const BListSlice &slice);
 /// @}
 
 } // namespace bencoding
@@ -0,0 +1,227 @@
+/**
+* @file      FixedString.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Bencoded data built at compile time.
+*/
+
+#ifndef BENCODING_FIXED_STRING_H
+#define BENCODING_FIXED_STRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bencoding {
+
+namespace internal {
+
+/**
+* @brief Compile-time sequence of indexes (@c std::index_sequence is not
+*        available in C++11).
+*/
+template <std::size_t... Indexes>
+struct IndexSequence {};
+
+/**
+* @brief Creates IndexSequence<0, 1, ..., @a N - 1>.
+*/
+template <std::size_t N, std::size_t... Indexes>
+struct MakeIndexSequence: MakeIndexSequence<N - 1, N - 1, Indexes...> {};
+
+template <std::size_t... Indexes>
+struct MakeIndexSequence<0, Indexes...> {
+	using Type = IndexSequence<Indexes...>;
+};
+
+/**
+* @brief Returns the number of decimal digits of @a num.
+*/
+constexpr std::size_t decimalLength(std::uint64_t num) {
+	return num < 10 ? 1 : 1 + decimalLength(num / 10);
+}
+
+/**
+* @brief Returns the absolute value of @a num (without overflowing for the
+*        most negative number).
+*/
+constexpr std::uint64_t absoluteValue(std::int64_t num) {
+	return num < 0 ? 0 - static_cast<std::uint64_t>(num) :
+		static_cast<std::uint64_t>(num);
+}
+
+/**
+* @brief Returns @a base raised to @a exponent.
+*/
+constexpr std::uint64_t power(std::uint64_t base, std::size_t exponent) {
+	return exponent == 0 ? 1 : base * power(base, exponent - 1);
+}
+
+/**
+* @brief Returns the @a index-th decimal digit of @a num, counted from the
+*        most significant one.
+*/
+constexpr char decimalDigit(std::uint64_t num, std::size_t index) {
+	return static_cast<char>('0' +
+		num / power(10, decimalLength(num) - index - 1) % 10);
+}
+
+/**
+* @brief Returns the length of the encoded integer @a value.
+*/
+constexpr std::size_t encodedIntegerLength(std::int64_t value) {
+	return (value < 0 ? 3 : 2) + decimalLength(absoluteValue(value));
+}
+
+} // namespace internal
+
+/**
+* @brief Sequence of @a Size bytes that can be created and concatenated at
+*        compile time.
+*
+* It is meant for the fixed parts of bencoded messages (e.g. the skeleton
+* <tt>d8:intervali1800e5:peers</tt> of tracker responses). They are encoded
+* by the compiler, so they can be emitted by a single copy at runtime (see
+* EncodedWriter).
+*
+* Usage:
+* @code
+* constexpr auto prefix = fixedString("d") + encodedString("interval") +
+*     encodedInteger<1800>() + encodedString("peers");
+* @endcode
+*
+* Like @c std::array, it is an aggregate so that it can be constructed in
+* constant expressions. Create it by the functions below instead of
+* initializing it directly.
+*/
+template <std::size_t Size>
+struct FixedString {
+	/**
+	* @brief Returns the number of bytes.
+	*/
+	constexpr std::size_t size() const {
+		return Size;
+	}
+
+	/**
+	* @brief Returns the byte at @a index.
+	*/
+	constexpr char operator[](std::size_t index) const {
+		return chars[index];
+	}
+
+	/**
+	* @brief Returns a pointer to the bytes, which are followed by a null
+	*        byte.
+	*/
+	constexpr const char *data() const {
+		return chars;
+	}
+
+	/**
+	* @brief Returns the bytes as a string.
+	*/
+	std::string str() const {
+		return std::string(chars, Size);
+	}
+
+	/// The bytes followed by a null byte.
+	char chars[Size + 1];
+};
+
+namespace internal {
+
+template <std::size_t Size, std::size_t... Indexes>
+constexpr FixedString<Size> makeFixedString(const char *str,
+		IndexSequence<Indexes...>) {
+	return FixedString<Size>{{str[Indexes]..., '\0'}};
+}
+
+template <std::size_t LhsSize, std::size_t RhsSize, std::size_t... Indexes>
+constexpr FixedString<LhsSize + RhsSize> concatenate(
+		const FixedString<LhsSize> &lhs, const FixedString<RhsSize> &rhs,
+		IndexSequence<Indexes...>) {
+	return FixedString<LhsSize + RhsSize>{{
+		(Indexes < LhsSize ? lhs[Indexes] : rhs[Indexes - LhsSize])..., '\0'
+	}};
+}
+
+template <std::size_t... Indexes>
+constexpr FixedString<sizeof...(Indexes)> makeDecimal(std::uint64_t num,
+		IndexSequence<Indexes...>) {
+	return FixedString<sizeof...(Indexes)>{{decimalDigit(num, Indexes)..., '\0'}};
+}
+
+/**
+* @brief Returns the decimal representation of @a Num.
+*/
+template <std::uint64_t Num>
+constexpr FixedString<decimalLength(Num)> decimal() {
+	return makeDecimal(Num,
+		typename MakeIndexSequence<decimalLength(Num)>::Type());
+}
+
+/**
+* @brief Returns the beginning of an encoded integer (with the sign of
+*        negative integers).
+*/
+template <bool IsNegative>
+constexpr FixedString<IsNegative ? 2 : 1> encodedIntegerPrefix();
+
+template <>
+constexpr FixedString<2> encodedIntegerPrefix<true>() {
+	return FixedString<2>{{'i', '-', '\0'}};
+}
+
+template <>
+constexpr FixedString<1> encodedIntegerPrefix<false>() {
+	return FixedString<1>{{'i', '\0'}};
+}
+
+} // namespace internal
+
+/**
+* @brief Returns the concatenation of @a lhs and @a rhs.
+*/
+template <std::size_t LhsSize, std::size_t RhsSize>
+constexpr FixedString<LhsSize + RhsSize> operator+(
+		const FixedString<LhsSize> &lhs, const FixedString<RhsSize> &rhs) {
+	return internal::concatenate(lhs, rhs,
+		typename internal::MakeIndexSequence<LhsSize + RhsSize>::Type());
+}
+
+/**
+* @brief Returns the bytes of the string literal @a str (without the
+*        terminating null byte).
+*/
+template <std::size_t N>
+constexpr FixedString<N - 1> fixedString(const char (&str)[N]) {
+	return internal::makeFixedString<N - 1>(str,
+		typename internal::MakeIndexSequence<N - 1>::Type());
+}
+
+/**
+* @brief Returns the string literal @a str encoded as a bencoded string.
+*
+* For example, @c encodedString("peers") is <tt>5:peers</tt>.
+*/
+template <std::size_t N>
+constexpr FixedString<internal::decimalLength(N - 1) + N> encodedString(
+		const char (&str)[N]) {
+	return internal::decimal<N - 1>() + fixedString(":") + fixedString(str);
+}
+
+/**
+* @brief Returns @a Value encoded as a bencoded integer.
+*
+* For example, @c encodedInteger<1800>() is <tt>i1800e</tt>.
+*/
+template <std::int64_t Value>
+constexpr FixedString<internal::encodedIntegerLength(Value)> encodedInteger() {
+	return internal::encodedIntegerPrefix<(Value < 0)>() +
+		internal::decimal<internal::absoluteValue(Value)>() + fixedString("e");
+}
+
+} // namespace bencoding
+
+#endif
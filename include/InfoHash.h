@@ -0,0 +1,33 @@
+/**
+* @file      InfoHash.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Computation of info hashes of torrent files.
+*/
+
+#ifndef BENCODING_INFOHASH_H
+#define BENCODING_INFOHASH_H
+
+#include <cstddef>
+#include <string>
+
+#include "Scanner.h"
+
+namespace bencoding {
+
+/// @name Info Hashes
+/// @{
+
+StringRef findInfoDictionary(const char *data, std::size_t size);
+StringRef findInfoDictionary(const std::string &data);
+
+std::string infoHashV1(const char *data, std::size_t size);
+std::string infoHashV1(const std::string &data);
+std::string infoHashV2(const char *data, std::size_t size);
+std::string infoHashV2(const std::string &data);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
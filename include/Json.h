@@ -0,0 +1,61 @@
+/**
+* @file      Json.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Transcoding between bencoded data and JSON.
+*/
+
+#ifndef BENCODING_JSON_H
+#define BENCODING_JSON_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace bencoding {
+
+/**
+* @brief Representation of strings that are not valid UTF-8 (e.g. the
+*        @c pieces value) in JSON.
+*
+* Strings that are valid UTF-8 are always written as JSON strings. As JSON
+* strings cannot contain arbitrary bytes, other strings are encoded. The
+* encoding is not marked in the output, so consumers have to know which
+* values are binary.
+*/
+enum class JsonBinaryStrings {
+	Base64, ///< Written as JSON strings with the Base64 encoding of the bytes.
+	Hex,    ///< Written as JSON strings with the bytes in hex.
+	Reject  ///< Rejected by throwing DecodingError.
+};
+
+/// @name Bencode To JSON
+/// @{
+
+void bencodeToJson(const char *data, std::size_t size, std::ostream &output,
+	JsonBinaryStrings binaryStrings = JsonBinaryStrings::Base64);
+void bencodeToJson(const std::string &data, std::ostream &output,
+	JsonBinaryStrings binaryStrings = JsonBinaryStrings::Base64);
+std::string bencodeToJson(const std::string &data,
+	JsonBinaryStrings binaryStrings = JsonBinaryStrings::Base64);
+
+/// @}
+
+/// Default maximal size of an object encoded by jsonToBencode().
+const std::size_t MAX_JSON_OBJECT_SIZE = 64 * 1024 * 1024;
+
+/// @name JSON To Bencode
+/// @{
+
+void jsonToBencode(const char *data, std::size_t size, std::ostream &output,
+	std::size_t maxObjectSize = MAX_JSON_OBJECT_SIZE);
+void jsonToBencode(const std::string &json, std::ostream &output,
+	std::size_t maxObjectSize = MAX_JSON_OBJECT_SIZE);
+std::string jsonToBencode(const std::string &json,
+	std::size_t maxObjectSize = MAX_JSON_OBJECT_SIZE);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
@@ -0,0 +1,151 @@
+/**
+* @file      Krpc.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Codec of KRPC messages used by the BitTorrent DHT.
+*/
+
+#ifndef BENCODING_KRPC_H
+#define BENCODING_KRPC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "EncodedWriter.h"
+#include "Scanner.h"
+
+namespace bencoding {
+
+/**
+* @brief Value of an argument or a return value of a KRPC message.
+*
+* Strings and integers are stored directly. Other values (lists and
+* dictionaries, e.g. the @c want argument) are kept in their encoded form.
+*/
+class KrpcValue {
+public:
+	/// Kinds of values.
+	enum class Kind {
+		String,
+		Integer,
+		Encoded
+	};
+
+public:
+	KrpcValue();
+
+	static KrpcValue string(const StringRef &str);
+	static KrpcValue integer(std::int64_t value);
+	static KrpcValue encoded(const StringRef &encodedValue);
+
+	Kind kind() const;
+	bool isString() const;
+	bool isInteger() const;
+	StringRef str() const;
+	std::int64_t integerValue() const;
+
+private:
+	/// Kind of the value.
+	Kind valueKind;
+
+	/// The string or the encoded value.
+	StringRef bytes;
+
+	/// The integer.
+	std::int64_t number;
+};
+
+/**
+* @brief Named argument (or return value) of a KRPC message.
+*/
+struct KrpcArgument {
+	/// Name of the argument.
+	StringRef key;
+
+	/// Value of the argument.
+	KrpcValue value;
+};
+
+/**
+* @brief KRPC message (a query, a response, or an error) with a fixed layout.
+*
+* The message does not own any data. Its strings refer into the decoded
+* datagram (see decodeKrpcMessage()) or to data provided by the caller, which
+* have to outlive the message. Hence, neither decoding nor encoding messages
+* allocates.
+*
+* The arguments of queries (the @c a dictionary) and the return values of
+* responses (the @c r dictionary) are stored in a fixed array of at most
+* MAX_ARGUMENTS items.
+*/
+class KrpcMessage {
+public:
+	/// Types of messages (the @c y key).
+	enum class Type {
+		Query,
+		Response,
+		Error
+	};
+
+	/// Maximal number of arguments or return values.
+	static const std::size_t MAX_ARGUMENTS = 16;
+
+	/// Maximal size of an encoded message (a UDP datagram over Ethernet).
+	static const std::size_t MAX_SIZE = 1500;
+
+public:
+	KrpcMessage();
+
+	/// @name Arguments
+	/// @{
+	std::size_t numOfArguments() const;
+	const KrpcArgument &argument(std::size_t index) const;
+	const KrpcValue *find(const StringRef &key) const;
+	bool getString(const StringRef &key, StringRef &str) const;
+	bool getInteger(const StringRef &key, std::int64_t &value) const;
+	void addArgument(const StringRef &key, const KrpcValue &value);
+	void clearArguments();
+	/// @}
+
+public:
+	/// Type of the message (@c y).
+	Type type;
+
+	/// Transaction ID (@c t).
+	StringRef transactionId;
+
+	/// Name of the method of queries (@c q).
+	StringRef method;
+
+	/// Version of the client (@c v), empty if not present.
+	StringRef version;
+
+	/// Code of errors (the first item of @c e).
+	std::int64_t errorCode;
+
+	/// Message of errors (the second item of @c e).
+	StringRef errorMessage;
+
+private:
+	/// Arguments of queries or return values of responses.
+	KrpcArgument arguments[MAX_ARGUMENTS];
+
+	/// Number of arguments.
+	std::size_t argumentCount;
+};
+
+/// @name KRPC Decoding and Encoding
+/// @{
+
+KrpcMessage decodeKrpcMessage(const char *data, std::size_t size);
+KrpcMessage decodeKrpcMessage(const std::string &data);
+// The decoded message would refer into a destroyed string.
+KrpcMessage decodeKrpcMessage(std::string &&data) = delete;
+void encodeKrpcMessage(const KrpcMessage &message, EncodedWriter &writer);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
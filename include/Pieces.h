@@ -0,0 +1,86 @@
+/**
+* @file      Pieces.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Access to piece hashes and verification of downloaded pieces.
+*/
+
+#ifndef BENCODING_PIECES_H
+#define BENCODING_PIECES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Scanner.h"
+
+namespace bencoding {
+
+class BString;
+
+/**
+* @brief View of concatenated piece hashes as an array of digests.
+*
+* It is meant for the @c pieces value of the @c info dictionary (20-byte
+* SHA-1 digests) and for the piece layers of BitTorrent v2 (32-byte SHA-256
+* digests). The view does not own the hashes, so they have to outlive it.
+* Accessing a digest only computes its address; nothing is copied.
+*/
+class PieceHashes {
+public:
+	/// Size of SHA-1 digests in the @c pieces value.
+	static const std::size_t V1_HASH_SIZE = 20;
+
+	/// Size of SHA-256 digests in piece layers.
+	static const std::size_t V2_HASH_SIZE = 32;
+
+public:
+	PieceHashes(const StringRef &hashes, std::size_t hashSize = V1_HASH_SIZE);
+	PieceHashes(const BString &hashes, std::size_t hashSize = V1_HASH_SIZE);
+
+	/// @name Capacity
+	/// @{
+	std::size_t size() const;
+	bool empty() const;
+	std::size_t hashSize() const;
+	/// @}
+
+	/// @name Element Access
+	/// @{
+	StringRef operator[](std::size_t index) const;
+	const char *data() const;
+	bool matches(std::size_t index, const std::string &digest) const;
+	/// @}
+
+private:
+	/// The concatenated hashes.
+	StringRef hashes;
+
+	/// Size of a single hash.
+	std::size_t singleHashSize;
+};
+
+/**
+* @brief File of the payload of a torrent.
+*/
+struct PayloadFile {
+	/// Path to the file on the disk.
+	std::string path;
+
+	/// Length of the file (the @c length key).
+	std::uint64_t length;
+};
+
+/// @name Piece Verification
+/// @{
+
+std::vector<bool> verifyPieces(const std::vector<PayloadFile> &files,
+	std::uint64_t pieceLength, const PieceHashes &hashes,
+	unsigned numOfThreads = 0);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
@@ -8,7 +8,9 @@
 #ifndef BENCODING_PRETTYPRINTER_H
 #define BENCODING_PRETTYPRINTER_H
 
+#include <cstddef>
 #include <memory>
+#include <ostream>
 #include <string>
 
 #include "BItemVisitor.h"
@@ -17,10 +19,29 @@ namespace bencoding {
 
 class BItem;
 
+/**
+* @brief Format of binary strings (e.g. the @c pieces value) in pretty
+*        representations.
+*
+* A string is considered binary when it contains a control character other
+* than a tab, a newline, or a carriage return.
+*/
+enum class BinaryStringFormat {
+	Escaped, ///< Escaped like other strings (e.g. <tt>"\x3f\x1a"</tt>).
+	Hex,     ///< All bytes in hex (e.g. <tt>\<3f1a\></tt>).
+	Summary  ///< Size and a few bytes in hex (e.g. <tt>\<20000 bytes: 3f1a...\></tt>).
+};
+
 /**
 * @brief Pretty printer of data.
 *
-* Can format data in a readable way.
+* Can format data in a readable way. The representation can be either
+* returned as a string (getPrettyRepr()) or written incrementally into a
+* stream (printPrettyRepr()).
+*
+* Quotes, backslashes, and control characters in strings are escaped (e.g.
+* <tt>\"</tt>, <tt>\\</tt>, <tt>\n</tt>, or <tt>\x01</tt>). How binary
+* strings are represented can be set by setBinaryStringFormat().
 *
 * Use create() to create instances.
 */
@@ -30,6 +51,11 @@ public:
 
 	std::string getPrettyRepr(std::shared_ptr<BItem> data,
 		const std::string &indent = "    ");
+	void printPrettyRepr(std::shared_ptr<BItem> data, std::ostream &output,
+		const std::string &indent = "    ");
+
+	void setBinaryStringFormat(BinaryStringFormat format);
+	BinaryStringFormat getBinaryStringFormat() const;
 
 private:
 	PrettyPrinter();
@@ -49,21 +75,44 @@ private:
 	void decreaseIndentLevel();
 	/// @}
 
+	void storeString(const std::string &str);
+	void storeBinaryString(const std::string &str);
+
+	/// @name Output
+	/// @{
+	void flushIfFull();
+	void flush();
+	/// @}
+
 private:
-	/// Pretty representation of the data obtained so far.
+	/// Pretty representation of the data obtained so far (when printing
+	/// into a stream, only the part that has not been written yet).
 	std::string prettyRepr = "";
 
+	/// Stream into which the representation is printed (if any).
+	std::ostream *output = nullptr;
+
+	/// Format of binary strings.
+	BinaryStringFormat binaryStringFormat = BinaryStringFormat::Escaped;
+
 	/// A single level of indentation.
 	std::string indentLevel = "    ";
 
-	/// The current level of indentation.
-	std::string currentIndent = "";
+	/// The current level of indentation (the number of nested containers).
+	std::size_t currentIndentLevel = 0;
+
+	/// @c indentLevel repeated for the deepest level reached so far. The
+	/// indentation of every level is its prefix, so it is stored without
+	/// creating any string.
+	std::string indentTable = "";
 };
 
 /// @name Printing Without Explicit Printer Creation
 /// @{
 std::string getPrettyRepr(std::shared_ptr<BItem> data,
 	const std::string &indent = "    ");
+void printPrettyRepr(std::shared_ptr<BItem> data, std::ostream &output,
+	const std::string &indent = "    ");
 /// @}
 
 } // namespace bencoding
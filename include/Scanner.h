@@ -0,0 +1,185 @@
+/**
+* @file      Scanner.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Scanner of bencoded data stored in a buffer.
+*/
+
+#ifndef BENCODING_SCANNER_H
+#define BENCODING_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bencoding {
+
+/**
+* @brief Non-owning reference to a sequence of bytes.
+*
+* The referenced data have to outlive the reference.
+*/
+class StringRef {
+public:
+	StringRef();
+	StringRef(const char *data, std::size_t size);
+	StringRef(const char *str);
+	StringRef(const std::string &str);
+
+	const char *data() const;
+	std::size_t size() const;
+	bool empty() const;
+	std::string str() const;
+
+	/// @name Iterators
+	/// @{
+	const char *begin() const;
+	const char *end() const;
+	/// @}
+
+	int compare(const StringRef &other) const;
+
+private:
+	/// Beginning of the referenced data.
+	const char *refData;
+
+	/// Number of referenced bytes.
+	std::size_t refSize;
+};
+
+bool operator==(const StringRef &lhs, const StringRef &rhs);
+bool operator!=(const StringRef &lhs, const StringRef &rhs);
+bool operator<(const StringRef &lhs, const StringRef &rhs);
+
+/**
+* @brief Scanner of bencoded data stored in a buffer.
+*
+* In contrast to Decoder, the scanner does not build any BItem. It walks over
+* the data in place and returns references into the scanned buffer, so it
+* performs no allocations. The scanned buffer has to outlive the scanner and
+* all the references it has returned.
+*
+* When the data are malformed, DecodingError is thrown.
+*/
+class Scanner {
+public:
+	Scanner(const char *data, std::size_t size);
+	explicit Scanner(const std::string &data);
+	// Temporary strings would be destroyed while they are being scanned.
+	Scanner(std::string &&data) = delete;
+
+	/// @name Position
+	/// @{
+	std::size_t position() const;
+	std::size_t remaining() const;
+	bool atEnd() const;
+	char peek() const;
+	/// @}
+
+	/// @name Containers
+	/// @{
+	void enterDictionary();
+	void enterList();
+	bool atContainerEnd() const;
+	void leaveContainer();
+	/// @}
+
+	/// @name Values
+	/// @{
+	StringRef readString();
+	std::int64_t readInteger();
+	StringRef skipItem();
+	/// @}
+
+	/// @name Walking
+	/// @{
+	template <typename Handler>
+	void walk(Handler &handler);
+	/// @}
+
+private:
+	void readEnd() const;
+	void readExpectedChar(char expectedChar);
+	std::size_t readStringLength();
+	void skipInteger();
+	void skipString();
+
+private:
+	/// Beginning of the scanned data.
+	const char *first;
+
+	/// Current position in the scanned data.
+	const char *current;
+
+	/// End of the scanned data.
+	const char *last;
+};
+
+/**
+* @brief Scans the remaining data, which have to form a single item, and
+*        reports its parts to @a handler.
+*
+* @a handler has to provide the following member functions, which are called
+* in the order in which the reported parts appear in the data:
+*  - @c startDictionary() and @c startList() at the beginning of a container,
+*  - @c endContainer(bool isDictionary) at the end of a container,
+*  - @c key(const StringRef &) for every key of a dictionary,
+*  - @c integer(std::int64_t) and @c string(const StringRef &) for values,
+*  - @c separator() between two items (or key-value pairs) of a container.
+*
+* Nesting is tracked by a stack of the open containers, so deeply nested data
+* do not exhaust the call stack.
+*
+* @throws DecodingError When the data are malformed or there are characters
+*         after the item.
+*/
+template <typename Handler>
+void Scanner::walk(Handler &handler) {
+	// Types ('d' or 'l') of the open containers.
+	std::vector<char> openContainers;
+	for (;;) {
+		// Scan a value.
+		char c = peek();
+		if (c == 'd') {
+			enterDictionary();
+			handler.startDictionary();
+			openContainers.push_back(c);
+		} else if (c == 'l') {
+			enterList();
+			handler.startList();
+			openContainers.push_back(c);
+		} else if (c == 'i') {
+			handler.integer(readInteger());
+		} else {
+			handler.string(readString());
+		}
+
+		// Close finished containers and move to the next value.
+		bool isFirstItem = c == 'd' || c == 'l';
+		for (;;) {
+			if (openContainers.empty()) {
+				readEnd();
+				return;
+			}
+			if (atContainerEnd()) {
+				leaveContainer();
+				handler.endContainer(openContainers.back() == 'd');
+				openContainers.pop_back();
+				isFirstItem = false;
+				continue;
+			}
+			if (!isFirstItem) {
+				handler.separator();
+			}
+			if (openContainers.back() == 'd') {
+				handler.key(readString());
+			}
+			break;
+		}
+	}
+}
+
+} // namespace bencoding
+
+#endif
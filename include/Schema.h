@@ -0,0 +1,489 @@
+/**
+* @file      Schema.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Binding of bencoded data to C++ structures.
+*/
+
+#ifndef BENCODING_SCHEMA_H
+#define BENCODING_SCHEMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "BItem.h"
+#include "Decoder.h"
+#include "Scanner.h"
+#include "Utils.h"
+
+/**
+* @brief Binds the dictionary key @a key to the member @a member of @a Type.
+*
+* To be used as an argument of BENCODING_SCHEMA().
+*/
+#define BENCODING_FIELD(Type, key, member) \
+	::bencoding::SchemaField<Type, decltype(Type::member), &Type::member>( \
+		key, sizeof(key) - 1)
+
+/**
+* @brief Binds the structure @a Type to a bencoded dictionary with the given
+*        fields (see BENCODING_FIELD()).
+*
+* Usage (in the namespace of @a Type):
+* @code
+* struct FileEntry {
+*     std::int64_t length;
+*     std::vector<std::string> path;
+* };
+*
+* BENCODING_SCHEMA(FileEntry,
+*     BENCODING_FIELD(FileEntry, "length", length),
+*     BENCODING_FIELD(FileEntry, "path", path)
+* );
+* @endcode
+*
+* The fields have to be listed in the lexicographical order of their keys,
+* which is the order in which they appear in canonically encoded data. This is
+* checked at compile time.
+*/
+#define BENCODING_SCHEMA(Type, ...) \
+	constexpr auto bencodingSchema(const Type *) -> \
+			decltype(::bencoding::makeSchemaFields(__VA_ARGS__)) { \
+		return ::bencoding::makeSchemaFields(__VA_ARGS__); \
+	} \
+	static_assert(bencodingSchema(static_cast<const Type *>(nullptr)) \
+		.areKeysSorted(), "keys of " #Type " have to be sorted and unique")
+
+namespace bencoding {
+
+template <typename T, typename Enable = void>
+struct SchemaCodec;
+
+namespace internal {
+
+/**
+* @brief Compares two keys in the same way as StringRef::compare() but at
+*        compile time.
+*/
+constexpr int compareKeys(const char *lhs, std::size_t lhsSize,
+		const char *rhs, std::size_t rhsSize) {
+	return lhsSize == 0 || rhsSize == 0 ?
+			(lhsSize == rhsSize ? 0 : (lhsSize == 0 ? -1 : 1)) :
+		*lhs != *rhs ?
+			(static_cast<unsigned char>(*lhs) < static_cast<unsigned char>(*rhs) ?
+				-1 : 1) :
+		compareKeys(lhs + 1, lhsSize - 1, rhs + 1, rhsSize - 1);
+}
+
+void appendEncodedUnsignedInteger(std::string &out, std::uint64_t value);
+void appendEncodedString(std::string &out, const char *data, std::size_t size);
+void appendEncodedItem(std::string &out, const std::shared_ptr<BItem> &item);
+std::shared_ptr<BItem> decodeItem(Scanner &scanner);
+void throwIntegerOutOfRange(std::int64_t value);
+void throwUndecodedCharacters();
+
+/**
+* @brief Converts the decoded @a value into a signed integral type @a T.
+*/
+template <typename T>
+T toIntegral(std::int64_t value, std::true_type) {
+	if (value < std::numeric_limits<T>::min() ||
+			value > std::numeric_limits<T>::max()) {
+		throwIntegerOutOfRange(value);
+	}
+	return static_cast<T>(value);
+}
+
+/**
+* @brief Converts the decoded @a value into an unsigned integral type @a T.
+*/
+template <typename T>
+T toIntegral(std::int64_t value, std::false_type) {
+	if (value < 0 ||
+			static_cast<std::uint64_t>(value) > std::numeric_limits<T>::max()) {
+		throwIntegerOutOfRange(value);
+	}
+	return static_cast<T>(value);
+}
+
+/**
+* @brief Checks if @a T has been bound by BENCODING_SCHEMA().
+*/
+template <typename T>
+class HasSchema {
+private:
+	template <typename U>
+	static auto check(int) -> decltype(
+		bencodingSchema(static_cast<const U *>(nullptr)), std::true_type());
+
+	template <typename U>
+	static std::false_type check(...);
+
+public:
+	static const bool value = decltype(check<T>(0))::value;
+};
+
+} // namespace internal
+
+/**
+* @brief Binding of a dictionary key to the member @a Pointer of @a Class.
+*
+* Use BENCODING_FIELD() to create fields.
+*/
+template <typename Class, typename Member, Member Class::*Pointer>
+class SchemaField {
+public:
+	/// Type of the member.
+	using MemberType = Member;
+
+public:
+	constexpr SchemaField(const char *key, std::size_t keySize):
+		key(key), keySize(keySize) {}
+
+	/**
+	* @brief Returns the member of @a object.
+	*/
+	static Member &of(Class &object) {
+		return object.*Pointer;
+	}
+
+	/**
+	* @brief Returns the member of @a object.
+	*/
+	static const Member &of(const Class &object) {
+		return object.*Pointer;
+	}
+
+public:
+	/// Key of the field.
+	const char *key;
+
+	/// Length of the key.
+	std::size_t keySize;
+};
+
+template <typename... Fields>
+class SchemaFields;
+
+/**
+* @brief End of a list of fields.
+*/
+template <>
+class SchemaFields<> {
+public:
+	constexpr SchemaFields() {}
+
+	constexpr bool areKeysSortedAfter(const char *, std::size_t) const {
+		return true;
+	}
+
+	template <typename Class>
+	bool decodeField(Class &, const StringRef &, Scanner &, std::size_t &,
+			std::size_t) const {
+		return false;
+	}
+
+	template <typename Class>
+	void encodeFields(std::string &, const Class &) const {}
+};
+
+/**
+* @brief Compile-time list of fields of a structure, sorted by their keys.
+*
+* Use BENCODING_SCHEMA() to create lists of fields.
+*/
+template <typename Field, typename... Rest>
+class SchemaFields<Field, Rest...> {
+public:
+	constexpr SchemaFields(Field field, Rest... rest):
+		field(field), rest(rest...) {}
+
+	/**
+	* @brief Checks if the keys are sorted and unique.
+	*/
+	constexpr bool areKeysSorted() const {
+		return rest.areKeysSortedAfter(field.key, field.keySize);
+	}
+
+	/**
+	* @brief Checks if the keys are sorted, unique, and follow @a key.
+	*/
+	constexpr bool areKeysSortedAfter(const char *key, std::size_t keySize) const {
+		return internal::compareKeys(key, keySize, field.key, field.keySize) < 0 &&
+			areKeysSorted();
+	}
+
+	/**
+	* @brief Decodes the value for @a key from @a scanner into the member of
+	*        @a object bound to @a key.
+	*
+	* Fields with indexes lower than @a cursor are not considered (their keys
+	* precede @a key when the data are sorted). Since the fields are sorted,
+	* the search stops at the first field whose key follows @a key. When a
+	* field is found, @a cursor is moved past it. Thus, decoding a sorted
+	* dictionary compares every key with every field at most once.
+	*
+	* @return @c true if a field has been found and decoded, @c false
+	*         otherwise (the value has not been read).
+	*/
+	template <typename Class>
+	bool decodeField(Class &object, const StringRef &key, Scanner &scanner,
+			std::size_t &cursor, std::size_t index) const {
+		if (index >= cursor) {
+			int order = key.compare(StringRef(field.key, field.keySize));
+			if (order == 0) {
+				SchemaCodec<typename Field::MemberType>::decode(scanner,
+					Field::of(object));
+				cursor = index + 1;
+				return true;
+			} else if (order < 0) {
+				return false;
+			}
+		}
+		return rest.decodeField(object, key, scanner, cursor, index + 1);
+	}
+
+	/**
+	* @brief Appends the keys and encoded members of @a object to @a out.
+	*/
+	template <typename Class>
+	void encodeFields(std::string &out, const Class &object) const {
+		internal::appendEncodedString(out, field.key, field.keySize);
+		SchemaCodec<typename Field::MemberType>::encode(out, Field::of(object));
+		rest.encodeFields(out, object);
+	}
+
+private:
+	/// The first field.
+	Field field;
+
+	/// The remaining fields.
+	SchemaFields<Rest...> rest;
+};
+
+/**
+* @brief Creates a list of the given @a fields.
+*/
+template <typename... Fields>
+constexpr SchemaFields<Fields...> makeSchemaFields(Fields... fields) {
+	return SchemaFields<Fields...>(fields...);
+}
+
+/**
+* @brief Decoding and encoding of integers.
+*/
+template <typename T>
+struct SchemaCodec<T, typename std::enable_if<std::is_integral<T>::value &&
+		!std::is_same<T, bool>::value>::type> {
+	static void decode(Scanner &scanner, T &value) {
+		value = internal::toIntegral<T>(scanner.readInteger(),
+			std::is_signed<T>());
+	}
+
+	static void encode(std::string &out, const T &value) {
+		encode(out, value, std::is_signed<T>());
+	}
+
+private:
+	static void encode(std::string &out, const T &value, std::true_type) {
+		appendEncodedInteger(out, value);
+	}
+
+	static void encode(std::string &out, const T &value, std::false_type) {
+		internal::appendEncodedUnsignedInteger(out, value);
+	}
+};
+
+/**
+* @brief Decoding and encoding of strings.
+*/
+template <>
+struct SchemaCodec<std::string> {
+	static void decode(Scanner &scanner, std::string &value) {
+		StringRef str(scanner.readString());
+		value.assign(str.data(), str.size());
+	}
+
+	static void encode(std::string &out, const std::string &value) {
+		internal::appendEncodedString(out, value.data(), value.size());
+	}
+};
+
+/**
+* @brief Decoding and encoding of arbitrary items (to be used for fields whose
+*        structure is not known in advance).
+*/
+template <>
+struct SchemaCodec<std::shared_ptr<BItem>> {
+	static void decode(Scanner &scanner, std::shared_ptr<BItem> &value) {
+		value = internal::decodeItem(scanner);
+	}
+
+	static void encode(std::string &out, const std::shared_ptr<BItem> &value) {
+		internal::appendEncodedItem(out, value);
+	}
+};
+
+/**
+* @brief Decoding and encoding of lists.
+*/
+template <typename T>
+struct SchemaCodec<std::vector<T>> {
+	static void decode(Scanner &scanner, std::vector<T> &value) {
+		value.clear();
+		scanner.enterList();
+		while (!scanner.atContainerEnd()) {
+			value.emplace_back();
+			SchemaCodec<T>::decode(scanner, value.back());
+		}
+		scanner.leaveContainer();
+	}
+
+	static void encode(std::string &out, const std::vector<T> &value) {
+		out += 'l';
+		for (const auto &item : value) {
+			SchemaCodec<T>::encode(out, item);
+		}
+		out += 'e';
+	}
+};
+
+/**
+* @brief Decoding and encoding of dictionaries with arbitrary keys.
+*/
+template <typename T>
+struct SchemaCodec<std::map<std::string, T>> {
+	static void decode(Scanner &scanner, std::map<std::string, T> &value) {
+		value.clear();
+		scanner.enterDictionary();
+		while (!scanner.atContainerEnd()) {
+			StringRef key(scanner.readString());
+			// For sorted keys, the hint makes the insertion constant.
+			auto i = value.emplace_hint(value.end(), key.str(), T());
+			SchemaCodec<T>::decode(scanner, i->second);
+		}
+		scanner.leaveContainer();
+	}
+
+	static void encode(std::string &out, const std::map<std::string, T> &value) {
+		out += 'd';
+		for (const auto &item : value) {
+			internal::appendEncodedString(out, item.first.data(),
+				item.first.size());
+			SchemaCodec<T>::encode(out, item.second);
+		}
+		out += 'e';
+	}
+};
+
+/**
+* @brief Decoding and encoding of structures bound by BENCODING_SCHEMA().
+*
+* Keys without a field are skipped, and members whose keys are missing keep
+* their values.
+*/
+template <typename T>
+struct SchemaCodec<T, typename std::enable_if<
+		internal::HasSchema<T>::value>::type> {
+	static void decode(Scanner &scanner, T &value) {
+		auto fields = bencodingSchema(static_cast<const T *>(nullptr));
+		std::size_t cursor = 0;
+		StringRef previousKey;
+		bool isFirstKey = true;
+		scanner.enterDictionary();
+		while (!scanner.atContainerEnd()) {
+			StringRef key(scanner.readString());
+			if (!isFirstKey && !(previousKey < key)) {
+				// The keys are not sorted, so search all the fields.
+				cursor = 0;
+			}
+			if (!fields.decodeField(value, key, scanner, cursor, 0)) {
+				scanner.skipItem();
+			}
+			previousKey = key;
+			isFirstKey = false;
+		}
+		scanner.leaveContainer();
+	}
+
+	static void encode(std::string &out, const T &value) {
+		out += 'd';
+		bencodingSchema(static_cast<const T *>(nullptr)).encodeFields(out, value);
+		out += 'e';
+	}
+};
+
+/// @name Decoding and Encoding of Bound Structures
+/// @{
+
+/**
+* @brief Decodes @a size bytes of bencoded data starting at @a data into
+*        @a object.
+*
+* @a T can be a structure bound by BENCODING_SCHEMA(), an integral type,
+* @c std::string, @c std::vector or @c std::map with @c std::string keys of
+* these types, or @c std::shared_ptr<BItem>. No BItem is created unless @a T
+* contains @c std::shared_ptr<BItem>.
+*
+* If the data are malformed, do not match @a T, or there are some characters
+* left after them, DecodingError is thrown.
+*/
+template <typename T>
+void decodeInto(const char *data, std::size_t size, T &object) {
+	Scanner scanner(data, size);
+	SchemaCodec<T>::decode(scanner, object);
+	if (!scanner.atEnd()) {
+		internal::throwUndecodedCharacters();
+	}
+}
+
+/**
+* @brief Decodes bencoded @a data into @a object.
+*
+* See decodeInto(const char *, std::size_t, T &) for more details.
+*/
+template <typename T>
+void decodeInto(const std::string &data, T &object) {
+	decodeInto(data.data(), data.size(), object);
+}
+
+/**
+* @brief Decodes bencoded @a data into a new object of type @a T and returns
+*        it.
+*
+* See decodeInto(const char *, std::size_t, T &) for more details.
+*/
+template <typename T>
+T decodeAs(const std::string &data) {
+	T object;
+	decodeInto(data, object);
+	return object;
+}
+
+/**
+* @brief Encodes @a object and returns the bencoded data.
+*
+* See decodeInto(const char *, std::size_t, T &) for the supported types.
+*
+* Integers are encoded only when they fit into 64-bit signed integers, so
+* that the data can be decoded back. Otherwise, @c std::out_of_range is
+* thrown.
+*/
+template <typename T>
+std::string encodeFrom(const T &object) {
+	std::string out;
+	SchemaCodec<T>::encode(out, object);
+	return out;
+}
+
+/// @}
+
+} // namespace bencoding
+
+#endif
@@ -0,0 +1,115 @@
+/**
+* @file      Sha.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     SHA-1 and SHA-256 hash functions.
+*/
+
+#ifndef BENCODING_SHA_H
+#define BENCODING_SHA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bencoding {
+
+/**
+* @brief Implementation of the SHA compression function to be used.
+*/
+enum class ShaImplementation {
+	Auto,     ///< Use SHA CPU extensions (SHA-NI) when available.
+	Portable  ///< Always use the portable implementation.
+};
+
+/**
+* @brief Base class of the SHA hash functions operating on 64-byte blocks.
+*
+* Takes care of buffering of partial blocks and of the final padding.
+*/
+class ShaBase {
+public:
+	/// Size of a single block (in bytes).
+	static const std::size_t BlockSize = 64;
+
+public:
+	void update(const char *data, std::size_t size);
+	void update(const std::string &data);
+
+protected:
+	/// Compresses @a numOfBlocks consecutive blocks into @a state.
+	using CompressFunction = void (*)(std::uint32_t *state,
+		const unsigned char *blocks, std::size_t numOfBlocks);
+
+protected:
+	explicit ShaBase(CompressFunction compress);
+
+	std::string finish(std::size_t digestSize);
+
+protected:
+	/// Current state of the hash (SHA-1 uses only the first five words).
+	std::uint32_t state[8];
+
+private:
+	/// Compression function.
+	CompressFunction compress;
+
+	/// Data that do not form a complete block yet.
+	unsigned char buffer[BlockSize];
+
+	/// Number of bytes in @c buffer.
+	std::size_t bufferSize;
+
+	/// Total number of hashed bytes.
+	std::uint64_t totalSize;
+};
+
+/**
+* @brief SHA-1 hash function.
+*
+* Data are hashed incrementally by calling update(), and the resulting digest
+* is obtained by calling digest().
+*/
+class Sha1: public ShaBase {
+public:
+	/// Size of the digest (in bytes).
+	static const std::size_t DigestSize = 20;
+
+public:
+	explicit Sha1(ShaImplementation implementation = ShaImplementation::Auto);
+
+	std::string digest();
+
+	static bool hasHardwareSupport();
+};
+
+/**
+* @brief SHA-256 hash function.
+*
+* Data are hashed incrementally by calling update(), and the resulting digest
+* is obtained by calling digest().
+*/
+class Sha256: public ShaBase {
+public:
+	/// Size of the digest (in bytes).
+	static const std::size_t DigestSize = 32;
+
+public:
+	explicit Sha256(ShaImplementation implementation = ShaImplementation::Auto);
+
+	std::string digest();
+
+	static bool hasHardwareSupport();
+};
+
+/// @name Hashing Without Explicit Hash Creation
+/// @{
+std::string sha1(const char *data, std::size_t size);
+std::string sha1(const std::string &data);
+std::string sha256(const char *data, std::size_t size);
+std::string sha256(const std::string &data);
+/// @}
+
+} // namespace bencoding
+
+#endif
@@ -8,6 +8,8 @@
 #ifndef BENCODING_UTILS_H
 #define BENCODING_UTILS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <ios>
 #include <istream>
 #include <queue>
@@ -30,6 +32,10 @@ namespace bencoding {
 * @return @c true if the conversion was successful, @c false otherwise.
 *
 * If the conversion fails, @a num is left unchanged.
+*
+* The conversion goes through @c std::istringstream, so it allocates and
+* depends on the current locale. Use parseDecimal() in performance-sensitive
+* code.
 */
 template<typename N>
 bool strToNum(const std::string &str, N &num,
@@ -44,6 +50,42 @@ bool strToNum(const std::string &str, N &num,
 	return false;
 }
 
+bool parseDecimal(const char *first, const char *last, std::int64_t &num);
+bool parseUnsignedDecimal(const char *first, const char *last,
+	std::uint64_t &num);
+const char *readDecimalDigits(const char *first, const char *last,
+	bool negative, std::int64_t &num);
+
+/**
+* @brief Maximal number of characters written by writeDecimal() and
+*        writeUnsignedDecimal().
+*/
+const std::size_t MAX_DECIMAL_LENGTH = 20;
+
+std::size_t writeDecimal(char *buffer, std::int64_t num);
+std::size_t writeUnsignedDecimal(char *buffer, std::uint64_t num);
+void appendDecimal(std::string &str, std::int64_t num);
+
+/// @}
+
+/// @name Encoding
+/// @{
+
+/**
+* @brief Maximal number of characters written by writeEncodedInteger().
+*/
+const std::size_t MAX_ENCODED_INTEGER_LENGTH = MAX_DECIMAL_LENGTH + 2;
+
+/**
+* @brief Maximal number of characters written by writeEncodedStringHeader().
+*/
+const std::size_t MAX_ENCODED_STRING_HEADER_LENGTH = MAX_DECIMAL_LENGTH + 1;
+
+std::size_t writeEncodedInteger(char *buffer, std::int64_t num);
+std::size_t writeEncodedStringHeader(char *buffer, std::size_t size);
+void appendEncodedInteger(std::string &str, std::int64_t num);
+void appendEncodedStringHeader(std::string &str, std::size_t size);
+
 /// @}
 
 /// @name Data Reading
@@ -62,6 +104,48 @@ std::string replace(const std::string &str, char what,
 
 /// @}
 
+/// @name Character Scanning
+/// @{
+
+/**
+* @brief Characters found by findSpecialChar().
+*/
+enum class SpecialChars {
+	/// Quotes, backslashes, and control characters (below @c 0x20).
+	Escaped,
+
+	/// As @c Escaped, plus @c DEL (@c 0x7f).
+	EscapedOrDel,
+
+	/// As @c Escaped, plus non-ASCII bytes (@c 0x80 and above).
+	EscapedOrNonAscii
+};
+
+std::size_t findSpecialChar(const char *data, std::size_t size,
+	SpecialChars chars);
+bool containsBinaryChar(const char *data, std::size_t size);
+
+/// Lowercase hexadecimal digits.
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+/// @}
+
+/// @name Output
+/// @{
+
+/// Size of the output buffered before it is written into a stream.
+const std::size_t OUTPUT_BUFFER_SIZE = 64 * 1024;
+
+/// @}
+
+/// @name Hashing
+/// @{
+
+std::uint64_t sipHash(const char *data, std::size_t size,
+	std::uint64_t key0, std::uint64_t key1);
+
+/// @}
+
 } // namespace bencoding
 
 #endif
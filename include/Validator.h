@@ -0,0 +1,33 @@
+/**
+* @file      Validator.h
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Validation of canonical bencoded data.
+*/
+
+#ifndef BENCODING_VALIDATOR_H
+#define BENCODING_VALIDATOR_H
+
+#include <cstddef>
+#include <string>
+
+namespace bencoding {
+
+/**
+* @brief Maximal nesting of lists and dictionaries accepted by validate().
+*/
+const std::size_t MAX_VALIDATED_NESTING_DEPTH = 1024;
+
+/// @name Validation
+/// @{
+
+void validate(const char *data, std::size_t size);
+void validate(const std::string &data);
+bool isCanonical(const char *data, std::size_t size);
+bool isCanonical(const std::string &data);
+
+/// @}
+
+} // namespace bencoding
+
+#endif
@@ -13,12 +13,27 @@
 #include "BDictionary.h"
 #include "BInteger.h"
 #include "BItem.h"
+#include "BItemDispatch.h"
 #include "BItemVisitor.h"
 #include "BList.h"
+#include "BListSlice.h"
 #include "BString.h"
+#include "BinaryCache.h"
+#include "CompactPeers.h"
 #include "Decoder.h"
+#include "EncodedListView.h"
+#include "EncodedWriter.h"
 #include "Encoder.h"
+#include "FixedString.h"
+#include "InfoHash.h"
+#include "Json.h"
+#include "Krpc.h"
+#include "Pieces.h"
 #include "PrettyPrinter.h"
+#include "Scanner.h"
+#include "Schema.h"
+#include "Sha.h"
 #include "Utils.h"
+#include "Validator.h"
 
 #endif
@@ -7,10 +7,12 @@
 
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 
 #include "Decoder.h"
+#include "Json.h"
 #include "PrettyPrinter.h"
 
 using namespace bencoding;
@@ -40,10 +42,50 @@ void printHelp(const std::string &prog) {
 	std::cout
 		<< "A decoder of bencoded files.\n"
 		<< "\n"
-		<< "Usage: " << prog << " [FILE]\n"
+		<< "Usage: " << prog << " [--json] [FILE]\n"
 		<< "\n"
 		<< "If FILE is not given, the data are read from the standard input.\n"
-		<< "The decoded data are printed to the standard output.\n";
+		<< "The decoded data are printed to the standard output.\n"
+		<< "\n"
+		<< "Options:\n"
+		<< "  --json  Print the data as JSON. Strings that are not valid\n"
+		<< "          UTF-8 are printed in Base64. The whole input is read\n"
+		<< "          into memory before it is transcoded.\n";
+}
+
+/**
+* @brief Prints an error saying that the file @a path cannot be opened.
+*/
+int printCannotOpenFile(const std::string &path) {
+	std::cerr << "error: cannot open file '" << path << "'\n";
+	return 1;
+}
+
+/**
+* @brief Reads all the data from @a input.
+*/
+std::string readAll(std::istream &input) {
+	return std::string(std::istreambuf_iterator<char>(input),
+		std::istreambuf_iterator<char>());
+}
+
+/**
+* @brief Prints @a data transcoded into JSON to the standard output.
+*
+* The data are transcoded without being decoded into items, which is much
+* faster on large inputs. However, the transcoder works on data in memory, so
+* all of them are read before the transcoding starts.
+*/
+int printJson(const std::string &data) {
+	try {
+		bencodeToJson(data, std::cout);
+	} catch (const DecodingError &ex) {
+		std::cout.flush();
+		std::cerr << "\nerror: " << ex.what() << "\n";
+		return 1;
+	}
+	std::cout << "\n";
+	return 0;
 }
 
 } // anonymous namespace
@@ -54,11 +96,26 @@ int main(int argc, char **argv) {
 		return 0;
 	}
 
+	// Transcoding into JSON.
+	if (argc > 1 && std::string(argv[1]) == "--json") {
+		if (argc > 2) {
+			std::ifstream input(argv[2], std::ios::in | std::ios::binary);
+			if (!input.is_open()) {
+				return printCannotOpenFile(argv[2]);
+			}
+			return printJson(readAll(input));
+		}
+		return printJson(readAll(std::cin));
+	}
+
 	// Decoding.
 	std::shared_ptr<BItem> decodedData;
 	try {
 		if (argc > 1) {
 			std::ifstream input(argv[1]);
+			if (!input.is_open()) {
+				return printCannotOpenFile(argv[1]);
+			}
 			decodedData = decode(input);
 		} else {
 			decodedData = decode(std::cin);
@@ -68,8 +125,14 @@ int main(int argc, char **argv) {
 		return 1;
 	}
 
-	// Printing.
-	std::cout << getPrettyRepr(decodedData) << "\n";
+	// Printing (the representation is written as it is being created so that
+	// it is never held in memory as a whole).
+	// Binary strings (like pieces) are summarized so that they do not clutter
+	// the terminal.
+	auto printer = PrettyPrinter::create();
+	printer->setBinaryStringFormat(BinaryStringFormat::Summary);
+	printer->printPrettyRepr(decodedData, std::cout);
+	std::cout << "\n";
 
 	return 0;
 }
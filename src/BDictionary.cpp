@@ -5,14 +5,53 @@
 * @brief     Implementation of the BDictionary class.
 */
 #include "BDictionary.h"
+#include <cstdint>
 #include <map>
+#include <random>
+#include <utility>
 
 #include "BItemVisitor.h"
 #include "BString.h"
 #include "BList.h"
+#include "Utils.h"
 
 namespace bencoding {
 
+namespace {
+
+/**
+* @brief Random key of the hash function, chosen once per process.
+*/
+struct HashKey {
+	HashKey() {
+		std::random_device device;
+		std::uniform_int_distribution<std::uint64_t> distribution;
+		key0 = distribution(device);
+		key1 = distribution(device);
+	}
+
+	std::uint64_t key0;
+	std::uint64_t key1;
+};
+
+/**
+* @brief Returns the hash of the given @a key.
+*
+* Dictionary keys usually come from untrusted input, so a keyed hash with a
+* random key is used. Otherwise, an attacker could craft keys that all
+* collide in the hash index, turning every lookup into a linear scan.
+*/
+std::size_t hashKey(const std::string &key) {
+	static const HashKey hashFunctionKey;
+	return sipHash(key.data(), key.size(),
+		hashFunctionKey.key0, hashFunctionKey.key1);
+}
+
+} // anonymous namespace
+
+const BItem::Type BDictionary::ITEM_TYPE;
+const BDictionary::size_type BDictionary::HASH_INDEX_THRESHOLD;
+
 /**
 * @brief Checks if <tt>lhs->value() < rhs->value()</tt>.
 *
@@ -28,13 +67,13 @@ bool BDictionary::BStringByValueComparator::operator()(
 /**
 * @brief Constructs an empty dictionary.
 */
-BDictionary::BDictionary() = default;
+BDictionary::BDictionary(): BItem(ITEM_TYPE) {}
 
 /**
 * @brief Constructs a dictionary from the given items.
 */
 BDictionary::BDictionary(std::initializer_list<value_type> items):
-	itemMap(items) {}
+	BItem(ITEM_TYPE), itemMap(items) {}
 
 /**
 * @brief Creates and returns a new dictionary.
@@ -51,6 +90,29 @@ std::shared_ptr<BDictionary> BDictionary::create(
 	return std::shared_ptr<BDictionary>(new BDictionary(items));
 }
 
+/**
+* @brief Creates and returns a new dictionary containing the given @a items.
+*
+* When the items are sorted by their keys (e.g. because they come from
+* canonically encoded data), every item is appended to the end in constant
+* time. Otherwise, the items are inserted in the usual way. When a key appears
+* more than once, the last value wins.
+*/
+std::shared_ptr<BDictionary> BDictionary::create(
+		std::vector<value_type> items) {
+	auto bDictionary = create();
+	auto &itemMap = bDictionary->itemMap;
+	BStringByValueComparator isLess;
+	for (auto &item : items) {
+		if (itemMap.empty() || isLess(itemMap.rbegin()->first, item.first)) {
+			itemMap.emplace_hint(itemMap.end(), std::move(item));
+		} else {
+			itemMap[item.first] = std::move(item.second);
+		}
+	}
+	return bDictionary;
+}
+
 /**
 * @brief Returns the number of items in the dictionary.
 */
@@ -74,34 +136,251 @@ bool BDictionary::empty() const {
 *
 * If there is no value mapped to @a key, an insertion of a null pointer is
 * automatically performed, and a reference to this null pointer is returned.
+*
+* @throws FrozenItemError When the dictionary is frozen (even when @a key is
+*         present, since the returned reference allows modifying the value).
+*         Use find() or getValue() to read a frozen dictionary.
 */
 BDictionary::mapped_type &BDictionary::operator[](key_type key) {
-	return itemMap[key];
+	checkNotFrozen();
+
+	auto i = find(key);
+	if (i != itemMap.end()) {
+		return i->second;
+	}
+
+	auto inserted = itemMap.emplace(std::move(key), mapped_type()).first;
+	addToHashIndex(inserted);
+	return inserted->second;
 }
 
 BDictionary::mapped_type &BDictionary::operator[](std::string key) {
-    key_type tmpKey = key_type(BString::create(key));
-    return itemMap[tmpKey];
+    checkNotFrozen();
+    auto i = find(key);
+    if (i != itemMap.end()) {
+        return i->second;
+    }
+
+    return (*this)[BString::create(std::move(key))];
+}
+
+/**
+* @brief Inserts the given @a item unless there already is an item with the
+*        same key.
+*
+* @a hint is the position before which the item would be inserted. When it is
+* correct, the insertion takes amortized constant time, so use end() when
+* inserting items in the sorted order.
+*
+* @return Iterator to the inserted item, or to the already existing item with
+*         the same key.
+*/
+BDictionary::iterator BDictionary::insert(const_iterator hint,
+		value_type item) {
+	checkNotFrozen();
+
+	size_type oldSize = itemMap.size();
+	auto i = itemMap.insert(hint, std::move(item));
+	if (itemMap.size() != oldSize) {
+		addToHashIndex(i);
+	}
+	return i;
 }
 
 BDictionary::size_type BDictionary::erase(const std::string key) {
-    std::shared_ptr<BString> keystr = std::shared_ptr<BString>(BString::create(key));
-    return erase(keystr);
+    checkNotFrozen();
+    auto i = find(key);
+    if (i == itemMap.end()) {
+        return 0;
+    }
+
+    removeFromHashIndex(i);
+    itemMap.erase(i);
+    return 1;
 }
 
 BDictionary::size_type BDictionary::erase(const key_type& key) {
-    return itemMap.erase(key);
+    return erase(*key->value());
 }
 
 std::shared_ptr<BList> BDictionary::values() {
     BListPtr rst = BList::create();
-    for(auto item : itemMap){
+    rst->value().reserve(itemMap.size());
+    for(const auto &item : itemMap){
         rst->push_back(item.second);
     }
 
     return rst;
 }
 
+/**
+* @brief Returns an iterator to the item with the given @a key, or end() if
+*        there is no such item.
+*/
+BDictionary::iterator BDictionary::find(const key_type &key) {
+	return toIterator(static_cast<const BDictionary *>(this)->find(key));
+}
+
+/**
+* @brief Returns a constant iterator to the item with the given @a key, or
+*        end() if there is no such item.
+*/
+BDictionary::const_iterator BDictionary::find(const key_type &key) const {
+	if (!hashIndex.empty() || itemMap.size() >= HASH_INDEX_THRESHOLD) {
+		return findInHashIndex(*key->value());
+	}
+	// The key can be looked up directly, without creating a new one.
+	return itemMap.find(key);
+}
+
+/**
+* @brief Returns an iterator to the item whose key has the value @a key, or
+*        end() if there is no such item.
+*/
+BDictionary::iterator BDictionary::find(const std::string &key) {
+	return toIterator(static_cast<const BDictionary *>(this)->find(key));
+}
+
+/**
+* @brief Returns a constant iterator to the item whose key has the value @a
+*        key, or end() if there is no such item.
+*
+* When the dictionary has at least @c HASH_INDEX_THRESHOLD items, the hash
+* index is used (and built if it does not exist yet). Otherwise, the map is
+* searched with a temporary key that refers to @a key without copying it, so
+* no memory is allocated in either case.
+*/
+BDictionary::const_iterator BDictionary::find(const std::string &key) const {
+	if (!hashIndex.empty() || itemMap.size() >= HASH_INDEX_THRESHOLD) {
+		return findInHashIndex(key);
+	}
+
+	// The pointers below have no owner (they are created by the aliasing
+	// constructor from empty pointers), so they neither allocate nor free
+	// anything. The key is only compared, never modified.
+	BString probe(BString::ValueType(BString::ValueType(),
+		const_cast<std::string *>(&key)));
+	return itemMap.find(key_type(key_type(), &probe));
+}
+
+/**
+* @brief Checks if the dictionary currently has a hash index.
+*/
+bool BDictionary::isHashIndexed() const {
+	return !hashIndex.empty();
+}
+
+/**
+* @brief Converts the given constant iterator into a non-constant one.
+*/
+BDictionary::iterator BDictionary::toIterator(const_iterator i) {
+	// Erasing an empty range does nothing and returns a non-constant iterator
+	// to its end (in constant time).
+	return itemMap.erase(i, i);
+}
+
+/**
+* @brief Looks up @a key in the hash index, building the index first when it
+*        does not exist.
+*/
+BDictionary::const_iterator BDictionary::findInHashIndex(
+		const std::string &key) const {
+	if (hashIndex.empty()) {
+		buildHashIndex();
+	}
+
+	std::size_t hash = hashKey(key);
+	std::size_t mask = hashIndex.size() - 1;
+	for (std::size_t i = hash & mask; hashIndex[i].item != itemMap.end();
+			i = (i + 1) & mask) {
+		if (hashIndex[i].hash == hash && *hashIndex[i].item->first->value() == key) {
+			return hashIndex[i].item;
+		}
+	}
+	return itemMap.end();
+}
+
+/**
+* @brief (Re)builds the hash index of all the items.
+*
+* The size of the table is kept at least twice the number of items so that
+* the probe sequences stay short.
+*/
+void BDictionary::buildHashIndex() const {
+	std::size_t numOfSlots = 16;
+	while (numOfSlots < 2 * itemMap.size()) {
+		numOfSlots *= 2;
+	}
+	std::vector<HashIndexSlot> newIndex(numOfSlots, HashIndexSlot{0, itemMap.end()});
+	std::size_t mask = numOfSlots - 1;
+	for (auto item = itemMap.begin(); item != itemMap.end(); ++item) {
+		std::size_t hash = hashKey(*item->first->value());
+		std::size_t i = hash & mask;
+		while (newIndex[i].item != itemMap.end()) {
+			i = (i + 1) & mask;
+		}
+		newIndex[i] = HashIndexSlot{hash, item};
+	}
+	hashIndex.swap(newIndex);
+}
+
+/**
+* @brief Adds the given newly inserted @a item into the hash index (if there
+*        is one).
+*/
+void BDictionary::addToHashIndex(const_iterator item) const {
+	if (hashIndex.empty()) {
+		return;
+	}
+
+	if (2 * itemMap.size() > hashIndex.size()) {
+		// The rebuilt index contains all the items, including the new one.
+		buildHashIndex();
+		return;
+	}
+
+	std::size_t hash = hashKey(*item->first->value());
+	std::size_t mask = hashIndex.size() - 1;
+	std::size_t i = hash & mask;
+	while (hashIndex[i].item != itemMap.end()) {
+		i = (i + 1) & mask;
+	}
+	hashIndex[i] = HashIndexSlot{hash, item};
+}
+
+/**
+* @brief Removes the given @a item (that is about to be erased) from the hash
+*        index (if there is one).
+*
+* The following items in the probe sequence are shifted backwards, so no
+* tombstones are needed.
+*/
+void BDictionary::removeFromHashIndex(const_iterator item) const {
+	if (hashIndex.empty()) {
+		return;
+	}
+
+	std::size_t mask = hashIndex.size() - 1;
+	std::size_t i = hashKey(*item->first->value()) & mask;
+	while (hashIndex[i].item != item) {
+		i = (i + 1) & mask;
+	}
+
+	// Shift back every following item whose ideal slot is not in (i, j].
+	for (std::size_t j = (i + 1) & mask; hashIndex[j].item != itemMap.end();
+			j = (j + 1) & mask) {
+		std::size_t ideal = hashIndex[j].hash & mask;
+		bool canBeMoved = i <= j ?
+			(ideal <= i || ideal > j) :
+			(ideal <= i && ideal > j);
+		if (canBeMoved) {
+			hashIndex[i] = hashIndex[j];
+			i = j;
+		}
+	}
+	hashIndex[i].item = itemMap.end();
+}
+
 /**
 * @brief Returns an iterator to the beginning of the dictionary.
 */
@@ -144,6 +423,76 @@ BDictionary::const_iterator BDictionary::cend() const {
 	return itemMap.cend();
 }
 
+/**
+* @brief Returns a new, unfrozen dictionary with the same items.
+*
+* The keys and values are shared with this dictionary (see BItem::clone()).
+* The hash index is not copied; the clone builds its own one when needed.
+*/
+std::shared_ptr<BDictionary> BDictionary::clone() const {
+	auto copy = create();
+	copy->itemMap = itemMap;
+	return copy;
+}
+
+std::shared_ptr<BItem> BDictionary::cloneItem() const {
+	return clone();
+}
+
+/**
+* @brief Makes the dictionary, its keys, and its values immutable.
+*
+* The hash index is built now (when the dictionary is large enough), so the
+* @c const functions of a frozen dictionary do not modify it. See
+* BItem::freeze() for more details.
+*/
+void BDictionary::freeze() {
+	if (isFrozen()) {
+		return;
+	}
+
+	if (hashIndex.empty() && itemMap.size() >= HASH_INDEX_THRESHOLD) {
+		buildHashIndex();
+	}
+	markAsFrozen();
+	for (auto &item : itemMap) {
+		item.first->freeze();
+		if (item.second) {
+			item.second->freeze();
+		}
+	}
+}
+
+/**
+* @brief Returns the value mapped to @a key so that it can be modified.
+*
+* When the value is frozen (e.g. because the dictionary is a clone of a frozen
+* dictionary), it is replaced with its clone first, so the other dictionaries
+* sharing the value are not affected.
+*
+* @return The value, or a null pointer when there is no value mapped to
+*         @a key.
+*
+* @throws FrozenItemError When the dictionary is frozen.
+*/
+BDictionary::mapped_type BDictionary::unfrozenValue(const key_type &key) {
+	return unfrozenValue(*key->value());
+}
+
+BDictionary::mapped_type BDictionary::unfrozenValue(const std::string &key) {
+	checkNotFrozen();
+
+	auto i = find(key);
+	if (i == itemMap.end() || !i->second) {
+		return mapped_type();
+	}
+
+	if (i->second->isFrozen()) {
+		i->second = i->second->clone();
+	}
+	return i->second;
+}
+
 void BDictionary::accept(BItemVisitor *visitor) {
 	visitor->visit(this);
 }
@@ -154,26 +503,20 @@ BDictionary::mapped_type BDictionary::setDefault(std::string key, std::shared_pt
 }
 
 BDictionary::mapped_type BDictionary::setDefault(key_type key, mapped_type value) {
-    mapped_type tmp = itemMap[key];
-    if (tmp == nullptr) {
-        itemMap[key] = value;
+    mapped_type &mapped = (*this)[key];
+    if (mapped == nullptr) {
+        mapped = value;
     }
 
-    return itemMap[key];
+    return mapped;
 }
 
-bool BDictionary::hasKey(std::string key) {
-    std::shared_ptr<BString> tmpKey = std::shared_ptr<BString>(BString::create(key));
-    return hasKey(tmpKey);
+bool BDictionary::hasKey(const std::string &key) const {
+    return find(key) != itemMap.end();
 }
 
-bool BDictionary::hasKey(key_type key) {
-    // mapped_type tmp = itemMap[key];
-    if (itemMap.find(key) == itemMap.end()) {
-       return false;
-    }
-
-    return true;
+bool BDictionary::hasKey(const key_type &key) const {
+    return find(key) != itemMap.end();
 }
 
 } // namespace bencoding
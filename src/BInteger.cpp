@@ -11,10 +11,12 @@
 
 namespace bencoding {
 
+const BItem::Type BInteger::ITEM_TYPE;
+
 /**
 * @brief Constructs the integer with the given @a value.
 */
-BInteger::BInteger(ValueType value): _value(value) {}
+BInteger::BInteger(ValueType value): BItem(ITEM_TYPE), _value(value) {}
 
 /**
 * @brief Creates and returns a new integer.
@@ -34,9 +36,22 @@ auto BInteger::value() const -> ValueType {
 * @brief Sets a new value.
 */
 void BInteger::setValue(ValueType value) {
+	checkNotFrozen();
+
 	_value = value;
 }
 
+/**
+* @brief Returns a new, unfrozen integer with the same value.
+*/
+std::shared_ptr<BInteger> BInteger::clone() const {
+	return create(_value);
+}
+
+std::shared_ptr<BItem> BInteger::cloneItem() const {
+	return clone();
+}
+
 void BInteger::accept(BItemVisitor *visitor) {
 	visitor->visit(this);
 }
@@ -10,13 +10,91 @@
 namespace bencoding {
 
 /**
-* @brief Constructs the item.
+* @brief Constructs the exception with the given error message.
 */
-BItem::BItem() = default;
+FrozenItemError::FrozenItemError(const std::string &what):
+	std::logic_error(what) {}
+
+/**
+* @brief Constructs the item of the given @a type.
+*
+* Subclasses pass their @c ITEM_TYPE.
+*/
+BItem::BItem(Type type): itemType(type) {}
 
 /**
 * @brief Destructs the item.
 */
 BItem::~BItem() = default;
 
+/**
+* @brief Returns the type of the item.
+*
+* It determines the subclass of the item, so a @c switch over the type can be
+* used instead of casts (see dispatch()).
+*/
+BItem::Type BItem::type() const {
+	return itemType;
+}
+
+/**
+* @brief Returns a new, unfrozen copy of the item.
+*
+* The copy is shallow: a container is copied with pointers to the same items
+* as the original one, and a string is copied with its own copy of the value.
+* When the original item is frozen, its items are frozen as well, so they
+* cannot be modified through either of the containers. To modify such an item
+* in the copy, replace it with its own clone first (see
+* BList::unfrozenItem() and BDictionary::unfrozenValue()). A modified version
+* of a frozen tree thus shares all the unchanged subtrees with the original
+* one, and only the items on the paths to the changes are copied.
+*
+* When the original item is not frozen, modifications of the shared items are
+* visible through both the original and the copy.
+*
+* Subclasses return the copy as their own type.
+*/
+std::shared_ptr<BItem> BItem::clone() const {
+	return cloneItem();
+}
+
+/**
+* @brief Makes the item and all the items in it immutable.
+*
+* Frozen items can be shared by several trees (see clone()). Modifying a
+* frozen item throws FrozenItemError. Freezing an already frozen item
+* does nothing, so freezing a tree built from frozen subtrees only visits the
+* new items.
+*/
+void BItem::freeze() {
+	markAsFrozen();
+}
+
+/**
+* @brief Returns @c true if the item has been frozen, @c false otherwise.
+*/
+bool BItem::isFrozen() const {
+	return frozen;
+}
+
+/**
+* @brief Marks the item (but not the items in it) as frozen.
+*/
+void BItem::markAsFrozen() {
+	frozen = true;
+}
+
+/**
+* @brief Throws FrozenItemError if the item has been frozen.
+*
+* Modifiers call it before changing the item. Unlike an assertion, the check
+* is also done in release builds, so a frozen item shared by other trees or
+* threads cannot be modified by mistake.
+*/
+void BItem::checkNotFrozen() const {
+	if (frozen) {
+		throw FrozenItemError("cannot modify a frozen item");
+	}
+}
+
 } // namespace bencoding
@@ -7,24 +7,30 @@
 
 #include "BList.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <random>
 #include <chrono>
+#include <utility>
 #include "BItemVisitor.h"
+#include "BListSlice.h"
+#include "BString.h"
 
 namespace bencoding {
 
+const BItem::Type BList::ITEM_TYPE;
+
 /**
 * @brief Constructs an empty list.
 */
-BList::BList() = default;
+BList::BList(): BItem(ITEM_TYPE) {}
 
 /**
 * @brief Constructs a list containing the given @a items.
 */
 BList::BList(std::vector<value_type> items):
-	itemList(items) {}
+	BItem(ITEM_TYPE), itemList(std::move(items)) {}
 
 /**
 * @brief Creates and returns a new list.
@@ -37,22 +43,66 @@ std::shared_ptr<BList> BList::create() {
 * @brief Creates a returns a new list containing the given @a items.
 */
 std::shared_ptr<BList> BList::create(std::vector<value_type> items) {
-	return std::shared_ptr<BList>(new BList(items));
+	return std::shared_ptr<BList>(new BList(std::move(items)));
+}
+
+/**
+* @brief Creates and returns a new list containing integers with the given
+*        values in the packed form.
+*/
+std::shared_ptr<BList> BList::createPackedIntegers(
+		std::vector<BInteger::ValueType> integers) {
+	auto bList = create();
+	bList->itemStorage = Storage::PackedIntegers;
+	bList->integers = std::move(integers);
+	return bList;
 }
 
+/**
+* @brief Creates and returns a new list containing strings with the given
+*        contents in the packed form.
+*/
+std::shared_ptr<BList> BList::createPackedStrings(
+		std::vector<std::string> strings) {
+	auto bList = create();
+	bList->itemStorage = Storage::PackedStrings;
+	bList->strings = std::move(strings);
+	return bList;
+}
+
+/**
+* @brief Returns the items so that they can be modified.
+*
+* A packed list is converted.
+*
+* @throws FrozenItemError When the list is frozen.
+*/
 BList::BItemList &BList::value(){
+    checkNotFrozen();
+    unpack();
     return this->itemList;
 }
 
 void BList::clear() {
+    checkNotFrozen();
     itemList.clear();
+    integers.clear();
+    strings.clear();
+    itemStorage = Storage::Items;
 }
 
 /**
 * @brief Returns the number of items in the list.
 */
 BList::size_type BList::size() const {
-	return itemList.size();
+	switch (itemStorage) {
+		case Storage::PackedIntegers:
+			return integers.size();
+		case Storage::PackedStrings:
+			return strings.size();
+		default:
+			return itemList.size();
+	}
 }
 
 /**
@@ -61,7 +111,109 @@ BList::size_type BList::size() const {
 * @return @c true if the list is empty, @c false otherwise.
 */
 bool BList::empty() const {
-	return itemList.empty();
+	return size() == 0;
+}
+
+/**
+* @brief Returns the current representation of the items.
+*/
+BList::Storage BList::storage() const {
+	return itemStorage;
+}
+
+/**
+* @brief Returns the values of the integers in a list in the
+*        Storage::PackedIntegers form.
+*
+* @preconditions
+*  - storage() is Storage::PackedIntegers
+*/
+const std::vector<BInteger::ValueType> &BList::packedIntegers() const {
+	assert(itemStorage == Storage::PackedIntegers && "list is not packed");
+
+	return integers;
+}
+
+/**
+* @brief Returns the contents of the strings in a list in the
+*        Storage::PackedStrings form.
+*
+* @preconditions
+*  - storage() is Storage::PackedStrings
+*/
+const std::vector<std::string> &BList::packedStrings() const {
+	assert(itemStorage == Storage::PackedStrings && "list is not packed");
+
+	return strings;
+}
+
+/**
+* @brief Returns the value of the integer at @a idx.
+*
+* In contrast to <tt>(*list)[idx]->as<BInteger>()->value()</tt>, this does not
+* convert a packed list.
+*
+* @preconditions
+*  - @a idx < size()
+*  - the item at @a idx is an integer
+*/
+BInteger::ValueType BList::integerAt(size_type idx) const {
+	assert(idx < size() && "index out of range");
+
+	if (itemStorage == Storage::PackedIntegers) {
+		return integers[idx];
+	}
+	auto bInteger = itemList[idx]->asPtr<BInteger>();
+	assert(bInteger && "item is not an integer");
+	return bInteger->value();
+}
+
+/**
+* @brief Returns the contents of the string at @a idx.
+*
+* In contrast to <tt>(*list)[idx]->as<BString>()->value()</tt>, this does not
+* convert a packed list.
+*
+* @preconditions
+*  - @a idx < size()
+*  - the item at @a idx is a string
+*/
+const std::string &BList::stringAt(size_type idx) const {
+	assert(idx < size() && "index out of range");
+
+	if (itemStorage == Storage::PackedStrings) {
+		return strings[idx];
+	}
+	auto bString = itemList[idx]->asPtr<BString>();
+	assert(bString && "item is not a string");
+	return *bString->value();
+}
+
+/**
+* @brief Converts a packed list into the Storage::Items form.
+*
+* Does nothing when the list is already in that form. The references returned
+* by stringAt() are invalidated by the conversion.
+*/
+void BList::unpack() {
+	if (itemStorage == Storage::Items) {
+		return;
+	}
+
+	if (itemStorage == Storage::PackedIntegers) {
+		itemList.reserve(integers.size());
+		for (auto value : integers) {
+			itemList.push_back(BInteger::create(value));
+		}
+		std::vector<BInteger::ValueType>().swap(integers);
+	} else if (itemStorage == Storage::PackedStrings) {
+		itemList.reserve(strings.size());
+		for (auto &str : strings) {
+			itemList.push_back(BString::create(std::move(str)));
+		}
+		std::vector<std::string>().swap(strings);
+	}
+	itemStorage = Storage::Items;
 }
 
 /**
@@ -72,7 +224,9 @@ bool BList::empty() const {
 */
 void BList::push_back(const value_type &bItem) {
 	assert(bItem && "cannot add a null item to the list");
+	checkNotFrozen();
 
+	unpack();
 	itemList.push_back(bItem);
 }
 
@@ -86,8 +240,19 @@ void BList::push_back(const value_type &bItem) {
 */
 void BList::pop_back() {
 	assert(!empty() && "cannot call pop_back() on an empty list");
-
-	itemList.pop_back();
+	checkNotFrozen();
+
+	switch (itemStorage) {
+		case Storage::PackedIntegers:
+			integers.pop_back();
+			break;
+		case Storage::PackedStrings:
+			strings.pop_back();
+			break;
+		default:
+			itemList.pop_back();
+			break;
+	}
 }
 
 /**
@@ -95,23 +260,70 @@ void BList::pop_back() {
 *
 * @preconditions
 *  - list is non-empty
+*
+* @throws FrozenItemError When the list is frozen.
 */
 BList::reference BList::front() {
 	assert(!empty() && "cannot call front() on an empty list");
+	checkNotFrozen();
 
+	unpack();
 	return itemList.front();
 }
 
+/**
+* @brief Returns a reference to the item at @a idx.
+*
+* @preconditions
+*  - @a idx < size()
+*
+* @throws FrozenItemError When the list is frozen.
+*/
 BList::reference &BList::operator[](size_t idx) {
-    assert(itemList.size() > idx && idx >= 0  && "cannot call front() on an empty list");
+    assert(size() > idx && "index out of range");
+    checkNotFrozen();
 
+    unpack();
     return itemList[idx];
 }
 
+/**
+* @brief Returns the item at @a idx.
+*
+* A packed list is not converted; a new item is created from the packed value
+* instead.
+*
+* @preconditions
+*  - @a idx < size()
+*/
+BList::const_reference BList::operator[](size_t idx) const {
+    assert(size() > idx && "index out of range");
+
+    switch (itemStorage) {
+        case Storage::PackedIntegers:
+            return BInteger::create(integers[idx]);
+        case Storage::PackedStrings:
+            return BString::create(strings[idx]);
+        default:
+            return itemList[idx];
+    }
+}
+
 void BList::shuffle() {
+    checkNotFrozen();
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
     std::default_random_engine e(seed);
-    std::shuffle(itemList.begin(), itemList.end(), e);
+    switch (itemStorage) {
+        case Storage::PackedIntegers:
+            std::shuffle(integers.begin(), integers.end(), e);
+            break;
+        case Storage::PackedStrings:
+            std::shuffle(strings.begin(), strings.end(), e);
+            break;
+        default:
+            std::shuffle(itemList.begin(), itemList.end(), e);
+            break;
+    }
 }
 
 // BList &BList::extend(const BList &list_b) {
@@ -121,56 +333,142 @@ void BList::shuffle() {
 // }
 
 void BList::extend(BListPtr list_b) {
-    this->itemList.reserve(this->size() + std::distance(list_b->begin(), list_b->end()));
-    this->itemList.insert(this->end(), list_b->begin(), list_b->end());
+    checkNotFrozen();
+    unpack();
+    // Read through a constant reference, so @a list_b may be frozen.
+    const BList &other = *list_b;
+    this->itemList.reserve(this->size() + other.size());
+    this->itemList.insert(this->itemList.end(), other.begin(), other.end());
 }
 
 void BList::range_erase(int s_idx) {
     this->range_erase(s_idx, this->size());
 }
 
+/**
+* @brief Removes the items with indexes in [@a s_idx, @a e_idx).
+*
+* Negative indexes are counted from the end of the list. The items following
+* the erased range are moved only once, so the erasure takes linear time in the
+* size of the list (regardless of the number of erased items).
+*/
 void BList::range_erase(int s_idx, int e_idx) {
-    if (this->size() == 0) {
-        return ;
-    }
-
-    if (s_idx < 0) {
-        s_idx = this->size() + s_idx;
-    }
-    if (e_idx < 0) {
-        e_idx = this->size() + e_idx;
-    }
-
-    int count = e_idx - s_idx;
-
-    for (int i = 0; i < count; i++)
-        this->itemList.erase(this->itemList.begin() + s_idx);
+	checkNotFrozen();
+
+	normalizeRange(s_idx, e_idx);
+	if (s_idx >= e_idx) {
+		return;
+	}
+
+	switch (itemStorage) {
+		case Storage::PackedIntegers:
+			integers.erase(integers.begin() + s_idx, integers.begin() + e_idx);
+			break;
+		case Storage::PackedStrings:
+			strings.erase(strings.begin() + s_idx, strings.begin() + e_idx);
+			break;
+		default:
+			itemList.erase(itemList.begin() + s_idx, itemList.begin() + e_idx);
+			break;
+	}
 }
 
 std::shared_ptr<BList> BList::range(int s_idx) {
     return this->range(s_idx, this->size());
 }
 std::shared_ptr<BList> BList::range(int s_idx, int e_idx) {
-    if (this->size() == 0) {
-        return BList::create();
-    }
+    return slice(s_idx, e_idx).toList();
+}
 
-    if (s_idx < 0) {
-        s_idx = this->size() + s_idx;
-    }
-    if (e_idx < 0) {
-        e_idx = this->size() + e_idx;
-    }
+/**
+* @brief Returns a view of the items from @a s_idx up to the end of the list.
+*
+* See slice(int, int) for more details.
+*/
+BListSlice BList::slice(int s_idx) const {
+	return slice(s_idx, static_cast<int>(size()));
+}
+
+/**
+* @brief Returns a view of the items with indexes in [@a s_idx, @a e_idx).
+*
+* Negative indexes are counted from the end of the list. In contrast to
+* range(), nothing is copied (not even for a packed list, which is not
+* converted), so the slice is valid only until the list is modified.
+*/
+BListSlice BList::slice(int s_idx, int e_idx) const {
+	normalizeRange(s_idx, e_idx);
+	if (s_idx >= e_idx) {
+		return BListSlice();
+	}
+
+	// A packed list is not converted; the slice reads the packed values.
+	return BListSlice(begin() + s_idx, begin() + e_idx);
+}
+
+/**
+* @brief Converts negative indexes of a range to non-negative ones.
+*
+* @preconditions
+*  - both indexes are in [-size(), size()]
+*/
+void BList::normalizeRange(int &s_idx, int &e_idx) const {
+	int numOfItems = static_cast<int>(size());
+	if (s_idx < 0) {
+		s_idx += numOfItems;
+	}
+	if (e_idx < 0) {
+		e_idx += numOfItems;
+	}
+
+	assert(s_idx >= 0 && s_idx <= numOfItems && "start index out of range");
+	assert(e_idx >= 0 && e_idx <= numOfItems && "end index out of range");
+}
 
-    assert(s_idx <= static_cast<int>(this->size()));
-    assert(s_idx <= e_idx);
+/**
+* @brief Inserts @a bItem before @a pos.
+*
+* @return Iterator to the inserted item.
+*
+* @preconditions
+*  - @a bItem is non-null
+*/
+BList::iterator BList::insert(iterator pos, const value_type &bItem) {
+	assert(bItem && "cannot add a null item to the list");
+	checkNotFrozen();
+
+	return itemList.insert(pos, bItem);
+}
+
+/**
+* @brief Removes the item at @a pos.
+*
+* @return Iterator following the removed item.
+*/
+BList::iterator BList::erase(iterator pos) {
+	checkNotFrozen();
+
+	return itemList.erase(pos);
+}
+
+/**
+* @brief Removes the items in [@a first, @a last).
+*
+* The items following the range are moved only once, so the erasure takes
+* linear time in the size of the list.
+*
+* @return Iterator following the last removed item.
+*/
+BList::iterator BList::erase(iterator first, iterator last) {
+	checkNotFrozen();
 
-    auto newList = BList::create(std::vector<value_type>(this->begin() + s_idx, this->begin() + e_idx));
-    return newList;
+	return itemList.erase(first, last);
 }
 
 /**
-* @brief Returns a constant reference to the first item in the list.
+* @brief Returns the first item in the list.
+*
+* See operator[]() const for more details.
 *
 * @preconditions
 *  - list is non-empty
@@ -178,7 +476,7 @@ std::shared_ptr<BList> BList::range(int s_idx, int e_idx) {
 BList::const_reference BList::front() const {
 	assert(!empty() && "cannot call front() on an empty list");
 
-	return itemList.front();
+	return (*this)[0];
 }
 
 /**
@@ -186,15 +484,21 @@ BList::const_reference BList::front() const {
 *
 * @preconditions
 *  - list is non-empty
+*
+* @throws FrozenItemError When the list is frozen.
 */
 BList::reference BList::back() {
 	assert(!empty() && "cannot call back() on an empty list");
+	checkNotFrozen();
 
+	unpack();
 	return itemList.back();
 }
 
 /**
-* @brief Returns a constant reference to the last item in the list.
+* @brief Returns the last item in the list.
+*
+* See operator[]() const for more details.
 *
 * @preconditions
 *  - list is non-empty
@@ -202,20 +506,28 @@ BList::reference BList::back() {
 BList::const_reference BList::back() const {
 	assert(!empty() && "cannot call back() on an empty list");
 
-	return itemList.back();
+	return (*this)[size() - 1];
 }
 
 /**
 * @brief Returns an iterator to the beginning of the list.
+*
+* @throws FrozenItemError When the list is frozen.
 */
 BList::iterator BList::begin() {
+	checkNotFrozen();
+	unpack();
 	return itemList.begin();
 }
 
 /**
 * @brief Returns an iterator to the end of the list.
+*
+* @throws FrozenItemError When the list is frozen.
 */
 BList::iterator BList::end() {
+	checkNotFrozen();
+	unpack();
 	return itemList.end();
 }
 
@@ -223,28 +535,104 @@ BList::iterator BList::end() {
 * @brief Returns a constant iterator to the beginning of the list.
 */
 BList::const_iterator BList::begin() const {
-	return itemList.begin();
+	return const_iterator(this, 0);
 }
 
 /**
 * @brief Returns a constant iterator to the end of the list.
 */
 BList::const_iterator BList::end() const {
-	return itemList.end();
+	return const_iterator(this, size());
 }
 
 /**
 * @brief Returns a constant iterator to the beginning of the list.
 */
 BList::const_iterator BList::cbegin() const {
-	return itemList.cbegin();
+	return begin();
 }
 
 /**
 * @brief Returns a constant iterator to the end of the list.
 */
 BList::const_iterator BList::cend() const {
-	return itemList.cend();
+	return end();
+}
+
+/**
+* @brief Returns a new, unfrozen list with the same items.
+*
+* The items are shared with this list (see BItem::clone()). A packed list is
+* copied in the packed form.
+*/
+std::shared_ptr<BList> BList::clone() const {
+	auto copy = create();
+	copy->itemStorage = itemStorage;
+	copy->itemList = itemList;
+	copy->integers = integers;
+	copy->strings = strings;
+	return copy;
+}
+
+std::shared_ptr<BItem> BList::cloneItem() const {
+	return clone();
+}
+
+/**
+* @brief Makes the list and all its items immutable.
+*
+* A packed list is converted into the Storage::Items form, so that its items
+* can be frozen and the @c const functions return the same items on every
+* call. See BItem::freeze() for more details.
+*/
+void BList::freeze() {
+	if (isFrozen()) {
+		return;
+	}
+
+	unpack();
+	markAsFrozen();
+	for (auto &item : itemList) {
+		item->freeze();
+	}
+}
+
+/**
+* @brief Returns the item at @a idx so that it can be modified.
+*
+* When the item is frozen (e.g. because the list is a clone of a frozen list),
+* it is replaced with its clone first, so the other lists sharing the item are
+* not affected.
+*
+* @preconditions
+*  - <tt>idx < size()</tt>
+*
+* @throws FrozenItemError When the list is frozen.
+*/
+BList::value_type BList::unfrozenItem(size_type idx) {
+	checkNotFrozen();
+	assert(idx < size() && "index out of range");
+
+	unpack();
+	auto &item = itemList[idx];
+	if (item->isFrozen()) {
+		item = item->clone();
+	}
+	return item;
+}
+
+/**
+* @brief Returns the item at @a idx without checking that the list is not
+*        frozen.
+*
+* A packed list is converted (a frozen list is never packed), so that the item
+* outlives the call.
+*/
+const BList::value_type &BList::unpackedItem(size_type idx) {
+	assert(idx < size() && "index out of range");
+
+	unpack();
+	return itemList[idx];
 }
 
 void BList::accept(BItemVisitor *visitor) {
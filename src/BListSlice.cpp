@@ -0,0 +1,100 @@
+/**
+* @file      BListSlice.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the BListSlice class.
+*/
+
+#include "BListSlice.h"
+
+#include <cassert>
+#include <vector>
+
+namespace bencoding {
+
+/**
+* @brief Constructs an empty slice.
+*/
+BListSlice::BListSlice() = default;
+
+/**
+* @brief Constructs a slice of items in [@a first, @a last).
+*/
+BListSlice::BListSlice(const_iterator first, const_iterator last):
+	first(first), last(last) {}
+
+/**
+* @brief Returns the number of items in the slice.
+*/
+BListSlice::size_type BListSlice::size() const {
+	return last - first;
+}
+
+/**
+* @brief Checks if the slice is empty.
+*/
+bool BListSlice::empty() const {
+	return first == last;
+}
+
+/**
+* @brief Returns a constant reference to the item at @a idx (relative to the
+*        beginning of the slice).
+*
+* @preconditions
+*  - @a idx < size()
+*/
+BListSlice::const_reference BListSlice::operator[](size_type idx) const {
+	assert(idx < size() && "index out of range");
+
+	return first[idx];
+}
+
+/**
+* @brief Returns a constant reference to the first item in the slice.
+*
+* @preconditions
+*  - slice is non-empty
+*/
+BListSlice::const_reference BListSlice::front() const {
+	assert(!empty() && "cannot call front() on an empty slice");
+
+	return *first;
+}
+
+/**
+* @brief Returns a constant reference to the last item in the slice.
+*
+* @preconditions
+*  - slice is non-empty
+*/
+BListSlice::const_reference BListSlice::back() const {
+	assert(!empty() && "cannot call back() on an empty slice");
+
+	return *(last - 1);
+}
+
+/**
+* @brief Returns a constant iterator to the beginning of the slice.
+*/
+BListSlice::const_iterator BListSlice::begin() const {
+	return first;
+}
+
+/**
+* @brief Returns a constant iterator to the end of the slice.
+*/
+BListSlice::const_iterator BListSlice::end() const {
+	return last;
+}
+
+/**
+* @brief Creates a new list containing the items from the slice.
+*
+* The items themselves are shared, not copied.
+*/
+std::shared_ptr<BList> BListSlice::toList() const {
+	return BList::create(std::vector<value_type>(first, last));
+}
+
+} // namespace bencoding
@@ -7,17 +7,21 @@
 
 #include "BString.h"
 
+#include <utility>
+
 #include "BItemVisitor.h"
 
 namespace bencoding {
 
+const BItem::Type BString::ITEM_TYPE;
+
 /**
 * @brief Constructs the string with the given @a value.
 */
-BString::BString(ValueType value): _value(value) {}
+BString::BString(ValueType value): BItem(ITEM_TYPE), _value(value) {}
 
-BString::BString(std::string value) {
-    _value = std::shared_ptr<std::string>(new std::string(value));
+BString::BString(std::string value): BItem(ITEM_TYPE) {
+    _value = std::shared_ptr<std::string>(new std::string(std::move(value)));
 }
 
 /**
@@ -28,7 +32,7 @@ std::shared_ptr<BString> BString::create(ValueType value) {
 }
 
 std::shared_ptr<BString> BString::create(std::string value) {
-    return std::shared_ptr<BString>(new BString(value));
+    return std::shared_ptr<BString>(new BString(std::move(value)));
 }
 
 /**
@@ -42,10 +46,14 @@ auto BString::value() const -> ValueType {
 * @brief Sets a new value.
 */
 void BString::setValue(ValueType value) {
+	checkNotFrozen();
+
 	_value = value;
 }
 
 void BString::setValue(std::string value) {
+    checkNotFrozen();
+
     _value = std::shared_ptr<std::string>(new std::string(value));
 }
 
@@ -56,6 +64,21 @@ int64_t BString::length() const{
 	return _value->length();
 }
 
+/**
+* @brief Returns a new, unfrozen string with a copy of the value of this
+*        string.
+*
+* The value is copied because value() gives mutable access to it, so
+* modifying the value of the clone does not affect this string.
+*/
+std::shared_ptr<BString> BString::clone() const {
+	return create(*_value);
+}
+
+std::shared_ptr<BItem> BString::cloneItem() const {
+	return clone();
+}
+
 void BString::accept(BItemVisitor *visitor) {
 	visitor->visit(this);
 }
@@ -0,0 +1,792 @@
+/**
+* @file      BinaryCache.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the binary cache of decoded data.
+*/
+
+#include "BinaryCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Decoder.h"
+#include "Utils.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BENCODING_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bencoding {
+
+namespace {
+
+//
+// Layout of the cache (all numbers are in little endian):
+//
+//  - header: magic (4 bytes), version (uint32), offset of the root (uint32)
+//  - integer: 'i', value (int64)
+//  - string: 's', length (uint32), bytes
+//  - list: 'l', number of items (uint32), offsets of the items (uint32 each)
+//  - dictionary: 'd', number of items (uint32), offsets of the keys and the
+//    values (pairs of uint32, sorted by the keys); keys are strings
+//
+// Items are stored before the containers they are in, so every offset in a
+// container is lower than the offset of the container. This guarantees that
+// a corrupted cache cannot contain cycles.
+//
+
+/// Magic bytes at the beginning of a cache.
+const char MAGIC[] = {'B', 'N', 'C', 'C'};
+
+/// Version of the layout.
+const std::uint32_t VERSION = 1;
+
+/// Size of the header.
+const std::size_t HEADER_SIZE = 12;
+
+/// Offset of the root offset in the header.
+const std::size_t ROOT_OFFSET_OFFSET = 8;
+
+/// Size of a type and a count (or a length) before the contents of an item.
+const std::size_t ITEM_PREFIX_SIZE = 5;
+
+/// Maximal ratio of the size of bencoded data to the size of their cache.
+// Items are not shared in a cache, and the bencoded form of every item
+// (e.g. 22 bytes of the smallest integer) is at most twice as large as the
+// item with its offset (9 + 4 bytes).
+const std::size_t MAX_BENCODE_SIZE_RATIO = 2;
+
+/**
+* @brief Throws DecodingError reporting a corrupted cache.
+*/
+void throwCorruptedCache() {
+	throw DecodingError("binary cache is corrupted");
+}
+
+/**
+* @brief Reads a little-endian number of @a size bytes at @a data.
+*/
+std::uint64_t readLittleEndian(const char *data, std::size_t size) {
+	std::uint64_t value = 0;
+	for (std::size_t i = size; i > 0; --i) {
+		value = value << 8 | static_cast<unsigned char>(data[i - 1]);
+	}
+	return value;
+}
+
+/**
+* @brief Appends @a value in little endian as @a size bytes to @a image.
+*/
+void appendLittleEndian(std::string &image, std::uint64_t value,
+		std::size_t size) {
+	for (std::size_t i = 0; i < size; ++i) {
+		image += static_cast<char>(value >> (8 * i));
+	}
+}
+
+/**
+* @brief Stores @a value in little endian as four bytes at @a offset of
+*        @a image.
+*/
+void storeUint32(std::string &image, std::size_t offset, std::uint32_t value) {
+	for (std::size_t i = 0; i < 4; ++i) {
+		image[offset + i] = static_cast<char>(value >> (8 * i));
+	}
+}
+
+/**
+* @brief Returns the offset at which the next item is appended to @a image.
+*
+* @throws DecodingError When the offset does not fit into 32 bits.
+*/
+std::uint32_t nextOffset(const std::string &image) {
+	if (image.size() > std::numeric_limits<std::uint32_t>::max()) {
+		throw DecodingError("data are too large for a binary cache");
+	}
+	return static_cast<std::uint32_t>(image.size());
+}
+
+/**
+* @brief Appends @a str to @a image and returns its offset.
+*/
+std::uint32_t appendString(std::string &image, const StringRef &str) {
+	if (str.size() > std::numeric_limits<std::uint32_t>::max()) {
+		throw DecodingError("data are too large for a binary cache");
+	}
+	std::uint32_t offset = nextOffset(image);
+	image += 's';
+	appendLittleEndian(image, str.size(), 4);
+	image.append(str.data(), str.size());
+	return offset;
+}
+
+/**
+* @brief Returns the string stored at @a offset of @a image (when creating
+*        the cache).
+*/
+StringRef storedString(const std::string &image, std::uint32_t offset) {
+	return StringRef(image.data() + offset + ITEM_PREFIX_SIZE,
+		readLittleEndian(image.data() + offset + 1, 4));
+}
+
+/**
+* @brief Appends a dictionary with the keys and values stored at
+*        @a offsets to @a image and returns its offset.
+*
+* @a offsets contain pairs of offsets of keys and values. When the keys are
+* not sorted, the pairs are sorted.
+*
+* @throws DecodingError When there are duplicate keys.
+*/
+std::uint32_t appendDictionary(std::string &image,
+		std::vector<std::uint32_t>::iterator first,
+		std::vector<std::uint32_t>::iterator last) {
+	using Entry = std::pair<std::uint32_t, std::uint32_t>;
+	std::vector<Entry> entries;
+	for (auto i = first; i != last; i += 2) {
+		entries.emplace_back(*i, *(i + 1));
+	}
+	auto keyLess = [&image](const Entry &lhs, const Entry &rhs) {
+		return storedString(image, lhs.first) < storedString(image, rhs.first);
+	};
+	if (!std::is_sorted(entries.begin(), entries.end(), keyLess)) {
+		std::sort(entries.begin(), entries.end(), keyLess);
+	}
+	for (std::size_t i = 1; i < entries.size(); ++i) {
+		if (!keyLess(entries[i - 1], entries[i])) {
+			throw DecodingError("duplicate key: \"" +
+				storedString(image, entries[i].first).str() + "\"");
+		}
+	}
+
+	std::uint32_t offset = nextOffset(image);
+	image += 'd';
+	appendLittleEndian(image, entries.size(), 4);
+	for (const auto &entry : entries) {
+		appendLittleEndian(image, entry.first, 4);
+		appendLittleEndian(image, entry.second, 4);
+	}
+	return offset;
+}
+
+/**
+* @brief Appender of the parts of bencoded data reported by Scanner::walk()
+*        into a binary cache.
+*
+* Items are appended after they have been scanned, so containers are
+* appended after their items. The offsets of the items of the open
+* containers are kept until the containers are closed.
+*/
+class BinaryCacheWalkHandler {
+public:
+	explicit BinaryCacheWalkHandler(std::string &image);
+
+	void startDictionary();
+	void startList();
+	void endContainer(bool isDictionary);
+	void key(const StringRef &key);
+	void integer(std::int64_t value);
+	void string(const StringRef &value);
+	void separator();
+
+	std::uint32_t rootOffset() const;
+
+private:
+	/// Image of the cache.
+	std::string &image;
+
+	/// Offsets of the appended items that are not in a container yet.
+	std::vector<std::uint32_t> offsets;
+
+	/// Indexes into @c offsets of the first items of the open containers.
+	std::vector<std::size_t> firstItems;
+};
+
+BinaryCacheWalkHandler::BinaryCacheWalkHandler(std::string &image):
+	image(image) {}
+
+/**
+* @brief Starts collecting the items of a dictionary.
+*/
+void BinaryCacheWalkHandler::startDictionary() {
+	firstItems.push_back(offsets.size());
+}
+
+/**
+* @brief Starts collecting the items of a list.
+*/
+void BinaryCacheWalkHandler::startList() {
+	firstItems.push_back(offsets.size());
+}
+
+/**
+* @brief Appends the container whose items have been collected.
+*/
+void BinaryCacheWalkHandler::endContainer(bool isDictionary) {
+	auto first = offsets.begin() + firstItems.back();
+	std::uint32_t offset;
+	if (isDictionary) {
+		offset = appendDictionary(image, first, offsets.end());
+	} else {
+		offset = nextOffset(image);
+		image += 'l';
+		appendLittleEndian(image, offsets.end() - first, 4);
+		for (auto i = first; i != offsets.end(); ++i) {
+			appendLittleEndian(image, *i, 4);
+		}
+	}
+	offsets.erase(first, offsets.end());
+	offsets.push_back(offset);
+	firstItems.pop_back();
+}
+
+/**
+* @brief Appends a key of a dictionary.
+*/
+void BinaryCacheWalkHandler::key(const StringRef &key) {
+	offsets.push_back(appendString(image, key));
+}
+
+/**
+* @brief Appends an integer.
+*/
+void BinaryCacheWalkHandler::integer(std::int64_t value) {
+	offsets.push_back(nextOffset(image));
+	image += 'i';
+	appendLittleEndian(image, static_cast<std::uint64_t>(value), 8);
+}
+
+/**
+* @brief Appends a string.
+*/
+void BinaryCacheWalkHandler::string(const StringRef &value) {
+	offsets.push_back(appendString(image, value));
+}
+
+/**
+* @brief Does nothing (items are separated by their offsets).
+*/
+void BinaryCacheWalkHandler::separator() {}
+
+/**
+* @brief Returns the offset of the root item (after the whole item has been
+*        reported).
+*/
+std::uint32_t BinaryCacheWalkHandler::rootOffset() const {
+	return offsets.back();
+}
+
+/**
+* @brief Checks that @a data can grow by @a size bytes without exceeding
+*        @a maxSize.
+*/
+void checkOutputSize(const std::string &data, std::size_t size,
+		std::size_t maxSize) {
+	if (size > maxSize || data.size() > maxSize - size) {
+		throwCorruptedCache();
+	}
+}
+
+/**
+* @brief Appends the bencoded form of @a str to @a data.
+*/
+void appendBencodedString(std::string &data, const StringRef &str,
+		std::size_t maxSize) {
+	checkOutputSize(data, MAX_ENCODED_STRING_HEADER_LENGTH + str.size(),
+		maxSize);
+	appendEncodedStringHeader(data, str.size());
+	data.append(str.data(), str.size());
+}
+
+} // anonymous namespace
+
+/**
+* @brief Constructs a null item.
+*/
+CachedItem::CachedItem(): image(nullptr), imageSize(0), offset(0) {}
+
+/**
+* @brief Constructs an item stored at @a offset of @a image.
+*
+* @throws DecodingError When there is no valid item at @a offset.
+*/
+CachedItem::CachedItem(const char *image, std::size_t imageSize,
+		std::size_t offset): image(image), imageSize(imageSize), offset(offset) {
+	checkAvailable(offset, 1);
+	char type = image[offset];
+	if (type == 'i') {
+		checkAvailable(offset + 1, 8);
+	} else if (type == 's') {
+		checkAvailable(offset + ITEM_PREFIX_SIZE, readUint32(offset + 1));
+	} else if (type == 'l') {
+		checkAvailable(offset + ITEM_PREFIX_SIZE,
+			4 * static_cast<std::size_t>(readUint32(offset + 1)));
+	} else if (type == 'd') {
+		checkAvailable(offset + ITEM_PREFIX_SIZE,
+			8 * static_cast<std::size_t>(readUint32(offset + 1)));
+	} else {
+		throwCorruptedCache();
+	}
+}
+
+/**
+* @brief Returns @c true if the item is not null, @c false otherwise.
+*/
+CachedItem::operator bool() const {
+	return image != nullptr;
+}
+
+/**
+* @brief Returns the type of the item.
+*
+* @par Preconditions
+*  - the item is not null
+*/
+CachedItem::Type CachedItem::type() const {
+	switch (image[offset]) {
+		case 'i': return Type::Integer;
+		case 's': return Type::String;
+		case 'l': return Type::List;
+		default: return Type::Dictionary;
+	}
+}
+
+/**
+* @brief Returns @c true if the item is an integer, @c false otherwise.
+*/
+bool CachedItem::isInteger() const {
+	return image && image[offset] == 'i';
+}
+
+/**
+* @brief Returns @c true if the item is a string, @c false otherwise.
+*/
+bool CachedItem::isString() const {
+	return image && image[offset] == 's';
+}
+
+/**
+* @brief Returns @c true if the item is a list, @c false otherwise.
+*/
+bool CachedItem::isList() const {
+	return image && image[offset] == 'l';
+}
+
+/**
+* @brief Returns @c true if the item is a dictionary, @c false otherwise.
+*/
+bool CachedItem::isDictionary() const {
+	return image && image[offset] == 'd';
+}
+
+/**
+* @brief Returns the value of the integer, or @c 0 if the item is not an
+*        integer.
+*/
+std::int64_t CachedItem::integerValue() const {
+	if (!isInteger()) {
+		return 0;
+	}
+	return static_cast<std::int64_t>(readLittleEndian(image + offset + 1, 8));
+}
+
+/**
+* @brief Returns the bytes of the string, or an empty reference if the item
+*        is not a string.
+*
+* The returned reference points into the cache.
+*/
+StringRef CachedItem::stringValue() const {
+	if (!isString()) {
+		return StringRef();
+	}
+	return StringRef(image + offset + ITEM_PREFIX_SIZE,
+		readUint32(offset + 1));
+}
+
+/**
+* @brief Returns the number of items in the list or dictionary, or @c 0 if
+*        the item is not a container.
+*/
+std::size_t CachedItem::size() const {
+	if (!isList() && !isDictionary()) {
+		return 0;
+	}
+	return readUint32(offset + 1);
+}
+
+/**
+* @brief Returns @c true if the item is not a container or it is an empty
+*        one, @c false otherwise.
+*/
+bool CachedItem::empty() const {
+	return size() == 0;
+}
+
+/**
+* @brief Returns the item of the list with the given @a index.
+*
+* @par Preconditions
+*  - the item is a list
+*
+* @throws DecodingError When <tt>index >= size()</tt>.
+*/
+CachedItem CachedItem::operator[](std::size_t index) const {
+	checkIndex(index);
+	return uncheckedItem(index);
+}
+
+/**
+* @brief Returns the key of the dictionary with the given @a index.
+*
+* The keys are sorted. The returned reference points into the cache.
+*
+* @par Preconditions
+*  - the item is a dictionary
+*
+* @throws DecodingError When <tt>index >= size()</tt>.
+*/
+StringRef CachedItem::keyAt(std::size_t index) const {
+	checkIndex(index);
+	return uncheckedKey(index);
+}
+
+/**
+* @brief Returns the value of the dictionary with the given @a index.
+*
+* @par Preconditions
+*  - the item is a dictionary
+*
+* @throws DecodingError When <tt>index >= size()</tt>.
+*/
+CachedItem CachedItem::valueAt(std::size_t index) const {
+	checkIndex(index);
+	return uncheckedValue(index);
+}
+
+/**
+* @brief Returns the value of the dictionary with the given @a key, or a
+*        null item if there is no such key or the item is not a dictionary.
+*
+* The key directory is searched by a binary search.
+*/
+CachedItem CachedItem::find(const StringRef &key) const {
+	if (!isDictionary()) {
+		return CachedItem();
+	}
+	std::size_t first = 0;
+	std::size_t last = size();
+	while (first < last) {
+		std::size_t middle = first + (last - first) / 2;
+		int order = uncheckedKey(middle).compare(key);
+		if (order == 0) {
+			return uncheckedValue(middle);
+		} else if (order < 0) {
+			first = middle + 1;
+		} else {
+			last = middle;
+		}
+	}
+	return CachedItem();
+}
+
+/**
+* @brief Throws DecodingError when @a index is not an index of an item of
+*        the container.
+*
+* Without the check, a table entry past the end of the container would be
+* read as an offset.
+*/
+void CachedItem::checkIndex(std::size_t index) const {
+	if (index >= size()) {
+		throw DecodingError("index " + std::to_string(index) +
+			" is out of range");
+	}
+}
+
+/**
+* @brief Returns the item of the list with the given @a index, which has to
+*        be lower than size().
+*/
+CachedItem CachedItem::uncheckedItem(std::size_t index) const {
+	return itemAt(offset + ITEM_PREFIX_SIZE + 4 * index);
+}
+
+/**
+* @brief Returns the key of the dictionary with the given @a index, which has
+*        to be lower than size().
+*/
+StringRef CachedItem::uncheckedKey(std::size_t index) const {
+	CachedItem key(itemAt(offset + ITEM_PREFIX_SIZE + 8 * index));
+	if (!key.isString()) {
+		throwCorruptedCache();
+	}
+	return key.stringValue();
+}
+
+/**
+* @brief Returns the value of the dictionary with the given @a index, which
+*        has to be lower than size().
+*/
+CachedItem CachedItem::uncheckedValue(std::size_t index) const {
+	return itemAt(offset + ITEM_PREFIX_SIZE + 8 * index + 4);
+}
+
+/**
+* @brief Returns the item whose offset is stored at @a tableOffset.
+*
+* @throws DecodingError When the offset is not lower than the offset of this
+*         item (which would allow cycles).
+*/
+CachedItem CachedItem::itemAt(std::size_t tableOffset) const {
+	std::size_t itemOffset = readUint32(tableOffset);
+	if (itemOffset < HEADER_SIZE || itemOffset >= offset) {
+		throwCorruptedCache();
+	}
+	return CachedItem(image, imageSize, itemOffset);
+}
+
+/**
+* @brief Reads a 32-bit number at the given @a offset of the cache.
+*/
+std::uint32_t CachedItem::readUint32(std::size_t offset) const {
+	checkAvailable(offset, 4);
+	return static_cast<std::uint32_t>(readLittleEndian(image + offset, 4));
+}
+
+/**
+* @brief Checks that there are @a size bytes at @a offset of the cache.
+*/
+void CachedItem::checkAvailable(std::size_t offset, std::size_t size) const {
+	if (offset > imageSize || size > imageSize - offset) {
+		throwCorruptedCache();
+	}
+}
+
+/**
+* @brief Constructs a view of the cache of @a size bytes starting at
+*        @a data.
+*
+* The cache is not copied, so it has to outlive the view and all the items
+* obtained from it.
+*
+* @throws DecodingError When @a data are not a binary cache.
+*/
+BinaryCache::BinaryCache(const char *data, std::size_t size):
+		data(data), size(size), rootOffset(0) {
+	if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+		throw DecodingError("data are not a binary cache");
+	} else if (readLittleEndian(data + sizeof(MAGIC), 4) != VERSION) {
+		throw DecodingError("unsupported version of a binary cache");
+	}
+	rootOffset = readLittleEndian(data + ROOT_OFFSET_OFFSET, 4);
+	if (rootOffset < HEADER_SIZE) {
+		throwCorruptedCache();
+	}
+}
+
+/**
+* @brief Constructs a view of the cache in @a data.
+*
+* See BinaryCache(const char *, std::size_t) for more details.
+*/
+BinaryCache::BinaryCache(const std::string &data):
+	BinaryCache(data.data(), data.size()) {}
+
+/**
+* @brief Returns the root item.
+*/
+CachedItem BinaryCache::root() const {
+	return CachedItem(data, size, rootOffset);
+}
+
+/**
+* @brief Maps the cache stored in the file at @a path into memory.
+*
+* @throws std::runtime_error When the file cannot be read.
+* @throws DecodingError When the file is not a binary cache.
+*/
+MappedBinaryCache::MappedBinaryCache(const std::string &path):
+		data(nullptr), size(0), mapped(false), readData() {
+#ifdef BENCODING_HAVE_MMAP
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("cannot open " + path);
+	}
+	struct stat fileStatus;
+	if (fstat(fd, &fileStatus) == 0 && fileStatus.st_size > 0) {
+		size = static_cast<std::size_t>(fileStatus.st_size);
+		void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address != MAP_FAILED) {
+			data = static_cast<const char *>(address);
+			mapped = true;
+		}
+	}
+	close(fd);
+#endif
+	if (!mapped) {
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("cannot open " + path);
+		}
+		readData.assign(std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+		data = readData.data();
+		size = readData.size();
+	}
+
+	try {
+		// Check the header.
+		BinaryCache(data, size);
+	} catch (...) {
+#ifdef BENCODING_HAVE_MMAP
+		if (mapped) {
+			munmap(const_cast<char *>(data), size);
+		}
+#endif
+		throw;
+	}
+}
+
+/**
+* @brief Unmaps the file.
+*/
+MappedBinaryCache::~MappedBinaryCache() {
+#ifdef BENCODING_HAVE_MMAP
+	if (mapped) {
+		munmap(const_cast<char *>(data), size);
+		mapped = false;
+	}
+#endif
+}
+
+/**
+* @brief Returns the root item.
+*
+* Items are valid only while the cache exists.
+*/
+CachedItem MappedBinaryCache::root() const {
+	return BinaryCache(data, size).root();
+}
+
+/**
+* @brief Creates a binary cache of @a size bytes of bencoded data starting
+*        at @a data.
+*
+* The data are scanned without creating any BItem. Keys of dictionaries are
+* sorted if they are not sorted in the data.
+*
+* @throws DecodingError When the data are malformed, there are characters
+*         after them, a dictionary contains duplicate keys, or the cache
+*         would be larger than 4 GiB.
+*/
+std::string bencodeToBinaryCache(const char *data, std::size_t size) {
+	std::string image(MAGIC, sizeof(MAGIC));
+	appendLittleEndian(image, VERSION, 4);
+	appendLittleEndian(image, 0, 4);
+
+	Scanner scanner(data, size);
+	BinaryCacheWalkHandler handler(image);
+	scanner.walk(handler);
+	storeUint32(image, ROOT_OFFSET_OFFSET, handler.rootOffset());
+	return image;
+}
+
+/**
+* @brief Creates a binary cache of bencoded @a data.
+*
+* See bencodeToBinaryCache(const char *, std::size_t) for more details.
+*/
+std::string bencodeToBinaryCache(const std::string &data) {
+	return bencodeToBinaryCache(data.data(), data.size());
+}
+
+/**
+* @brief Returns the bencoded form of @a item stored in a binary cache.
+*
+* The bencoded form of a cache created by bencodeToBinaryCache() is at most
+* @c MAX_BENCODE_SIZE_RATIO times larger than the cache. A larger one can
+* only be produced by a corrupted cache whose containers share items (e.g.
+* 40 nested lists, each containing the next one twice, would expand into
+* 2^40 items), so it is rejected.
+*
+* @par Preconditions
+*  - @a item is not null
+*
+* @throws DecodingError When the cache is corrupted.
+*/
+std::string binaryCacheToBencode(const CachedItem &item) {
+	/// Open container and the index of its next item.
+	struct OpenContainer {
+		CachedItem container;
+		bool isDictionary;
+		std::size_t size;
+		std::size_t next;
+	};
+
+	// The containers are walked with an explicit stack, so deeply nested
+	// caches do not exhaust the call stack.
+	std::string data;
+	const std::size_t maxSize = MAX_BENCODE_SIZE_RATIO * item.imageSize;
+	std::vector<OpenContainer> openContainers;
+	CachedItem current(item);
+	for (;;) {
+		// Append an item (or the beginning of a container).
+		switch (current.type()) {
+			case CachedItem::Type::Integer:
+				checkOutputSize(data, MAX_ENCODED_INTEGER_LENGTH, maxSize);
+				appendEncodedInteger(data, current.integerValue());
+				break;
+			case CachedItem::Type::String:
+				appendBencodedString(data, current.stringValue(), maxSize);
+				break;
+			case CachedItem::Type::List:
+				checkOutputSize(data, 2, maxSize);
+				data += 'l';
+				openContainers.push_back(
+					OpenContainer{current, false, current.size(), 0});
+				break;
+			default:
+				checkOutputSize(data, 2, maxSize);
+				data += 'd';
+				openContainers.push_back(
+					OpenContainer{current, true, current.size(), 0});
+				break;
+		}
+
+		// Close finished containers and move to the next item.
+		for (;;) {
+			if (openContainers.empty()) {
+				return data;
+			}
+			OpenContainer &open = openContainers.back();
+			if (open.next == open.size) {
+				data += 'e';
+				openContainers.pop_back();
+				continue;
+			}
+			std::size_t index = open.next++;
+			if (open.isDictionary) {
+				appendBencodedString(data, open.container.uncheckedKey(index),
+					maxSize);
+				current = open.container.uncheckedValue(index);
+			} else {
+				current = open.container.uncheckedItem(index);
+			}
+			break;
+		}
+	}
+}
+
+} // namespace bencoding
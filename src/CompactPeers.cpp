@@ -0,0 +1,145 @@
+/**
+* @file      CompactPeers.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of decoding and encoding of compact peers.
+*/
+
+#include "CompactPeers.h"
+
+#include <cstring>
+
+#include "Decoder.h"
+
+namespace bencoding {
+
+namespace {
+
+/**
+* @brief Returns the number of peers of @a peerSize bytes in @a peers.
+*
+* @throws DecodingError When the size of @a peers is not a multiple of
+*         @a peerSize.
+*/
+std::size_t numOfCompactPeers(const StringRef &peers, std::size_t peerSize) {
+	if (peers.size() % peerSize != 0) {
+		throw DecodingError("size of compact peers (" +
+			std::to_string(peers.size()) + ") is not a multiple of " +
+			std::to_string(peerSize));
+	}
+	return peers.size() / peerSize;
+}
+
+/**
+* @brief Reads a 16-bit number in the network byte order.
+*/
+std::uint16_t readPort(const unsigned char *bytes) {
+	return static_cast<std::uint16_t>(bytes[0] << 8 | bytes[1]);
+}
+
+/**
+* @brief Writes a 16-bit number in the network byte order.
+*/
+void writePort(unsigned char *bytes, std::uint16_t port) {
+	bytes[0] = static_cast<unsigned char>(port >> 8);
+	bytes[1] = static_cast<unsigned char>(port);
+}
+
+} // anonymous namespace
+
+/**
+* @brief Decodes IPv4 peers in the compact form (the value of the @c peers key
+*        of tracker responses) into @a result.
+*
+* The previous contents of @a result are replaced, but its capacity is reused,
+* so decoding repeatedly into the same vector does not allocate.
+*
+* @throws DecodingError When the size of @a peers is not a multiple of
+*         COMPACT_IPV4_PEER_SIZE.
+*/
+void decodeCompactPeers(const StringRef &peers, std::vector<IPv4Peer> &result) {
+	std::size_t count = numOfCompactPeers(peers, COMPACT_IPV4_PEER_SIZE);
+	result.resize(count);
+	// The byte swapping is done by shifts over plain arrays so that the
+	// compiler can vectorize the loop without any platform-specific code.
+	auto bytes = reinterpret_cast<const unsigned char *>(peers.data());
+	IPv4Peer *dest = result.data();
+	for (std::size_t i = 0; i < count; ++i) {
+		const unsigned char *peer = bytes + i * COMPACT_IPV4_PEER_SIZE;
+		dest[i].address = static_cast<std::uint32_t>(peer[0]) << 24 |
+			static_cast<std::uint32_t>(peer[1]) << 16 |
+			static_cast<std::uint32_t>(peer[2]) << 8 |
+			static_cast<std::uint32_t>(peer[3]);
+		dest[i].port = readPort(peer + 4);
+	}
+}
+
+/**
+* @brief Decodes IPv6 peers in the compact form (the value of the @c peers6
+*        key of tracker responses) into @a result.
+*
+* The previous contents of @a result are replaced, but its capacity is reused,
+* so decoding repeatedly into the same vector does not allocate.
+*
+* @throws DecodingError When the size of @a peers is not a multiple of
+*         COMPACT_IPV6_PEER_SIZE.
+*/
+void decodeCompactPeers(const StringRef &peers, std::vector<IPv6Peer> &result) {
+	std::size_t count = numOfCompactPeers(peers, COMPACT_IPV6_PEER_SIZE);
+	result.resize(count);
+	auto bytes = reinterpret_cast<const unsigned char *>(peers.data());
+	IPv6Peer *dest = result.data();
+	for (std::size_t i = 0; i < count; ++i) {
+		const unsigned char *peer = bytes + i * COMPACT_IPV6_PEER_SIZE;
+		std::memcpy(dest[i].address, peer, sizeof(dest[i].address));
+		dest[i].port = readPort(peer + sizeof(dest[i].address));
+	}
+}
+
+/**
+* @brief Writes @a count IPv4 peers as a string in the compact form (the value
+*        of the @c peers key of tracker responses).
+*
+* The peers are written directly into the buffer of @a writer, so no
+* temporary string is created.
+*/
+void writeCompactPeers(EncodedWriter &writer, const IPv4Peer *peers,
+		std::size_t count) {
+	auto dest = reinterpret_cast<unsigned char *>(
+		writer.writeStringHeader(count * COMPACT_IPV4_PEER_SIZE));
+	if (!dest) {
+		return;
+	}
+	for (std::size_t i = 0; i < count; ++i) {
+		unsigned char *peer = dest + i * COMPACT_IPV4_PEER_SIZE;
+		std::uint32_t address = peers[i].address;
+		peer[0] = static_cast<unsigned char>(address >> 24);
+		peer[1] = static_cast<unsigned char>(address >> 16);
+		peer[2] = static_cast<unsigned char>(address >> 8);
+		peer[3] = static_cast<unsigned char>(address);
+		writePort(peer + 4, peers[i].port);
+	}
+}
+
+/**
+* @brief Writes @a count IPv6 peers as a string in the compact form (the value
+*        of the @c peers6 key of tracker responses).
+*
+* The peers are written directly into the buffer of @a writer, so no
+* temporary string is created.
+*/
+void writeCompactPeers(EncodedWriter &writer, const IPv6Peer *peers,
+		std::size_t count) {
+	auto dest = reinterpret_cast<unsigned char *>(
+		writer.writeStringHeader(count * COMPACT_IPV6_PEER_SIZE));
+	if (!dest) {
+		return;
+	}
+	for (std::size_t i = 0; i < count; ++i) {
+		unsigned char *peer = dest + i * COMPACT_IPV6_PEER_SIZE;
+		std::memcpy(peer, peers[i].address, sizeof(peers[i].address));
+		writePort(peer + sizeof(peers[i].address), peers[i].port);
+	}
+}
+
+} // namespace bencoding
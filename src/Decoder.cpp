@@ -7,9 +7,12 @@
 
 #include "Decoder.h"
 
+#include <algorithm>
 #include <cassert>
-#include <regex>
+#include <cstdint>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "BDictionary.h"
 #include "BInteger.h"
@@ -25,6 +28,9 @@ namespace bencoding {
 DecodingError::DecodingError(const std::string &what):
 	std::runtime_error(what) {}
 
+const std::size_t Decoder::NO_MEMORY_LIMIT;
+const std::size_t Decoder::STREAM_CHUNK_SIZE;
+
 /**
 * @brief Constructs a decoder.
 */
@@ -45,7 +51,8 @@ std::shared_ptr<Decoder> Decoder::create() {
 */
 std::shared_ptr<BItem> Decoder::decode(const std::string &data) {
 	std::istringstream input(data);
-	auto decodedData = decode(input);
+	startDecoding(true);
+	auto decodedData = decodeItem(input);
 	validateInputDoesNotContainUndecodedCharacters(input);
 	return decodedData;
 }
@@ -58,6 +65,24 @@ std::shared_ptr<BItem> Decoder::decode(const std::string &data) {
 * decode() that takes @c std::string as the input.
 */
 std::shared_ptr<BItem> Decoder::decode(std::istream &input) {
+	startDecoding(false);
+	return decodeItem(input);
+}
+
+/**
+* @brief Prepares the decoder for decoding new data.
+*
+* @param[in] fromBuffer Are all the data available in the stream buffer?
+*/
+void Decoder::startDecoding(bool fromBuffer) {
+	decodingFromBuffer = fromBuffer;
+	memoryUsage = 0;
+}
+
+/**
+* @brief Decodes a single item (including nested items) from @a input.
+*/
+std::shared_ptr<BItem> Decoder::decodeItem(std::istream &input) {
 	switch (input.peek()) {
 		case 'd':
 			return decodeDictionary(input);
@@ -85,6 +110,80 @@ std::shared_ptr<BItem> Decoder::decode(std::istream &input) {
 	return std::shared_ptr<BItem>();
 }
 
+/**
+* @brief Enables or disables the strict mode.
+*
+* In the strict mode, the decoder accepts only canonically encoded data (see
+* validate() for the rules). In particular, dictionaries whose keys are not
+* sorted or contain duplicates are rejected instead of being silently
+* reordered or merged. The strict mode is disabled by default.
+*/
+void Decoder::setStrictMode(bool strict) {
+	strictMode = strict;
+}
+
+/**
+* @brief Checks if the decoder is in the strict mode.
+*/
+bool Decoder::isInStrictMode() const {
+	return strictMode;
+}
+
+/**
+* @brief Enables or disables packing of homogeneous lists.
+*
+* When enabled, lists that contain only integers or only strings are decoded
+* into the packed form (see BList::Storage), which needs considerably less
+* memory. When such a list is accessed as a list of BItems, it is converted
+* back, so disable the packing if you intend to modify most of the decoded
+* lists. The packing is enabled by default.
+*/
+void Decoder::setListPacking(bool enabled) {
+	listPacking = enabled;
+}
+
+/**
+* @brief Checks if the packing of homogeneous lists is enabled.
+*/
+bool Decoder::isListPackingEnabled() const {
+	return listPacking;
+}
+
+/**
+* @brief Sets the maximal number of bytes the data decoded by a single call to
+*        decode() may occupy.
+*
+* The usage is estimated from the sizes of the created items and the lengths of
+* the decoded strings, and it is checked before the memory is allocated. When
+* the limit would be exceeded, DecodingError is thrown. This protects against
+* inputs that declare huge strings or contain huge numbers of small items. By
+* default, there is no limit (@c NO_MEMORY_LIMIT).
+*/
+void Decoder::setMemoryLimit(std::size_t limit) {
+	memoryLimit = limit;
+}
+
+/**
+* @brief Returns the memory limit.
+*
+* See setMemoryLimit() for more details.
+*/
+std::size_t Decoder::getMemoryLimit() const {
+	return memoryLimit;
+}
+
+/**
+* @brief Accounts @a size more bytes of decoded data and throws DecodingError
+*        if the memory limit would be exceeded.
+*/
+void Decoder::chargeMemory(std::size_t size) {
+	if (size > memoryLimit - memoryUsage) {
+		throw DecodingError("decoded data would exceed the memory limit of " +
+			std::to_string(memoryLimit) + " bytes");
+	}
+	memoryUsage += size;
+}
+
 /**
 * @brief Reads @a expected_char from @a input and discards it.
 */
@@ -111,14 +210,15 @@ void Decoder::readExpectedChar(std::istream &input, char expected_char) const {
 * @endcode
 *
 * The keys must be bencoded strings. The values may be any bencoded type,
-* including integers, strings, lists, and other dictionaries. This function
-* supports decoding of dictionaries whose keys are not lexicographically sorted
-* (according to the <a
+* including integers, strings, lists, and other dictionaries. Unless the
+* decoder is in the strict mode, this function supports decoding of
+* dictionaries whose keys are not lexicographically sorted (according to the <a
 * href="https://wiki.theory.org/BitTorrentSpecification#Bencoding">specification</a>,
-* they must be sorted).
+* they must be sorted). When a key appears more than once, the last value wins.
 */
 std::shared_ptr<BDictionary> Decoder::decodeDictionary(std::istream &input) {
 	readExpectedChar(input, 'd');
+	chargeMemory(sizeof(BDictionary));
 	auto bDictionary = decodeDictionaryItemsIntoDictionary(input);
 	readExpectedChar(input, 'e');
 	return bDictionary;
@@ -131,10 +231,26 @@ std::shared_ptr<BDictionary> Decoder::decodeDictionary(std::istream &input) {
 std::shared_ptr<BDictionary> Decoder::decodeDictionaryItemsIntoDictionary(
 		std::istream &input) {
 	auto bDictionary = BDictionary::create();
+	std::shared_ptr<BString> previousKey;
+	// The largest key so far. As long as the keys are sorted (which they are
+	// in canonically encoded data), every item is appended to the end of the
+	// dictionary without searching for its position.
+	std::shared_ptr<BString> largestKey;
 	while (input && input.peek() != 'e') {
 		std::shared_ptr<BString> key(decodeDictionaryKey(input));
+		if (strictMode && previousKey) {
+			validateKeyOrder(previousKey, key);
+		}
 		std::shared_ptr<BItem> value(decodeDictionaryValue(input));
-		(*bDictionary)[key] = value;
+		chargeMemory(sizeof(BDictionary::value_type));
+		if (!largestKey || *largestKey->value() < *key->value()) {
+			bDictionary->insert(bDictionary->end(),
+				BDictionary::value_type(key, value));
+			largestKey = key;
+		} else {
+			(*bDictionary)[key] = value;
+		}
+		previousKey = key;
 	}
 	return bDictionary;
 }
@@ -143,22 +259,36 @@ std::shared_ptr<BDictionary> Decoder::decodeDictionaryItemsIntoDictionary(
 * @brief Decodes a dictionary key from @a input.
 */
 std::shared_ptr<BString> Decoder::decodeDictionaryKey(std::istream &input) {
-	std::shared_ptr<BItem> key(decode(input));
+	std::shared_ptr<BItem> key(decodeItem(input));
 	// A dictionary key has to be a string.
-	std::shared_ptr<BString> keyAsBString(key->as<BString>());
-	if (!keyAsBString) {
+	if (!key->asPtr<BString>()) {
 		throw DecodingError(
 			"found a dictionary key that is not a bencoded string"
 		);
 	}
-	return keyAsBString;
+	return std::static_pointer_cast<BString>(key);
+}
+
+/**
+* @brief Throws DecodingError if @a key does not follow @a previousKey in the
+*        canonical order.
+*/
+void Decoder::validateKeyOrder(const std::shared_ptr<BString> &previousKey,
+		const std::shared_ptr<BString> &key) const {
+	int order = previousKey->value()->compare(*key->value());
+	if (order == 0) {
+		throw DecodingError("duplicate dictionary key: '" + *key->value() + "'");
+	} else if (order > 0) {
+		throw DecodingError("dictionary keys are not sorted: '" +
+			*previousKey->value() + "' precedes '" + *key->value() + "'");
+	}
 }
 
 /**
 * @brief Decodes a dictionary value from @a input.
 */
 std::shared_ptr<BItem> Decoder::decodeDictionaryValue(std::istream &input) {
-	return decode(input);
+	return decodeItem(input);
 }
 
 /**
@@ -179,42 +309,68 @@ std::shared_ptr<BItem> Decoder::decodeDictionaryValue(std::istream &input) {
 * href="https://wiki.theory.org/BitTorrentSpecification#Bencoding">
 * specification</a>).
 */
-std::shared_ptr<BInteger> Decoder::decodeInteger(std::istream &input) const {
-	return decodeEncodedInteger(readEncodedInteger(input));
+std::shared_ptr<BInteger> Decoder::decodeInteger(std::istream &input) {
+	BInteger::ValueType integerValue = readInteger(input);
+	chargeMemory(sizeof(BInteger));
+	return BInteger::create(integerValue);
 }
 
 /**
-* @brief Reads an encoded integer from @a input.
+* @brief Reads an encoded integer from @a input and returns its value.
+*
+* See decodeInteger() for the format.
 */
-std::string Decoder::readEncodedInteger(std::istream &input) const {
-	// See the description of decodeInteger() for the format and example.
-	std::string encodedInteger;
-	bool encodedIntegerReadCorrectly = readUntil(input, encodedInteger, 'e');
-	if (!encodedIntegerReadCorrectly) {
-		throw DecodingError("error during the decoding of an integer near '" +
-			encodedInteger + "'");
+BInteger::ValueType Decoder::readInteger(std::istream &input) const {
+	readExpectedChar(input, 'i');
+	char encodedInteger[MAX_DECIMAL_LENGTH + 1];
+	std::size_t length = 0;
+	if (input.peek() == '-' || input.peek() == '+') {
+		encodedInteger[length++] = static_cast<char>(input.get());
+	}
+	const char *digits = encodedInteger + length;
+	std::size_t numOfDigits = readDigits(input, encodedInteger + length);
+	length += numOfDigits;
+	// The encoded integer is put into strings only when an error is reported,
+	// so successful decoding does not allocate.
+	if (numOfDigits == 0 || (digits[0] == '0' && numOfDigits > 1)) {
+		throw DecodingError("encountered an encoded integer of invalid format: '" +
+			std::string(encodedInteger, length) + "'");
+	}
+	readExpectedChar(input, 'e');
+
+	bool isNegativeZero = length == 2 && encodedInteger[0] == '-' &&
+		encodedInteger[1] == '0';
+	if (strictMode && (encodedInteger[0] == '+' || isNegativeZero)) {
+		throw DecodingError("encountered a non-canonical encoded integer: '" +
+			std::string(encodedInteger, length) + "'");
 	}
 
-	return encodedInteger;
+	BInteger::ValueType integerValue;
+	const char *first = encodedInteger[0] == '+' ? digits : encodedInteger;
+	if (!parseDecimal(first, encodedInteger + length, integerValue)) {
+		throw DecodingError("encoded integer does not fit into 64 bits: '" +
+			std::string(encodedInteger, length) + "'");
+	}
+	return integerValue;
 }
 
 /**
-* @brief Decodes the given encoded integer.
+* @brief Reads consecutive decimal digits from @a input into @a digits and
+*        returns their number.
+*
+* @a digits has to have room for @c MAX_DECIMAL_LENGTH characters. Longer
+* numbers would not fit into 64 bits, so DecodingError is thrown for them
+* before reading any further.
 */
-std::shared_ptr<BInteger> Decoder::decodeEncodedInteger(
-		const std::string &encodedInteger) const {
-	// See the description of decodeInteger() for the format and example.
-	std::regex integerRegex("i([-+]?(0|[1-9][0-9]*))e");
-	std::smatch match;
-	bool valid = std::regex_match(encodedInteger, match, integerRegex);
-	if (!valid) {
-		throw DecodingError("encountered an encoded integer of invalid format: '" +
-			encodedInteger + "'");
+std::size_t Decoder::readDigits(std::istream &input, char *digits) const {
+	std::size_t numOfDigits = 0;
+	while (input.peek() >= '0' && input.peek() <= '9') {
+		if (numOfDigits == MAX_DECIMAL_LENGTH) {
+			throw DecodingError("encountered a number that does not fit into 64 bits");
+		}
+		digits[numOfDigits++] = static_cast<char>(input.get());
 	}
-
-	BInteger::ValueType integerValue;
-	strToNum(match[1].str(), integerValue);
-	return BInteger::create(integerValue);
+	return numOfDigits;
 }
 
 /**
@@ -232,6 +388,7 @@ std::shared_ptr<BInteger> Decoder::decodeEncodedInteger(
 */
 std::shared_ptr<BList> Decoder::decodeList(std::istream &input) {
 	readExpectedChar(input, 'l');
+	chargeMemory(sizeof(BList));
 	auto bList = decodeListItemsIntoList(input);
 	readExpectedChar(input, 'e');
 	return bList;
@@ -242,13 +399,49 @@ std::shared_ptr<BList> Decoder::decodeList(std::istream &input) {
 *        list.
 */
 std::shared_ptr<BList> Decoder::decodeListItemsIntoList(std::istream &input) {
-	auto bList = BList::create();
+	auto bList = listPacking ? decodePackedListItems(input) : BList::create();
+	if (!bList->empty() && input && input.peek() != 'e') {
+		// The list is not homogeneous, so the packed items will be converted
+		// into separate items once the next item is appended.
+		std::size_t itemSize =
+			bList->storage() == BList::Storage::PackedIntegers ?
+				sizeof(BInteger) : sizeof(BString);
+		chargeMemory(bList->size() * (itemSize + sizeof(BList::value_type)));
+	}
 	while (input && input.peek() != 'e') {
-		bList->push_back(decode(input));
+		auto bItem = decodeItem(input);
+		chargeMemory(sizeof(BList::value_type));
+		bList->push_back(bItem);
 	}
 	return bList;
 }
 
+/**
+* @brief Decodes the leading integers or strings from @a input into a packed
+*        list, and returns that list.
+*
+* Decoding stops at the first item of a different type. If the list does not
+* start with an integer or a string, an empty list is returned.
+*/
+std::shared_ptr<BList> Decoder::decodePackedListItems(std::istream &input) {
+	if (input.peek() == 'i') {
+		std::vector<BInteger::ValueType> integers;
+		while (input.peek() == 'i') {
+			chargeMemory(sizeof(BInteger::ValueType));
+			integers.push_back(readInteger(input));
+		}
+		return BList::createPackedIntegers(std::move(integers));
+	} else if (input.peek() >= '0' && input.peek() <= '9') {
+		std::vector<std::string> strings;
+		while (input.peek() >= '0' && input.peek() <= '9') {
+			chargeMemory(sizeof(std::string));
+			strings.push_back(readString(input));
+		}
+		return BList::createPackedStrings(std::move(strings));
+	}
+	return BList::create();
+}
+
 /**
 * @brief Decodes a string from @a input.
 *
@@ -262,28 +455,47 @@ std::shared_ptr<BList> Decoder::decodeListItemsIntoList(std::istream &input) {
 * 4:test represents the string "test"
 * @endcode
 */
-std::shared_ptr<BString> Decoder::decodeString(std::istream &input) const {
+std::shared_ptr<BString> Decoder::decodeString(std::istream &input) {
+	chargeMemory(sizeof(BString));
+	return BString::create(readString(input));
+}
+
+/**
+* @brief Reads an encoded string from @a input and returns its contents.
+*
+* See decodeString() for the format.
+*/
+std::string Decoder::readString(std::istream &input) {
 	std::string::size_type stringLength(readStringLength(input));
 	readExpectedChar(input, ':');
-	std::string str(readStringOfGivenLength(input, stringLength));
-	return BString::create(str);
+	chargeMemory(stringLength);
+	return readStringOfGivenLength(input, stringLength);
 }
 
 /**
 * @brief Reads the string length from @a input, validates it, and returns it.
 */
 std::string::size_type Decoder::readStringLength(std::istream &input) const {
-	std::string stringLengthInASCII;
-	bool stringLengthInASCIIReadCorrectly = readUpTo(input, stringLengthInASCII, ':');
-	if (!stringLengthInASCIIReadCorrectly) {
+	char digits[MAX_DECIMAL_LENGTH];
+	std::size_t numOfDigits = readDigits(input, digits);
+	// The digits are put into strings only when an error is reported, so
+	// successful decoding does not allocate.
+	if (input.peek() != ':') {
 		throw DecodingError("error during the decoding of a string near '" +
-			stringLengthInASCII + "'");
+			std::string(digits, numOfDigits) + "'");
 	}
 
-	std::string::size_type stringLength;
-	bool stringLengthIsValid = strToNum(stringLengthInASCII, stringLength);
+	std::uint64_t stringLength;
+	bool stringLengthIsValid = parseUnsignedDecimal(digits, digits + numOfDigits,
+			stringLength) && stringLength <= std::string().max_size();
 	if (!stringLengthIsValid) {
-		throw DecodingError("invalid string length: '" + stringLengthInASCII + "'");
+		throw DecodingError("invalid string length: '" +
+			std::string(digits, numOfDigits) + "'");
+	}
+
+	if (strictMode && numOfDigits > 1 && digits[0] == '0') {
+		throw DecodingError("string length with leading zeros: '" +
+			std::string(digits, numOfDigits) + "'");
 	}
 
 	return stringLength;
@@ -291,16 +503,40 @@ std::string::size_type Decoder::readStringLength(std::istream &input) const {
 
 /**
 * @brief Reads a string of the given @a length from @a input and returns it.
+*
+* The length comes from the input, so it cannot be trusted. When decoding from
+* a buffer, it is checked against the number of remaining characters before
+* anything is allocated. When decoding from a stream, the string is read in
+* chunks of at most @c STREAM_CHUNK_SIZE characters, so the allocated memory
+* is proportional to the number of characters that have actually been read.
 */
 std::string Decoder::readStringOfGivenLength(std::istream &input,
-		std::string::size_type length) const {
-	std::string str(length, char());
-	input.read(&str[0], length);
-	std::string::size_type numOfReadChars(input.gcount());
-	if (numOfReadChars != length) {
-		throw DecodingError("expected a string containing " + std::to_string(length) +
-			" characters, but read only " + std::to_string(numOfReadChars) +
-			" characters");
+		std::string::size_type length) {
+	if (decodingFromBuffer) {
+		std::streamsize available = input.rdbuf()->in_avail();
+		std::string::size_type numOfAvailableChars = available > 0 ?
+			static_cast<std::string::size_type>(available) : 0;
+		if (length > numOfAvailableChars) {
+			throw DecodingError("expected a string containing " +
+				std::to_string(length) + " characters, but only " +
+				std::to_string(numOfAvailableChars) + " characters remain");
+		}
+	}
+
+	std::string str;
+	std::string::size_type chunkSize = decodingFromBuffer ?
+		length : STREAM_CHUNK_SIZE;
+	while (str.size() < length) {
+		std::string::size_type numOfReadChars = str.size();
+		std::string::size_type numOfCharsToRead =
+			std::min(length - numOfReadChars, chunkSize);
+		str.resize(numOfReadChars + numOfCharsToRead);
+		input.read(&str[numOfReadChars], numOfCharsToRead);
+		if (static_cast<std::string::size_type>(input.gcount()) != numOfCharsToRead) {
+			throw DecodingError("expected a string containing " +
+				std::to_string(length) + " characters, but read only " +
+				std::to_string(numOfReadChars + input.gcount()) + " characters");
+		}
 	}
 	return str;
 }
@@ -0,0 +1,125 @@
+/**
+* @file      EncodedListView.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the EncodedListView class.
+*/
+
+#include "EncodedListView.h"
+
+#include <cassert>
+
+#include "Decoder.h"
+
+namespace bencoding {
+
+/**
+* @brief Constructs a view of the bencoded list stored in @a size bytes
+*        starting at @a data.
+*
+* If the data are not a single bencoded list, DecodingError is thrown. The
+* items are checked only to the extent needed to find their boundaries (see
+* Scanner::skipItem()).
+*/
+EncodedListView::EncodedListView(const char *data, std::size_t size) {
+	Scanner scanner(data, size);
+	scanner.enterList();
+	while (!scanner.atContainerEnd()) {
+		items.push_back(scanner.skipItem());
+	}
+	scanner.leaveContainer();
+	if (!scanner.atEnd()) {
+		throw DecodingError("input contains undecoded characters");
+	}
+}
+
+/**
+* @brief Constructs a view of the bencoded list stored in @a data.
+*
+* @a data are not copied, so they have to outlive the view.
+*/
+EncodedListView::EncodedListView(const std::string &data):
+	EncodedListView(data.data(), data.size()) {}
+
+/**
+* @brief Returns the number of items in the list.
+*/
+std::size_t EncodedListView::size() const {
+	return items.size();
+}
+
+/**
+* @brief Checks if the list is empty.
+*/
+bool EncodedListView::empty() const {
+	return items.empty();
+}
+
+/**
+* @brief Returns the encoded form of the item at @a idx.
+*
+* @preconditions
+*  - @a idx < size()
+*/
+StringRef EncodedListView::operator[](std::size_t idx) const {
+	assert(idx < size() && "index out of range");
+
+	return items[idx];
+}
+
+/**
+* @brief Returns a constant iterator to the first encoded item.
+*/
+EncodedListView::const_iterator EncodedListView::begin() const {
+	return items.begin();
+}
+
+/**
+* @brief Returns a constant iterator past the last encoded item.
+*/
+EncodedListView::const_iterator EncodedListView::end() const {
+	return items.end();
+}
+
+/**
+* @brief Returns the encoded form of the items in [@a first, @a last).
+*
+* The items are stored next to each other in the buffer, so the result is a
+* single reference spanning all of them.
+*
+* @preconditions
+*  - @a first <= @a last <= size()
+*/
+StringRef EncodedListView::encodedItems(std::size_t first,
+		std::size_t last) const {
+	assert(first <= last && last <= size() && "invalid range");
+
+	if (first == last) {
+		return StringRef();
+	}
+	const char *begin = items[first].data();
+	const char *end = items[last - 1].end();
+	return StringRef(begin, end - begin);
+}
+
+/**
+* @brief Returns a bencoded list containing the items in [@a first, @a last).
+*
+* The result is created by a single copy of the encoded items, without
+* decoding them.
+*
+* @preconditions
+*  - @a first <= @a last <= size()
+*/
+std::string EncodedListView::encodeSlice(std::size_t first,
+		std::size_t last) const {
+	StringRef encoded(encodedItems(first, last));
+	std::string encodedSlice;
+	encodedSlice.reserve(encoded.size() + 2);
+	encodedSlice += 'l';
+	encodedSlice.append(encoded.data(), encoded.size());
+	encodedSlice += 'e';
+	return encodedSlice;
+}
+
+} // namespace bencoding
@@ -0,0 +1,138 @@
+/**
+* @file      EncodedWriter.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the EncodedWriter class.
+*/
+
+#include "EncodedWriter.h"
+
+#include <cstring>
+
+#include "Utils.h"
+
+namespace bencoding {
+
+/**
+* @brief Constructs a writer into @a capacity bytes starting at @a buffer.
+*
+* The buffer has to outlive the writer and all the references returned by
+* written().
+*/
+EncodedWriter::EncodedWriter(char *buffer, std::size_t capacity):
+	first(buffer), current(buffer), last(buffer + capacity),
+	hasOverflowed(false) {}
+
+/**
+* @brief Writes @a size bytes starting at @a data as they are.
+*/
+EncodedWriter &EncodedWriter::writeBytes(const char *data, std::size_t size) {
+	if (char *dest = reserve(size)) {
+		std::memcpy(dest, data, size);
+	}
+	return *this;
+}
+
+/**
+* @brief Writes an encoded integer with the given @a value.
+*/
+EncodedWriter &EncodedWriter::writeInteger(std::int64_t value) {
+	char encodedInteger[MAX_ENCODED_INTEGER_LENGTH];
+	return writeBytes(encodedInteger,
+		writeEncodedInteger(encodedInteger, value));
+}
+
+/**
+* @brief Writes an encoded string with the given contents.
+*/
+EncodedWriter &EncodedWriter::writeString(const char *data, std::size_t size) {
+	if (char *dest = writeStringHeader(size)) {
+		std::memcpy(dest, data, size);
+	}
+	return *this;
+}
+
+/**
+* @brief Writes an encoded string with the contents of @a str.
+*/
+EncodedWriter &EncodedWriter::writeString(const StringRef &str) {
+	return writeString(str.data(), str.size());
+}
+
+/**
+* @brief Writes the length of an encoded string of @a size bytes and reserves
+*        space for its contents.
+*
+* @return Pointer to @a size bytes to be filled in by the caller, or the null
+*         pointer when the string does not fit into the buffer.
+*
+* It allows writing strings whose contents are produced on the fly (e.g.
+* compact peers) without copying them through a temporary buffer.
+*/
+char *EncodedWriter::writeStringHeader(std::size_t size) {
+	char encodedLength[MAX_ENCODED_STRING_HEADER_LENGTH];
+	std::size_t length = writeEncodedStringHeader(encodedLength, size);
+	char *dest = reserve(length + size);
+	if (!dest) {
+		return nullptr;
+	}
+	std::memcpy(dest, encodedLength, length);
+	return dest + length;
+}
+
+/**
+* @brief Returns the number of written bytes.
+*/
+std::size_t EncodedWriter::size() const {
+	return current - first;
+}
+
+/**
+* @brief Returns the size of the buffer.
+*/
+std::size_t EncodedWriter::capacity() const {
+	return last - first;
+}
+
+/**
+* @brief Has some piece not fit into the buffer?
+*
+* The pieces that have not fit have not been written at all, so the written
+* data are incomplete.
+*/
+bool EncodedWriter::overflowed() const {
+	return hasOverflowed;
+}
+
+/**
+* @brief Returns a reference to the written data.
+*/
+StringRef EncodedWriter::written() const {
+	return StringRef(first, size());
+}
+
+/**
+* @brief Discards the written data so that the buffer can be reused.
+*/
+void EncodedWriter::clear() {
+	current = first;
+	hasOverflowed = false;
+}
+
+/**
+* @brief Reserves @a size bytes in the buffer and returns a pointer to them.
+*
+* If they do not fit, or some previous piece has not fit, the null pointer is
+* returned.
+*/
+char *EncodedWriter::reserve(std::size_t size) {
+	if (hasOverflowed || size > static_cast<std::size_t>(last - current)) {
+		hasOverflowed = true;
+		return nullptr;
+	}
+	char *dest = current;
+	current += size;
+	return dest;
+}
+
+} // namespace bencoding
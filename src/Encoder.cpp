@@ -10,6 +10,7 @@
 #include "BDictionary.h"
 #include "BInteger.h"
 #include "BList.h"
+#include "BListSlice.h"
 #include "BString.h"
 #include "Utils.h"
 
@@ -35,11 +36,26 @@ std::string Encoder::encode(std::shared_ptr<BItem> data) {
 	return encodedData;
 }
 
+/**
+* @brief Encodes the items in the given @a slice as a list and returns them.
+*
+* The result is the same as when encoding a list containing only the items in
+* the slice, but no such list is created.
+*/
+std::string Encoder::encode(const BListSlice &slice) {
+	encodedData += "l";
+	for (const auto &bItem : slice) {
+		bItem->accept(this);
+	}
+	encodedData += "e";
+	return encodedData;
+}
+
 void Encoder::visit(BDictionary *bDictionary) {
 	// See the description of Decoder::decodeDictionary() for the format and
 	// example.
 	encodedData += "d";
-	for (auto item : *bDictionary) {
+	for (const auto &item : *bDictionary) {
 		item.first->accept(this);
 		item.second->accept(this);
 	}
@@ -47,28 +63,56 @@ void Encoder::visit(BDictionary *bDictionary) {
 }
 
 void Encoder::visit(BInteger *bInteger) {
-	// See the description of Decoder::decodeInteger() for the format and
-	// example.
-	std::string encodedInteger("i" + std::to_string(bInteger->value()) + "e");
-	encodedData += encodedInteger;
+	encodeInteger(bInteger->value());
 }
 
 void Encoder::visit(BList *bList) {
 	// See the description of Decoder::decodeList() for the format and example.
 	encodedData += "l";
-	for (auto bItem : *bList) {
-		bItem->accept(this);
+	// Packed lists are encoded directly from the packed values so that they
+	// are not converted into separate items.
+	switch (bList->storage()) {
+		case BList::Storage::PackedIntegers:
+			for (auto value : bList->packedIntegers()) {
+				encodeInteger(value);
+			}
+			break;
+		case BList::Storage::PackedStrings:
+			for (const auto &value : bList->packedStrings()) {
+				encodeString(value);
+			}
+			break;
+		default:
+			// Through a constant reference, so frozen lists can be encoded.
+			for (const auto &bItem : static_cast<const BList &>(*bList)) {
+				bItem->accept(this);
+			}
+			break;
 	}
 	encodedData += "e";
 }
 
 void Encoder::visit(BString *bString) {
+	encodeString(*bString->value());
+}
+
+/**
+* @brief Appends an integer with the given @a value to the encoded data.
+*/
+void Encoder::encodeInteger(BInteger::ValueType value) {
+	// See the description of Decoder::decodeInteger() for the format and
+	// example.
+	appendEncodedInteger(encodedData, value);
+}
+
+/**
+* @brief Appends a string with the given @a value to the encoded data.
+*/
+void Encoder::encodeString(const std::string &value) {
 	// See the description of Decoder::decodeString() for the format and
 	// example.
-	std::string encodedString(
-		std::to_string(bString->length()) + ":" + *bString->value()
-	);
-	encodedData += encodedString;
+	appendEncodedStringHeader(encodedData, value.size());
+	encodedData += value;
 }
 
 /**
@@ -84,4 +128,17 @@ std::string encode(std::shared_ptr<BItem> data) {
 	return encoder->encode(data);
 }
 
+/**
+* @brief Encodes the items in the given @a slice as a list and returns them.
+*
+* This function can be handy if you just want to encode data without explicitly
+* creating an encoder and calling @c encode() on it.
+*
+* See Encoder::encode() for more details.
+*/
+std::string encode(const BListSlice &slice) {
+	auto encoder = Encoder::create();
+	return encoder->encode(slice);
+}
+
 } // namespace bencoding
@@ -0,0 +1,99 @@
+/**
+* @file      InfoHash.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the computation of info hashes.
+*/
+
+#include "InfoHash.h"
+
+#include "Decoder.h"
+#include "Sha.h"
+
+namespace bencoding {
+
+/**
+* @brief Returns a reference to the encoded @c info dictionary of the torrent
+*        file stored in @a size bytes starting at @a data.
+*
+* The data are only scanned, no BItem is created. Values of other keys are
+* skipped by their lengths, so the running time depends on the number of
+* items rather than on the size of the data. The returned reference points
+* into @a data.
+*
+* If the data are not a dictionary with an @c info dictionary, DecodingError
+* is thrown.
+*/
+StringRef findInfoDictionary(const char *data, std::size_t size) {
+	Scanner scanner(data, size);
+	scanner.enterDictionary();
+	while (!scanner.atContainerEnd()) {
+		StringRef key = scanner.readString();
+		if (key == StringRef("info")) {
+			if (scanner.peek() != 'd') {
+				throw DecodingError("the info key is not mapped to a dictionary");
+			}
+			return scanner.skipItem();
+		}
+		scanner.skipItem();
+	}
+	throw DecodingError("no info dictionary found");
+}
+
+/**
+* @brief Returns a reference to the encoded @c info dictionary of the torrent
+*        file stored in @a data.
+*
+* See findInfoDictionary(const char *, std::size_t) for more details.
+*/
+StringRef findInfoDictionary(const std::string &data) {
+	return findInfoDictionary(data.data(), data.size());
+}
+
+/**
+* @brief Returns the BitTorrent v1 info hash (SHA-1 of the encoded @c info
+*        dictionary, 20 raw bytes) of the torrent file stored in @a size bytes
+*        starting at @a data.
+*
+* The @c info dictionary is hashed as it appears in the data, without decoding
+* and re-encoding it. If it cannot be found, DecodingError is thrown.
+*/
+std::string infoHashV1(const char *data, std::size_t size) {
+	StringRef info = findInfoDictionary(data, size);
+	return sha1(info.data(), info.size());
+}
+
+/**
+* @brief Returns the BitTorrent v1 info hash of the torrent file stored in @a
+*        data.
+*
+* See infoHashV1(const char *, std::size_t) for more details.
+*/
+std::string infoHashV1(const std::string &data) {
+	return infoHashV1(data.data(), data.size());
+}
+
+/**
+* @brief Returns the BitTorrent v2 info hash (SHA-256 of the encoded @c info
+*        dictionary, 32 raw bytes) of the torrent file stored in @a size bytes
+*        starting at @a data.
+*
+* The @c info dictionary is hashed as it appears in the data, without decoding
+* and re-encoding it. If it cannot be found, DecodingError is thrown.
+*/
+std::string infoHashV2(const char *data, std::size_t size) {
+	StringRef info = findInfoDictionary(data, size);
+	return sha256(info.data(), info.size());
+}
+
+/**
+* @brief Returns the BitTorrent v2 info hash of the torrent file stored in @a
+*        data.
+*
+* See infoHashV2(const char *, std::size_t) for more details.
+*/
+std::string infoHashV2(const std::string &data) {
+	return infoHashV2(data.data(), data.size());
+}
+
+} // namespace bencoding
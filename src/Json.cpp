@@ -0,0 +1,1071 @@
+/**
+* @file      Json.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of transcoding between bencoded data and JSON.
+*/
+
+#include "Json.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "Decoder.h"
+#include "Scanner.h"
+#include "Utils.h"
+
+namespace bencoding {
+
+namespace {
+
+/// Digits of the Base64 encoding.
+const char BASE64_DIGITS[] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+* @brief Returns the length of the UTF-8 sequence starting at @a data, or
+*        @c 0 if it is not a valid sequence.
+*
+* Overlong sequences, surrogates, and code points above U+10FFFF are invalid.
+*/
+std::size_t utf8SequenceLength(const unsigned char *data, std::size_t size) {
+	unsigned char c = data[0];
+	std::size_t length;
+	std::uint32_t codePoint;
+	std::uint32_t minCodePoint;
+	if (c < 0x80) {
+		return 1;
+	} else if ((c & 0xe0) == 0xc0) {
+		length = 2;
+		codePoint = c & 0x1fu;
+		minCodePoint = 0x80;
+	} else if ((c & 0xf0) == 0xe0) {
+		length = 3;
+		codePoint = c & 0x0fu;
+		minCodePoint = 0x800;
+	} else if ((c & 0xf8) == 0xf0) {
+		length = 4;
+		codePoint = c & 0x07u;
+		minCodePoint = 0x10000;
+	} else {
+		return 0;
+	}
+
+	if (size < length) {
+		return 0;
+	}
+	for (std::size_t i = 1; i < length; ++i) {
+		if ((data[i] & 0xc0) != 0x80) {
+			return 0;
+		}
+		codePoint = codePoint << 6 | (data[i] & 0x3fu);
+	}
+	if (codePoint < minCodePoint || codePoint > 0x10ffff ||
+			(codePoint >= 0xd800 && codePoint <= 0xdfff)) {
+		return 0;
+	}
+	return length;
+}
+
+/**
+* @brief Checks if @a str is valid UTF-8.
+*/
+bool isValidUtf8(const StringRef &str) {
+	auto data = reinterpret_cast<const unsigned char *>(str.data());
+	std::size_t size = str.size();
+	std::size_t i = 0;
+	while (i < size) {
+		// Most strings are mostly ASCII, which is checked in chunks.
+		i += findSpecialChar(str.data() + i, size - i,
+			SpecialChars::EscapedOrNonAscii);
+		if (i == size) {
+			break;
+		}
+		std::size_t length = utf8SequenceLength(data + i, size - i);
+		if (length == 0) {
+			return false;
+		}
+		i += length;
+	}
+	return true;
+}
+
+/**
+* @brief Writer of JSON into a buffer of a bounded size.
+*
+* When the buffer is full, its contents are written into the output stream
+* or appended to the output string.
+*/
+class JsonWriter {
+public:
+	JsonWriter(std::ostream *output, std::string *outputString,
+		JsonBinaryStrings binaryStrings);
+
+	void writeChar(char c);
+	void writeInteger(std::int64_t value);
+	void writeString(const StringRef &str);
+	void flush();
+
+private:
+	char *reserve(std::size_t size);
+	void writeBytes(const char *bytes, std::size_t size);
+	void writeEscaped(const StringRef &str);
+	void writeHex(const StringRef &str);
+	void writeBase64(const StringRef &str);
+
+private:
+	/// Buffered output.
+	std::vector<char> buffer;
+
+	/// Position in the buffer at which the next character is written.
+	char *current;
+
+	/// End of the buffer.
+	char *last;
+
+	/// Stream into which the output is written (if any).
+	std::ostream *output;
+
+	/// String to which the output is appended (if there is no stream).
+	std::string *outputString;
+
+	/// Representation of strings that are not valid UTF-8.
+	JsonBinaryStrings binaryStrings;
+};
+
+JsonWriter::JsonWriter(std::ostream *output, std::string *outputString,
+		JsonBinaryStrings binaryStrings):
+	buffer(OUTPUT_BUFFER_SIZE), current(buffer.data()),
+	last(buffer.data() + buffer.size()), output(output),
+	outputString(outputString), binaryStrings(binaryStrings) {}
+
+/**
+* @brief Writes a single character.
+*/
+void JsonWriter::writeChar(char c) {
+	*reserve(1) = c;
+	++current;
+}
+
+/**
+* @brief Writes an integer.
+*/
+void JsonWriter::writeInteger(std::int64_t value) {
+	current += writeDecimal(reserve(MAX_DECIMAL_LENGTH), value);
+}
+
+/**
+* @brief Writes @a str as a JSON string.
+*
+* @throws DecodingError When @a str is not valid UTF-8 and such strings are
+*         rejected.
+*/
+void JsonWriter::writeString(const StringRef &str) {
+	writeChar('"');
+	// Most strings (e.g. keys, names, and URLs) need no escaping, so they are
+	// checked and copied at once.
+	std::size_t plainLength = findSpecialChar(str.data(), str.size(),
+		SpecialChars::EscapedOrNonAscii);
+	if (plainLength == str.size()) {
+		writeBytes(str.data(), str.size());
+	} else if (isValidUtf8(StringRef(str.data() + plainLength,
+			str.size() - plainLength))) {
+		writeBytes(str.data(), plainLength);
+		writeEscaped(StringRef(str.data() + plainLength,
+			str.size() - plainLength));
+	} else if (binaryStrings == JsonBinaryStrings::Base64) {
+		writeBase64(str);
+	} else if (binaryStrings == JsonBinaryStrings::Hex) {
+		writeHex(str);
+	} else {
+		throw DecodingError("string is not valid UTF-8");
+	}
+	writeChar('"');
+}
+
+/**
+* @brief Writes the buffered output into the stream or appends it to the
+*        string.
+*/
+void JsonWriter::flush() {
+	std::size_t size = static_cast<std::size_t>(current - buffer.data());
+	if (output) {
+		output->write(buffer.data(), static_cast<std::streamsize>(size));
+	} else {
+		outputString->append(buffer.data(), size);
+	}
+	current = buffer.data();
+}
+
+/**
+* @brief Returns a pointer to the buffer at which at least @a size characters
+*        can be written.
+*
+* The caller advances @c current past the characters it has written.
+*
+* @par Preconditions
+*  - <tt>size <= OUTPUT_BUFFER_SIZE</tt>
+*/
+inline char *JsonWriter::reserve(std::size_t size) {
+	if (static_cast<std::size_t>(last - current) < size) {
+		flush();
+	}
+	return current;
+}
+
+/**
+* @brief Writes @a size bytes starting at @a bytes as they are.
+*/
+void JsonWriter::writeBytes(const char *bytes, std::size_t size) {
+	// Long strings are copied in parts fitting into the buffer.
+	while (size > 0) {
+		std::size_t toCopy = std::min(size, OUTPUT_BUFFER_SIZE);
+		std::memcpy(reserve(toCopy), bytes, toCopy);
+		current += toCopy;
+		bytes += toCopy;
+		size -= toCopy;
+	}
+}
+
+/**
+* @brief Writes the valid UTF-8 @a str with quotes, backslashes, and control
+*        characters escaped.
+*/
+void JsonWriter::writeEscaped(const StringRef &str) {
+	auto data = reinterpret_cast<const unsigned char *>(str.data());
+	std::size_t size = str.size();
+	std::size_t i = 0;
+	while (i < size) {
+		std::size_t length = findSpecialChar(str.data() + i, size - i,
+			SpecialChars::EscapedOrNonAscii);
+		writeBytes(str.data() + i, length);
+		i += length;
+		// Copy non-ASCII characters (already validated) and escape the rest.
+		for (; i < size && (data[i] >= 0x80 || data[i] < 0x20 ||
+				data[i] == '"' || data[i] == '\\'); ++i) {
+			unsigned char c = data[i];
+			char *out = reserve(6);
+			switch (c) {
+				case '"': *out++ = '\\'; *out++ = '"'; break;
+				case '\\': *out++ = '\\'; *out++ = '\\'; break;
+				case '\b': *out++ = '\\'; *out++ = 'b'; break;
+				case '\f': *out++ = '\\'; *out++ = 'f'; break;
+				case '\n': *out++ = '\\'; *out++ = 'n'; break;
+				case '\r': *out++ = '\\'; *out++ = 'r'; break;
+				case '\t': *out++ = '\\'; *out++ = 't'; break;
+				default:
+					if (c >= 0x80) {
+						*out++ = static_cast<char>(c);
+					} else {
+						*out++ = '\\';
+						*out++ = 'u';
+						*out++ = '0';
+						*out++ = '0';
+						*out++ = HEX_DIGITS[c >> 4];
+						*out++ = HEX_DIGITS[c & 0xf];
+					}
+					break;
+			}
+			current = out;
+		}
+	}
+}
+
+/**
+* @brief Writes the bytes of @a str in hex.
+*/
+void JsonWriter::writeHex(const StringRef &str) {
+	auto data = reinterpret_cast<const unsigned char *>(str.data());
+	std::size_t size = str.size();
+	std::size_t i = 0;
+	while (i < size) {
+		std::size_t chunkSize = std::min<std::size_t>(size - i,
+			OUTPUT_BUFFER_SIZE / 2);
+		char *out = reserve(2 * chunkSize);
+		for (std::size_t end = i + chunkSize; i < end; ++i) {
+			*out++ = HEX_DIGITS[data[i] >> 4];
+			*out++ = HEX_DIGITS[data[i] & 0xf];
+		}
+		current = out;
+	}
+}
+
+/**
+* @brief Writes the bytes of @a str in Base64 (with padding).
+*/
+void JsonWriter::writeBase64(const StringRef &str) {
+	auto data = reinterpret_cast<const unsigned char *>(str.data());
+	std::size_t size = str.size();
+	std::size_t i = 0;
+	while (i + 3 <= size) {
+		// Every three bytes are written as four characters.
+		std::size_t chunkSize = std::min<std::size_t>((size - i) / 3 * 3,
+			OUTPUT_BUFFER_SIZE / 4 * 3);
+		char *out = reserve(chunkSize / 3 * 4);
+		for (std::size_t end = i + chunkSize; i < end; i += 3) {
+			std::uint32_t bits = static_cast<std::uint32_t>(data[i]) << 16 |
+				static_cast<std::uint32_t>(data[i + 1]) << 8 | data[i + 2];
+			*out++ = BASE64_DIGITS[bits >> 18];
+			*out++ = BASE64_DIGITS[bits >> 12 & 0x3f];
+			*out++ = BASE64_DIGITS[bits >> 6 & 0x3f];
+			*out++ = BASE64_DIGITS[bits & 0x3f];
+		}
+		current = out;
+	}
+	if (i < size) {
+		std::uint32_t bits = static_cast<std::uint32_t>(data[i]) << 16;
+		if (i + 1 < size) {
+			bits |= static_cast<std::uint32_t>(data[i + 1]) << 8;
+		}
+		char *out = reserve(4);
+		*out++ = BASE64_DIGITS[bits >> 18];
+		*out++ = BASE64_DIGITS[bits >> 12 & 0x3f];
+		*out++ = i + 1 < size ? BASE64_DIGITS[bits >> 6 & 0x3f] : '=';
+		*out++ = '=';
+		current = out;
+	}
+}
+
+/**
+* @brief Writer of the parts of bencoded data reported by Scanner::walk() as
+*        JSON.
+*/
+class JsonWalkHandler {
+public:
+	explicit JsonWalkHandler(JsonWriter &writer);
+
+	void startDictionary();
+	void startList();
+	void endContainer(bool isDictionary);
+	void key(const StringRef &key);
+	void integer(std::int64_t value);
+	void string(const StringRef &value);
+	void separator();
+
+private:
+	/// Writer of the JSON.
+	JsonWriter &writer;
+};
+
+JsonWalkHandler::JsonWalkHandler(JsonWriter &writer): writer(writer) {}
+
+/**
+* @brief Writes the beginning of an object.
+*/
+void JsonWalkHandler::startDictionary() {
+	writer.writeChar('{');
+}
+
+/**
+* @brief Writes the beginning of an array.
+*/
+void JsonWalkHandler::startList() {
+	writer.writeChar('[');
+}
+
+/**
+* @brief Writes the end of an object or an array.
+*/
+void JsonWalkHandler::endContainer(bool isDictionary) {
+	writer.writeChar(isDictionary ? '}' : ']');
+}
+
+/**
+* @brief Writes the name of an object member.
+*/
+void JsonWalkHandler::key(const StringRef &key) {
+	writer.writeString(key);
+	writer.writeChar(':');
+}
+
+/**
+* @brief Writes a number.
+*/
+void JsonWalkHandler::integer(std::int64_t value) {
+	writer.writeInteger(value);
+}
+
+/**
+* @brief Writes a string.
+*/
+void JsonWalkHandler::string(const StringRef &value) {
+	writer.writeString(value);
+}
+
+/**
+* @brief Writes the separator of two members or elements.
+*/
+void JsonWalkHandler::separator() {
+	writer.writeChar(',');
+}
+
+/**
+* @brief Transcodes @a size bytes of bencoded data starting at @a data into
+*        JSON written by @a writer.
+*
+* The data are scanned iteratively, so the only memory used besides the
+* output buffer is a stack of the types of the currently open containers.
+*/
+void transcodeToJson(const char *data, std::size_t size, JsonWriter &writer) {
+	Scanner scanner(data, size);
+	JsonWalkHandler handler(writer);
+	scanner.walk(handler);
+}
+
+/**
+* @brief Appends the UTF-8 encoding of @a codePoint to @a str.
+*/
+void appendUtf8(std::string &str, std::uint32_t codePoint) {
+	if (codePoint < 0x80) {
+		str += static_cast<char>(codePoint);
+	} else if (codePoint < 0x800) {
+		str += static_cast<char>(0xc0 | codePoint >> 6);
+		str += static_cast<char>(0x80 | (codePoint & 0x3f));
+	} else if (codePoint < 0x10000) {
+		str += static_cast<char>(0xe0 | codePoint >> 12);
+		str += static_cast<char>(0x80 | (codePoint >> 6 & 0x3f));
+		str += static_cast<char>(0x80 | (codePoint & 0x3f));
+	} else {
+		str += static_cast<char>(0xf0 | codePoint >> 18);
+		str += static_cast<char>(0x80 | (codePoint >> 12 & 0x3f));
+		str += static_cast<char>(0x80 | (codePoint >> 6 & 0x3f));
+		str += static_cast<char>(0x80 | (codePoint & 0x3f));
+	}
+}
+
+/**
+* @brief Transcoder of JSON into canonical bencoded data.
+*
+* The JSON is parsed iteratively and the bencoded data are written as they
+* are being created. Keys of dictionaries have to be sorted, so the encoded
+* entries of an object are buffered until the object is closed. When its
+* keys have not been sorted in the JSON, the entries are reordered in place.
+* Everything before the outermost open object is final, so it is written
+* into the output stream (if any) in parts of a bounded size.
+*/
+class BencodeWriterFromJson {
+public:
+	BencodeWriterFromJson(const char *data, std::size_t size,
+		std::ostream *output, std::size_t maxObjectSize);
+
+	void transcode();
+	std::string &encodedData();
+
+private:
+	/// Open array or object.
+	struct Container {
+		/// Is it an object?
+		bool isObject;
+
+		/// Have the keys been sorted so far?
+		bool sorted;
+
+		/// Index of the first entry of the object in @c entries.
+		std::size_t firstEntry;
+	};
+
+	/// Entry of an open object.
+	struct Entry {
+		/// Position of the encoded key.
+		std::size_t start;
+
+		/// Position of the bytes of the key.
+		std::size_t keyStart;
+
+		/// Number of bytes of the key.
+		std::size_t keySize;
+	};
+
+private:
+	void transcodeValue();
+	void transcodeKey();
+	std::size_t transcodeString();
+	void transcodeNumber();
+	void transcodeLiteral(const char *literal, std::int64_t value);
+	void closeContainer();
+	void checkObjectSize() const;
+	void sortEntries(const Container &object);
+	StringRef key(const Entry &entry) const;
+	std::uint32_t readHexCodeUnit();
+	void skipWhitespace();
+	void readExpectedChar(char expectedChar);
+	char peek() const;
+	std::size_t position() const;
+	void flushIfFull();
+
+private:
+	/// Current position in the JSON.
+	const char *current;
+
+	/// End of the JSON.
+	const char *last;
+
+	/// Stream into which the output is written (if any).
+	std::ostream *output;
+
+	/// Maximal size of a buffered object.
+	std::size_t maxObjectSize;
+
+	/// Encoded data that have not been written into the stream.
+	std::string encoded;
+
+	/// Number of bytes that have been written into the stream.
+	std::size_t flushedSize;
+
+	/// Open containers (the innermost one is the last).
+	std::vector<Container> containers;
+
+	/// Entries of the open objects.
+	std::vector<Entry> entries;
+
+	/// Number of the open objects.
+	std::size_t openObjects;
+
+	/// Position of the outermost open object (if any).
+	std::size_t outermostObjectStart;
+
+	/// Is the next item the first one in the innermost open container?
+	bool isFirstItem;
+
+	/// Unescaped bytes of the currently transcoded string.
+	std::string unescaped;
+
+	/// Copy of the entries of an object that is being sorted.
+	std::string sortBuffer;
+
+	/// Indexes of the entries of an object that is being sorted.
+	std::vector<std::size_t> order;
+};
+
+BencodeWriterFromJson::BencodeWriterFromJson(const char *data,
+		std::size_t size, std::ostream *output, std::size_t maxObjectSize):
+	current(data), last(data + size), output(output),
+	maxObjectSize(maxObjectSize), encoded(), flushedSize(0), containers(),
+	entries(), openObjects(0), outermostObjectStart(0), isFirstItem(false),
+	unescaped(), sortBuffer(), order() {}
+
+/**
+* @brief Transcodes the JSON.
+*
+* When there is a stream, the encoded data are written into it. Otherwise,
+* they are available in encodedData().
+*
+* @throws DecodingError When the JSON is malformed, it contains a value not
+*         representable in bencoding, or an object is too large.
+*/
+void BencodeWriterFromJson::transcode() {
+	skipWhitespace();
+	for (;;) {
+		transcodeValue();
+		checkObjectSize();
+
+		// Close finished containers and move to the next value.
+		for (;;) {
+			skipWhitespace();
+			if (containers.empty()) {
+				if (current != last) {
+					throw DecodingError("input contains undecoded characters");
+				}
+				if (output) {
+					output->write(encoded.data(),
+						static_cast<std::streamsize>(encoded.size()));
+					flushedSize += encoded.size();
+					encoded.clear();
+				}
+				return;
+			}
+			if (peek() == (containers.back().isObject ? '}' : ']')) {
+				++current;
+				closeContainer();
+				isFirstItem = false;
+				continue;
+			}
+			if (!isFirstItem) {
+				readExpectedChar(',');
+				skipWhitespace();
+			}
+			isFirstItem = false;
+			if (containers.back().isObject) {
+				transcodeKey();
+				checkObjectSize();
+			}
+			break;
+		}
+		flushIfFull();
+	}
+}
+
+/**
+* @brief Returns the encoded data that have not been written into the
+*        stream.
+*/
+std::string &BencodeWriterFromJson::encodedData() {
+	return encoded;
+}
+
+/**
+* @brief Transcodes a single value.
+*
+* Containers are only opened; their items are transcoded by transcode().
+*/
+void BencodeWriterFromJson::transcodeValue() {
+	switch (peek()) {
+		case '{':
+			++current;
+			if (openObjects++ == 0) {
+				outermostObjectStart = position();
+			}
+			containers.push_back(Container{true, true, entries.size()});
+			encoded += 'd';
+			isFirstItem = true;
+			break;
+		case '[':
+			++current;
+			containers.push_back(Container{false, true, entries.size()});
+			encoded += 'l';
+			isFirstItem = true;
+			break;
+		case '"':
+			transcodeString();
+			break;
+		case 't':
+			transcodeLiteral("true", 1);
+			break;
+		case 'f':
+			transcodeLiteral("false", 0);
+			break;
+		case 'n':
+			throw DecodingError("null cannot be represented in bencoding");
+		default:
+			transcodeNumber();
+			break;
+	}
+}
+
+/**
+* @brief Transcodes a key of an object and the colon after it.
+*
+* @throws DecodingError When the key has already been in the object.
+*/
+void BencodeWriterFromJson::transcodeKey() {
+	Container &object = containers.back();
+	Entry entry{position(), 0, 0};
+	if (peek() != '"') {
+		throw DecodingError("expected a string as a key of an object");
+	}
+	entry.keySize = transcodeString();
+	// The key is at the end of the encoded data.
+	entry.keyStart = position() - entry.keySize;
+
+	if (object.sorted && entries.size() > object.firstEntry) {
+		int order = key(entries.back()).compare(key(entry));
+		if (order == 0) {
+			throw DecodingError("duplicate key: \"" + key(entry).str() + "\"");
+		}
+		object.sorted = order < 0;
+	}
+	entries.push_back(entry);
+
+	skipWhitespace();
+	readExpectedChar(':');
+	skipWhitespace();
+}
+
+/**
+* @brief Transcodes a string and returns the number of its bytes.
+*
+* Escape sequences are replaced with the characters they represent (in
+* UTF-8). Other bytes are copied as they are.
+*/
+std::size_t BencodeWriterFromJson::transcodeString() {
+	readExpectedChar('"');
+	const char *special = current +
+		findSpecialChar(current, last - current, SpecialChars::Escaped);
+	if (special != last && *special == '"') {
+		// There are no escape sequences, so the string is copied at once.
+		std::size_t size = special - current;
+		appendEncodedStringHeader(encoded, size);
+		encoded.append(current, size);
+		current = special + 1;
+		return size;
+	}
+
+	unescaped.assign(current, special);
+	current = special;
+	for (;;) {
+		char c = peek();
+		++current;
+		if (c == '"') {
+			break;
+		} else if (c != '\\') {
+			throw DecodingError("unescaped control character in a string");
+		}
+
+		char escaped = peek();
+		++current;
+		switch (escaped) {
+			case '"': unescaped += '"'; break;
+			case '\\': unescaped += '\\'; break;
+			case '/': unescaped += '/'; break;
+			case 'b': unescaped += '\b'; break;
+			case 'f': unescaped += '\f'; break;
+			case 'n': unescaped += '\n'; break;
+			case 'r': unescaped += '\r'; break;
+			case 't': unescaped += '\t'; break;
+			case 'u': {
+				std::uint32_t codePoint = readHexCodeUnit();
+				if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+					// A high surrogate has to be followed by a low one.
+					readExpectedChar('\\');
+					readExpectedChar('u');
+					std::uint32_t lowSurrogate = readHexCodeUnit();
+					if (lowSurrogate < 0xdc00 || lowSurrogate > 0xdfff) {
+						throw DecodingError("invalid surrogate pair in a string");
+					}
+					codePoint = 0x10000 + ((codePoint - 0xd800) << 10) +
+						(lowSurrogate - 0xdc00);
+				} else if (codePoint >= 0xdc00 && codePoint <= 0xdfff) {
+					throw DecodingError("invalid surrogate pair in a string");
+				}
+				appendUtf8(unescaped, codePoint);
+				break;
+			}
+			default:
+				throw DecodingError(std::string("invalid escape sequence: \\") +
+					escaped);
+		}
+
+		special = current +
+		findSpecialChar(current, last - current, SpecialChars::Escaped);
+		unescaped.append(current, special);
+		current = special;
+	}
+
+	appendEncodedStringHeader(encoded, unescaped.size());
+	encoded += unescaped;
+	return unescaped.size();
+}
+
+/**
+* @brief Transcodes a number.
+*
+* @throws DecodingError When the number is not an integer or it does not fit
+*         into 64 bits.
+*/
+void BencodeWriterFromJson::transcodeNumber() {
+	bool negative = false;
+	if (peek() == '-') {
+		negative = true;
+		++current;
+	}
+	if (peek() < '0' || peek() > '9') {
+		throw DecodingError(std::string("unexpected character: '") +
+			*current + "'");
+	}
+	if (*current == '0' && current + 1 != last && current[1] >= '0' &&
+			current[1] <= '9') {
+		throw DecodingError("number contains leading zeros");
+	}
+
+	std::int64_t value;
+	const char *end = readDecimalDigits(current, last, negative, value);
+	if (!end) {
+		throw DecodingError("number does not fit into 64 bits");
+	}
+	current = end;
+	if (current != last && (*current == '.' || *current == 'e' ||
+			*current == 'E')) {
+		throw DecodingError("only integers can be represented in bencoding");
+	}
+
+	// -0 is written as 0 (bencoding does not allow i-0e).
+	appendEncodedInteger(encoded, value);
+}
+
+/**
+* @brief Transcodes @a literal (@c true or @c false) as an integer with the
+*        given @a value.
+*/
+void BencodeWriterFromJson::transcodeLiteral(const char *literal,
+		std::int64_t value) {
+	for (; *literal != '\0'; ++literal) {
+		readExpectedChar(*literal);
+	}
+	appendEncodedInteger(encoded, value);
+}
+
+/**
+* @brief Closes the innermost open container.
+*/
+void BencodeWriterFromJson::closeContainer() {
+	const Container &container = containers.back();
+	if (container.isObject) {
+		if (!container.sorted) {
+			sortEntries(container);
+		}
+		entries.resize(container.firstEntry);
+		--openObjects;
+	}
+	encoded += 'e';
+	containers.pop_back();
+}
+
+/**
+* @brief Throws DecodingError when the outermost open object is larger than
+*        @c maxObjectSize.
+*
+* The outermost open object is buffered until it is closed (including the
+* arrays and objects in it), so its size is checked after every value and
+* key, not only when a new key of the innermost object starts.
+*/
+void BencodeWriterFromJson::checkObjectSize() const {
+	if (openObjects != 0 && position() - outermostObjectStart > maxObjectSize) {
+		throw DecodingError("object is larger than " +
+			std::to_string(maxObjectSize) + " bytes");
+	}
+}
+
+/**
+* @brief Reorders the encoded entries of @a object so that they are sorted by
+*        their keys.
+*
+* @throws DecodingError When there are duplicate keys.
+*/
+void BencodeWriterFromJson::sortEntries(const Container &object) {
+	order.clear();
+	for (std::size_t i = object.firstEntry; i < entries.size(); ++i) {
+		order.push_back(i);
+	}
+	std::sort(order.begin(), order.end(),
+		[this](std::size_t lhs, std::size_t rhs) {
+			return key(entries[lhs]) < key(entries[rhs]);
+		});
+	for (std::size_t i = 1; i < order.size(); ++i) {
+		if (key(entries[order[i - 1]]) == key(entries[order[i]])) {
+			throw DecodingError("duplicate key: \"" +
+				key(entries[order[i]]).str() + "\"");
+		}
+	}
+
+	// The entries are copied aside and written back in the sorted order. An
+	// entry ends where the next one starts (the last one at the end of the
+	// data).
+	std::size_t regionStart = entries[object.firstEntry].start - flushedSize;
+	sortBuffer.assign(encoded, regionStart, std::string::npos);
+	char *out = &encoded[regionStart];
+	for (std::size_t index : order) {
+		std::size_t start = entries[index].start - flushedSize;
+		std::size_t end = index + 1 < entries.size() ?
+			entries[index + 1].start - flushedSize : encoded.size();
+		std::memcpy(out, sortBuffer.data() + (start - regionStart),
+			end - start);
+		out += end - start;
+	}
+}
+
+/**
+* @brief Returns the bytes of the key of @a entry.
+*/
+StringRef BencodeWriterFromJson::key(const Entry &entry) const {
+	return StringRef(encoded.data() + (entry.keyStart - flushedSize),
+		entry.keySize);
+}
+
+/**
+* @brief Reads four hex digits of a @c \\u escape sequence.
+*/
+std::uint32_t BencodeWriterFromJson::readHexCodeUnit() {
+	std::uint32_t codeUnit = 0;
+	for (int i = 0; i < 4; ++i) {
+		char c = peek();
+		std::uint32_t digit;
+		if (c >= '0' && c <= '9') {
+			digit = static_cast<std::uint32_t>(c - '0');
+		} else if (c >= 'a' && c <= 'f') {
+			digit = static_cast<std::uint32_t>(c - 'a' + 10);
+		} else if (c >= 'A' && c <= 'F') {
+			digit = static_cast<std::uint32_t>(c - 'A' + 10);
+		} else {
+			throw DecodingError("invalid \\u escape sequence");
+		}
+		codeUnit = codeUnit << 4 | digit;
+		++current;
+	}
+	return codeUnit;
+}
+
+/**
+* @brief Skips whitespace between JSON tokens.
+*/
+void BencodeWriterFromJson::skipWhitespace() {
+	while (current != last && (*current == ' ' || *current == '\n' ||
+			*current == '\r' || *current == '\t')) {
+		++current;
+	}
+}
+
+/**
+* @brief Reads @a expectedChar.
+*
+* @throws DecodingError When the next character is not @a expectedChar.
+*/
+void BencodeWriterFromJson::readExpectedChar(char expectedChar) {
+	if (peek() != expectedChar) {
+		throw DecodingError(std::string("expected '") + expectedChar +
+			"', got '" + *current + "'");
+	}
+	++current;
+}
+
+/**
+* @brief Returns the next character of the JSON without reading it.
+*
+* @throws DecodingError When the whole JSON has been read.
+*/
+char BencodeWriterFromJson::peek() const {
+	if (current == last) {
+		throw DecodingError("unexpected end of data");
+	}
+	return *current;
+}
+
+/**
+* @brief Returns the number of bytes of the encoded data (including those
+*        written into the stream).
+*/
+std::size_t BencodeWriterFromJson::position() const {
+	return flushedSize + encoded.size();
+}
+
+/**
+* @brief Writes the final encoded data into the stream (if any) when there
+*        are enough of them.
+*
+* The data of open objects are not final as their entries may be reordered.
+*/
+void BencodeWriterFromJson::flushIfFull() {
+	if (!output || encoded.size() < OUTPUT_BUFFER_SIZE) {
+		return;
+	}
+
+	std::size_t finalSize = openObjects != 0 ?
+		outermostObjectStart - flushedSize : encoded.size();
+	if (finalSize >= OUTPUT_BUFFER_SIZE) {
+		output->write(encoded.data(), static_cast<std::streamsize>(finalSize));
+		encoded.erase(0, finalSize);
+		flushedSize += finalSize;
+	}
+}
+
+} // anonymous namespace
+
+/**
+* @brief Transcodes @a size bytes of bencoded data starting at @a data into
+*        JSON written into @a output.
+*
+* @param[in] data Bencoded data.
+* @param[in] size Size of the data.
+* @param[in] output Stream into which compact JSON is written.
+* @param[in] binaryStrings Representation of strings that are not valid UTF-8.
+*
+* Dictionaries are written as objects (their keys are strings), lists as
+* arrays, integers as numbers, and strings as strings. No BItem is created;
+* the data are scanned and the JSON is written in parts of a bounded size as
+* it is being created.
+*
+* @throws DecodingError When the data are malformed or there are characters
+*         after them. The part of the JSON written before the error is found
+*         may have been written into @a output.
+*/
+void bencodeToJson(const char *data, std::size_t size, std::ostream &output,
+		JsonBinaryStrings binaryStrings) {
+	JsonWriter writer(&output, nullptr, binaryStrings);
+	transcodeToJson(data, size, writer);
+	writer.flush();
+}
+
+/**
+* @brief Transcodes bencoded @a data into JSON written into @a output.
+*
+* See bencodeToJson(const char *, std::size_t, std::ostream &,
+* JsonBinaryStrings) for more details.
+*/
+void bencodeToJson(const std::string &data, std::ostream &output,
+		JsonBinaryStrings binaryStrings) {
+	bencodeToJson(data.data(), data.size(), output, binaryStrings);
+}
+
+/**
+* @brief Transcodes bencoded @a data into JSON and returns it.
+*
+* See bencodeToJson(const char *, std::size_t, std::ostream &,
+* JsonBinaryStrings) for more details.
+*/
+std::string bencodeToJson(const std::string &data,
+		JsonBinaryStrings binaryStrings) {
+	std::string json;
+	JsonWriter writer(nullptr, &json, binaryStrings);
+	transcodeToJson(data.data(), data.size(), writer);
+	writer.flush();
+	return json;
+}
+
+/**
+* @brief Transcodes @a size bytes of JSON starting at @a data into canonical
+*        bencoded data written into @a output.
+*
+* @param[in] data JSON.
+* @param[in] size Size of the JSON.
+* @param[in] output Stream into which the bencoded data are written.
+* @param[in] maxObjectSize Maximal size of an encoded object.
+*
+* Objects are encoded as dictionaries with sorted keys, arrays as lists,
+* strings as strings (in UTF-8), integers as integers, and @c true and
+* @c false as integers @c 1 and @c 0. No BItem is created.
+*
+* The encoded entries of an object are buffered until the object is closed
+* because its keys may have to be reordered. Therefore, the memory used is
+* bounded by the size of the largest object, which is limited by
+* @a maxObjectSize. Other data are written in parts of a bounded size.
+*
+* @throws DecodingError When the JSON is malformed, it contains @c null or a
+*         number that is not a 64-bit integer, an object contains duplicate
+*         keys, or an object is larger than @a maxObjectSize. The part of
+*         the bencoded data written before the error is found may have been
+*         written into @a output.
+*/
+void jsonToBencode(const char *data, std::size_t size, std::ostream &output,
+		std::size_t maxObjectSize) {
+	BencodeWriterFromJson writer(data, size, &output, maxObjectSize);
+	writer.transcode();
+}
+
+/**
+* @brief Transcodes @a json into canonical bencoded data written into
+*        @a output.
+*
+* See jsonToBencode(const char *, std::size_t, std::ostream &, std::size_t)
+* for more details.
+*/
+void jsonToBencode(const std::string &json, std::ostream &output,
+		std::size_t maxObjectSize) {
+	jsonToBencode(json.data(), json.size(), output, maxObjectSize);
+}
+
+/**
+* @brief Transcodes @a json into canonical bencoded data and returns them.
+*
+* See jsonToBencode(const char *, std::size_t, std::ostream &, std::size_t)
+* for more details.
+*/
+std::string jsonToBencode(const std::string &json, std::size_t maxObjectSize) {
+	BencodeWriterFromJson writer(json.data(), json.size(), nullptr,
+		maxObjectSize);
+	writer.transcode();
+	return std::move(writer.encodedData());
+}
+
+} // namespace bencoding
@@ -0,0 +1,441 @@
+/**
+* @file      Krpc.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the codec of KRPC messages.
+*/
+
+#include "Krpc.h"
+
+#include <stdexcept>
+
+#include "Decoder.h"
+#include "FixedString.h"
+
+namespace bencoding {
+
+const std::size_t KrpcMessage::MAX_ARGUMENTS;
+const std::size_t KrpcMessage::MAX_SIZE;
+
+namespace {
+
+/**
+* @brief Decodes the value of an argument.
+*/
+KrpcValue decodeValue(Scanner &scanner) {
+	char c = scanner.peek();
+	if (c == 'i') {
+		return KrpcValue::integer(scanner.readInteger());
+	} else if (c >= '0' && c <= '9') {
+		return KrpcValue::string(scanner.readString());
+	}
+	return KrpcValue::encoded(scanner.skipItem());
+}
+
+/**
+* @brief Decodes the arguments (or return values) of a message.
+*/
+void decodeArguments(Scanner &scanner, KrpcMessage &message) {
+	message.clearArguments();
+	scanner.enterDictionary();
+	while (!scanner.atContainerEnd()) {
+		if (message.numOfArguments() == KrpcMessage::MAX_ARGUMENTS) {
+			throw DecodingError("KRPC message has too many arguments");
+		}
+		StringRef key(scanner.readString());
+		if (message.find(key)) {
+			throw DecodingError("KRPC message has a duplicate argument");
+		}
+		message.addArgument(key, decodeValue(scanner));
+	}
+	scanner.leaveContainer();
+}
+
+/**
+* @brief Decodes the code and the message of an error.
+*/
+void decodeError(Scanner &scanner, KrpcMessage &message) {
+	scanner.enterList();
+	message.errorCode = scanner.readInteger();
+	message.errorMessage = scanner.readString();
+	if (!scanner.atContainerEnd()) {
+		throw DecodingError("KRPC error has more than two items");
+	}
+	scanner.leaveContainer();
+}
+
+/**
+* @brief Returns the type of a message from the value of its @c y key.
+*/
+KrpcMessage::Type toMessageType(const StringRef &type) {
+	if (type.size() == 1) {
+		switch (type.data()[0]) {
+			case 'q': return KrpcMessage::Type::Query;
+			case 'r': return KrpcMessage::Type::Response;
+			case 'e': return KrpcMessage::Type::Error;
+			default: break;
+		}
+	}
+	throw DecodingError("KRPC message has an invalid type");
+}
+
+/**
+* @brief Writes a value of an argument.
+*/
+void encodeValue(const KrpcValue &value, EncodedWriter &writer) {
+	switch (value.kind()) {
+		case KrpcValue::Kind::Integer:
+			writer.writeInteger(value.integerValue());
+			break;
+		case KrpcValue::Kind::Encoded:
+			writer.writeBytes(value.str().data(), value.str().size());
+			break;
+		default:
+			writer.writeString(value.str());
+			break;
+	}
+}
+
+/**
+* @brief Writes the arguments of @a message as a dictionary with sorted keys.
+*/
+void encodeArguments(const KrpcMessage &message, EncodedWriter &writer) {
+	// Sort the indexes of the arguments by an insertion sort, which is the
+	// fastest one for the few arguments a message has.
+	std::size_t order[KrpcMessage::MAX_ARGUMENTS];
+	std::size_t numOfArguments = message.numOfArguments();
+	for (std::size_t i = 0; i < numOfArguments; ++i) {
+		std::size_t j = i;
+		const StringRef &key(message.argument(i).key);
+		for (; j > 0 && key < message.argument(order[j - 1]).key; --j) {
+			order[j] = order[j - 1];
+		}
+		order[j] = i;
+	}
+
+	writer.write(fixedString("d"));
+	for (std::size_t i = 0; i < numOfArguments; ++i) {
+		const KrpcArgument &argument(message.argument(order[i]));
+		writer.writeString(argument.key);
+		encodeValue(argument.value, writer);
+	}
+	writer.write(fixedString("e"));
+}
+
+} // anonymous namespace
+
+/**
+* @brief Constructs an empty string value.
+*/
+KrpcValue::KrpcValue(): valueKind(Kind::String), bytes(), number(0) {}
+
+/**
+* @brief Creates a string value referring to @a str.
+*/
+KrpcValue KrpcValue::string(const StringRef &str) {
+	KrpcValue value;
+	value.bytes = str;
+	return value;
+}
+
+/**
+* @brief Creates an integer value.
+*/
+KrpcValue KrpcValue::integer(std::int64_t value) {
+	KrpcValue newValue;
+	newValue.valueKind = Kind::Integer;
+	newValue.number = value;
+	return newValue;
+}
+
+/**
+* @brief Creates a value referring to the bencoded @a encodedValue.
+*
+* The value is written as it is when the message is encoded.
+*/
+KrpcValue KrpcValue::encoded(const StringRef &encodedValue) {
+	KrpcValue value;
+	value.valueKind = Kind::Encoded;
+	value.bytes = encodedValue;
+	return value;
+}
+
+/**
+* @brief Returns the kind of the value.
+*/
+KrpcValue::Kind KrpcValue::kind() const {
+	return valueKind;
+}
+
+/**
+* @brief Is the value a string?
+*/
+bool KrpcValue::isString() const {
+	return valueKind == Kind::String;
+}
+
+/**
+* @brief Is the value an integer?
+*/
+bool KrpcValue::isInteger() const {
+	return valueKind == Kind::Integer;
+}
+
+/**
+* @brief Returns the string, or the encoded value for values of the
+*        @c Encoded kind.
+*
+* For integers, an empty reference is returned.
+*/
+StringRef KrpcValue::str() const {
+	return bytes;
+}
+
+/**
+* @brief Returns the integer, or @c 0 if the value is not an integer.
+*/
+std::int64_t KrpcValue::integerValue() const {
+	return number;
+}
+
+/**
+* @brief Constructs a query without a method, arguments, and transaction ID.
+*/
+KrpcMessage::KrpcMessage():
+	type(Type::Query), transactionId(), method(), version(), errorCode(0),
+	errorMessage(), arguments(), argumentCount(0) {}
+
+/**
+* @brief Returns the number of arguments.
+*/
+std::size_t KrpcMessage::numOfArguments() const {
+	return argumentCount;
+}
+
+/**
+* @brief Returns the argument at @a index.
+*
+* @par Preconditions
+*  - <tt>index < numOfArguments()</tt>
+*/
+const KrpcArgument &KrpcMessage::argument(std::size_t index) const {
+	return arguments[index];
+}
+
+/**
+* @brief Returns the value of the argument named @a key, or the null pointer
+*        if there is no such argument.
+*/
+const KrpcValue *KrpcMessage::find(const StringRef &key) const {
+	for (std::size_t i = 0; i < argumentCount; ++i) {
+		if (arguments[i].key == key) {
+			return &arguments[i].value;
+		}
+	}
+	return nullptr;
+}
+
+/**
+* @brief Stores the value of the string argument named @a key into @a str.
+*
+* @return @c true if there is such an argument, @c false otherwise (@a str is
+*         left unchanged).
+*/
+bool KrpcMessage::getString(const StringRef &key, StringRef &str) const {
+	const KrpcValue *value = find(key);
+	if (!value || !value->isString()) {
+		return false;
+	}
+	str = value->str();
+	return true;
+}
+
+/**
+* @brief Stores the value of the integer argument named @a key into @a value.
+*
+* @return @c true if there is such an argument, @c false otherwise (@a value
+*         is left unchanged).
+*/
+bool KrpcMessage::getInteger(const StringRef &key, std::int64_t &value) const {
+	const KrpcValue *foundValue = find(key);
+	if (!foundValue || !foundValue->isInteger()) {
+		return false;
+	}
+	value = foundValue->integerValue();
+	return true;
+}
+
+/**
+* @brief Adds an argument.
+*
+* The arguments do not have to be added in any particular order; they are
+* sorted when the message is encoded.
+*
+* @throws std::length_error When there are already MAX_ARGUMENTS arguments.
+*/
+void KrpcMessage::addArgument(const StringRef &key, const KrpcValue &value) {
+	if (argumentCount == MAX_ARGUMENTS) {
+		throw std::length_error("KRPC message has too many arguments");
+	}
+	arguments[argumentCount].key = key;
+	arguments[argumentCount].value = value;
+	++argumentCount;
+}
+
+/**
+* @brief Removes all arguments.
+*/
+void KrpcMessage::clearArguments() {
+	argumentCount = 0;
+}
+
+/**
+* @brief Decodes a KRPC message from @a size bytes starting at @a data.
+*
+* The returned message refers into @a data, so @a data have to outlive it.
+* Nothing is allocated unless the message is invalid.
+*
+* Keys of the message other than @c a, @c e, @c q, @c r, @c t, @c v, and @c y
+* are ignored.
+*
+* @throws DecodingError When the message is malformed, is larger than
+*         KrpcMessage::MAX_SIZE bytes, has more than KrpcMessage::MAX_ARGUMENTS
+*         arguments, or lacks a key required by its type.
+*/
+KrpcMessage decodeKrpcMessage(const char *data, std::size_t size) {
+	if (size > KrpcMessage::MAX_SIZE) {
+		throw DecodingError("KRPC message is too large");
+	}
+
+	KrpcMessage message;
+	bool hasType = false;
+	bool hasTransactionId = false;
+	bool hasArguments = false;
+	bool hasReturnValues = false;
+	bool hasError = false;
+	Scanner scanner(data, size);
+	scanner.enterDictionary();
+	while (!scanner.atContainerEnd()) {
+		StringRef key(scanner.readString());
+		if (key.size() != 1) {
+			scanner.skipItem();
+			continue;
+		}
+
+		switch (key.data()[0]) {
+			case 'a':
+				decodeArguments(scanner, message);
+				hasArguments = true;
+				break;
+			case 'e':
+				decodeError(scanner, message);
+				hasError = true;
+				break;
+			case 'q':
+				message.method = scanner.readString();
+				break;
+			case 'r':
+				decodeArguments(scanner, message);
+				hasReturnValues = true;
+				break;
+			case 't':
+				message.transactionId = scanner.readString();
+				hasTransactionId = true;
+				break;
+			case 'v':
+				message.version = scanner.readString();
+				break;
+			case 'y':
+				message.type = toMessageType(scanner.readString());
+				hasType = true;
+				break;
+			default:
+				scanner.skipItem();
+				break;
+		}
+	}
+	scanner.leaveContainer();
+	if (!scanner.atEnd()) {
+		throw DecodingError("KRPC message is followed by other data");
+	}
+
+	if (!hasType || !hasTransactionId) {
+		throw DecodingError("KRPC message lacks its type or transaction ID");
+	} else if (hasArguments && hasReturnValues) {
+		throw DecodingError("KRPC message has both arguments and return values");
+	}
+	switch (message.type) {
+		case KrpcMessage::Type::Query:
+			if (message.method.empty() || !hasArguments) {
+				throw DecodingError("KRPC query lacks its method or arguments");
+			}
+			break;
+		case KrpcMessage::Type::Response:
+			if (!hasReturnValues) {
+				throw DecodingError("KRPC response lacks its return values");
+			}
+			break;
+		default:
+			if (!hasError) {
+				throw DecodingError("KRPC error lacks its code and message");
+			}
+			break;
+	}
+	return message;
+}
+
+/**
+* @brief Decodes a KRPC message from @a data.
+*
+* See decodeKrpcMessage(const char *, std::size_t) for more details.
+*/
+KrpcMessage decodeKrpcMessage(const std::string &data) {
+	return decodeKrpcMessage(data.data(), data.size());
+}
+
+/**
+* @brief Writes the encoded @a message by using @a writer.
+*
+* The keys are written in the sorted order, including the arguments, so the
+* result is canonical. Queries are written with their arguments, responses
+* with their return values, and errors only with their code and message.
+*
+* Whether the message has fit into the buffer can be checked by
+* EncodedWriter::overflowed().
+*/
+void encodeKrpcMessage(const KrpcMessage &message, EncodedWriter &writer) {
+	writer.write(fixedString("d"));
+	if (message.type == KrpcMessage::Type::Query) {
+		writer.write(encodedString("a"));
+		encodeArguments(message, writer);
+	} else if (message.type == KrpcMessage::Type::Error) {
+		writer.write(encodedString("e") + fixedString("l"))
+			.writeInteger(message.errorCode)
+			.writeString(message.errorMessage)
+			.write(fixedString("e"));
+	}
+	if (message.type == KrpcMessage::Type::Query) {
+		writer.write(encodedString("q")).writeString(message.method);
+	} else if (message.type == KrpcMessage::Type::Response) {
+		writer.write(encodedString("r"));
+		encodeArguments(message, writer);
+	}
+	writer.write(encodedString("t")).writeString(message.transactionId);
+	if (!message.version.empty()) {
+		writer.write(encodedString("v")).writeString(message.version);
+	}
+	switch (message.type) {
+		case KrpcMessage::Type::Query:
+			writer.write(encodedString("y") + encodedString("q"));
+			break;
+		case KrpcMessage::Type::Response:
+			writer.write(encodedString("y") + encodedString("r"));
+			break;
+		default:
+			writer.write(encodedString("y") + encodedString("e"));
+			break;
+	}
+	writer.write(fixedString("e"));
+}
+
+} // namespace bencoding
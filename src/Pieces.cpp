@@ -0,0 +1,341 @@
+/**
+* @file      Pieces.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the access to piece hashes and of the
+*            verification of downloaded pieces.
+*/
+
+#include "Pieces.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include "BString.h"
+#include "Decoder.h"
+#include "Sha.h"
+
+namespace bencoding {
+
+const std::size_t PieceHashes::V1_HASH_SIZE;
+const std::size_t PieceHashes::V2_HASH_SIZE;
+
+namespace {
+
+/// Number of consecutive pieces claimed by a verifying thread at once (so
+/// that the threads read the files mostly sequentially).
+const std::size_t PIECES_PER_BATCH = 4;
+
+/// Maximal size of the buffer of a verifying thread. Longer pieces are read
+/// and hashed in chunks, so the piece length from a torrent does not
+/// determine how much memory is allocated.
+const std::size_t MAX_BUFFER_SIZE = 1 << 20;
+
+/**
+* @brief Reader of the payload of a torrent as if it was a single file.
+*
+* Every verifying thread has its own reader.
+*/
+class PayloadReader {
+public:
+	PayloadReader(const std::vector<PayloadFile> &files,
+		const std::vector<std::uint64_t> &fileOffsets);
+
+	bool read(std::uint64_t offset, char *buffer, std::size_t size);
+
+private:
+	bool openFile(std::size_t index);
+
+private:
+	/// Files of the payload.
+	const std::vector<PayloadFile> &files;
+
+	/// Offsets of the files in the payload (with the total size at the end).
+	const std::vector<std::uint64_t> &fileOffsets;
+
+	/// The currently opened file.
+	std::ifstream file;
+
+	/// Index of the currently opened file.
+	std::size_t openedFileIndex;
+};
+
+PayloadReader::PayloadReader(const std::vector<PayloadFile> &files,
+		const std::vector<std::uint64_t> &fileOffsets):
+	files(files), fileOffsets(fileOffsets), file(),
+	openedFileIndex(files.size()) {}
+
+/**
+* @brief Reads @a size bytes starting at @a offset of the payload into
+*        @a buffer.
+*
+* @return @c true if all the bytes have been read, @c false otherwise (e.g.
+*         when a file is missing or is shorter than expected).
+*/
+bool PayloadReader::read(std::uint64_t offset, char *buffer, std::size_t size) {
+	// The file containing the offset is the last one starting at or before
+	// it.
+	std::size_t index = static_cast<std::size_t>(std::upper_bound(
+		fileOffsets.begin(), fileOffsets.end() - 1, offset) -
+		fileOffsets.begin()) - 1;
+	while (size > 0) {
+		if (index >= files.size()) {
+			return false;
+		}
+		std::uint64_t position = offset - fileOffsets[index];
+		std::uint64_t available = files[index].length - position;
+		std::size_t toRead = available < size ? available : size;
+		if (toRead > 0) {
+			if (!openFile(index)) {
+				return false;
+			}
+			file.seekg(static_cast<std::streamoff>(position));
+			file.read(buffer, static_cast<std::streamsize>(toRead));
+			if (static_cast<std::size_t>(file.gcount()) != toRead) {
+				// Force reopening to clear the state of the stream.
+				openedFileIndex = files.size();
+				return false;
+			}
+		}
+		buffer += toRead;
+		size -= toRead;
+		offset += toRead;
+		++index;
+	}
+	return true;
+}
+
+/**
+* @brief Makes the file with the given @a index the currently opened one.
+*/
+bool PayloadReader::openFile(std::size_t index) {
+	if (index == openedFileIndex) {
+		return true;
+	}
+	file.close();
+	file.clear();
+	file.open(files[index].path, std::ios::in | std::ios::binary);
+	openedFileIndex = file ? index : files.size();
+	return file.good();
+}
+
+/**
+* @brief Reads @a size bytes starting at @a offset of the payload in chunks of
+*        the size of @a buffer and stores their SHA-1 hash into @a digest.
+*
+* @return @c true if all the bytes have been read, @c false otherwise.
+*/
+bool hashPayloadRange(PayloadReader &reader, std::uint64_t offset,
+		std::uint64_t size, std::vector<char> &buffer, std::string &digest) {
+	Sha1 sha;
+	while (size > 0) {
+		std::size_t chunkSize = std::min<std::uint64_t>(size, buffer.size());
+		if (!reader.read(offset, buffer.data(), chunkSize)) {
+			return false;
+		}
+		sha.update(buffer.data(), chunkSize);
+		offset += chunkSize;
+		size -= chunkSize;
+	}
+	digest = sha.digest();
+	return true;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Constructs a view of @a hashes consisting of digests of @a hashSize
+*        bytes.
+*
+* @throws DecodingError When the size of @a hashes is not a multiple of
+*         @a hashSize.
+*/
+PieceHashes::PieceHashes(const StringRef &hashes, std::size_t hashSize):
+		hashes(hashes), singleHashSize(hashSize) {
+	if (hashSize == 0 || hashes.size() % hashSize != 0) {
+		throw DecodingError("size of piece hashes (" +
+			std::to_string(hashes.size()) + ") is not a multiple of " +
+			std::to_string(hashSize));
+	}
+}
+
+/**
+* @brief Constructs a view of the value of @a hashes consisting of digests of
+*        @a hashSize bytes.
+*
+* The view refers to the current value of @a hashes, so the value must not be
+* changed while the view is used.
+*
+* @throws DecodingError When the size of @a hashes is not a multiple of
+*         @a hashSize.
+*/
+PieceHashes::PieceHashes(const BString &hashes, std::size_t hashSize):
+	PieceHashes(StringRef(*hashes.value()), hashSize) {}
+
+/**
+* @brief Returns the number of hashes.
+*/
+std::size_t PieceHashes::size() const {
+	return hashes.size() / singleHashSize;
+}
+
+/**
+* @brief Returns @c true if there are no hashes, @c false otherwise.
+*/
+bool PieceHashes::empty() const {
+	return hashes.empty();
+}
+
+/**
+* @brief Returns the size of a single hash.
+*/
+std::size_t PieceHashes::hashSize() const {
+	return singleHashSize;
+}
+
+/**
+* @brief Returns the hash of the piece with the given @a index.
+*
+* @par Preconditions
+*  - <tt>index < size()</tt>
+*/
+StringRef PieceHashes::operator[](std::size_t index) const {
+	return StringRef(hashes.data() + index * singleHashSize, singleHashSize);
+}
+
+/**
+* @brief Returns a pointer to the first byte of the first hash.
+*
+* The hashes are stored contiguously.
+*/
+const char *PieceHashes::data() const {
+	return hashes.data();
+}
+
+/**
+* @brief Returns @c true if the hash of the piece with the given @a index is
+*        @a digest, @c false otherwise.
+*
+* @par Preconditions
+*  - <tt>index < size()</tt>
+*/
+bool PieceHashes::matches(std::size_t index,
+		const std::string &digest) const {
+	return (*this)[index] == StringRef(digest);
+}
+
+/**
+* @brief Verifies pieces of the payload stored in @a files against @a hashes.
+*
+* @param[in] files Files of the payload in the order of the torrent.
+* @param[in] pieceLength Length of a piece (the @c piece length key).
+* @param[in] hashes SHA-1 hashes of the pieces (the @c pieces key).
+* @param[in] numOfThreads Number of threads hashing the pieces. When it is
+*                         @c 0, the number of hardware threads is used.
+*
+* @return For every piece, @c true if it is complete and its hash matches,
+*         @c false otherwise. Pieces that cannot be read (e.g. because a file
+*         is missing) are not valid.
+*
+* The pieces are hashed in parallel. Each thread claims a few consecutive
+* pieces at once, so the files are read mostly sequentially. Every thread
+* reads the pieces into a buffer of at most 1 MiB, regardless of the piece
+* length.
+*
+* @throws std::invalid_argument When the hashes are not SHA-1 hashes, the
+*         piece length is zero, or the number of hashes does not correspond
+*         to the size of the payload.
+*/
+std::vector<bool> verifyPieces(const std::vector<PayloadFile> &files,
+		std::uint64_t pieceLength, const PieceHashes &hashes,
+		unsigned numOfThreads) {
+	if (hashes.hashSize() != PieceHashes::V1_HASH_SIZE) {
+		throw std::invalid_argument("only SHA-1 piece hashes can be verified");
+	} else if (pieceLength == 0) {
+		throw std::invalid_argument("invalid piece length");
+	}
+
+	std::vector<std::uint64_t> fileOffsets(1, 0);
+	for (const auto &file : files) {
+		fileOffsets.push_back(fileOffsets.back() + file.length);
+	}
+	std::uint64_t payloadSize = fileOffsets.back();
+	std::uint64_t numOfPieces = (payloadSize + pieceLength - 1) / pieceLength;
+	if (numOfPieces != hashes.size()) {
+		throw std::invalid_argument("the number of piece hashes (" +
+			std::to_string(hashes.size()) + ") does not match the size of " +
+			"the payload (" + std::to_string(numOfPieces) + " pieces)");
+	}
+
+	if (numOfThreads == 0) {
+		numOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	numOfThreads = static_cast<unsigned>(std::min<std::size_t>(numOfThreads,
+		(hashes.size() + PIECES_PER_BATCH - 1) / PIECES_PER_BATCH));
+
+	// Every piece has its own byte so that the threads never write into the
+	// same memory location (std::vector<bool> packs its values into words).
+	std::vector<char> results(hashes.size(), 0);
+	// The buffers are allocated before the threads are started so that a
+	// failed allocation does not happen in a thread.
+	std::size_t bufferSize = std::min<std::uint64_t>(
+		std::min(pieceLength, payloadSize), MAX_BUFFER_SIZE);
+	std::vector<std::vector<char>> buffers(numOfThreads,
+		std::vector<char>(bufferSize));
+	std::vector<std::exception_ptr> errors(numOfThreads);
+	std::atomic<std::size_t> nextPiece(0);
+	auto verify = [&](unsigned threadIndex) {
+		try {
+			PayloadReader reader(files, fileOffsets);
+			std::vector<char> &buffer = buffers[threadIndex];
+			std::string digest;
+			for (;;) {
+				std::size_t first = nextPiece.fetch_add(PIECES_PER_BATCH);
+				if (first >= hashes.size()) {
+					return;
+				}
+				std::size_t last = std::min(first + PIECES_PER_BATCH,
+					hashes.size());
+				for (std::size_t i = first; i < last; ++i) {
+					std::uint64_t offset = i * pieceLength;
+					std::uint64_t size = std::min(pieceLength, payloadSize - offset);
+					if (hashPayloadRange(reader, offset, size, buffer, digest)) {
+						results[i] = hashes.matches(i, digest);
+					}
+				}
+			}
+		} catch (...) {
+			errors[threadIndex] = std::current_exception();
+			// Stop the other threads.
+			nextPiece = hashes.size();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	try {
+		for (unsigned i = 1; i < numOfThreads; ++i) {
+			threads.emplace_back(verify, i);
+		}
+	} catch (...) {
+		// Threads cannot be created, so let the started ones finish and do
+		// the rest in this thread.
+	}
+	if (numOfThreads > 0) {
+		verify(0);
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	for (const auto &error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+	return std::vector<bool>(results.begin(), results.end());
+}
+
+} // namespace bencoding
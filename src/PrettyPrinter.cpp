@@ -7,6 +7,9 @@
 
 #include "PrettyPrinter.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include "BDictionary.h"
 #include "BInteger.h"
 #include "BList.h"
@@ -15,6 +18,61 @@
 
 namespace bencoding {
 
+namespace {
+
+/// Number of bytes of binary strings shown in summaries.
+const std::size_t SUMMARY_SIZE = 8;
+
+/**
+* @brief Appends @a size bytes starting at @a data to @a out with the
+*        characters that need it escaped.
+*
+* Runs of characters without escaping are appended at once.
+*/
+void appendEscaped(std::string &out, const char *data, std::size_t size) {
+	for (;;) {
+		std::size_t length = findSpecialChar(data, size,
+			SpecialChars::EscapedOrDel);
+		out.append(data, length);
+		if (length == size) {
+			return;
+		}
+
+		unsigned char c = static_cast<unsigned char>(data[length]);
+		switch (c) {
+			case '"': out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\t': out += "\\t"; break;
+			case '\r': out += "\\r"; break;
+			default: {
+				const char escaped[] = {
+					'\\', 'x', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xf]
+				};
+				out.append(escaped, sizeof(escaped));
+				break;
+			}
+		}
+		data += length + 1;
+		size -= length + 1;
+	}
+}
+
+/**
+* @brief Appends @a size bytes starting at @a data to @a out in hex.
+*/
+void appendHex(std::string &out, const char *data, std::size_t size) {
+	std::size_t start = out.size();
+	out.resize(start + 2 * size);
+	for (std::size_t i = 0; i < size; ++i) {
+		unsigned char c = static_cast<unsigned char>(data[i]);
+		out[start + 2 * i] = HEX_DIGITS[c >> 4];
+		out[start + 2 * i + 1] = HEX_DIGITS[c & 0xf];
+	}
+}
+
+} // anonymous namespace
+
 /**
 * @brief Constructs a printer.
 */
@@ -36,32 +94,83 @@ std::shared_ptr<PrettyPrinter> PrettyPrinter::create() {
 std::string PrettyPrinter::getPrettyRepr(std::shared_ptr<BItem> data,
 		const std::string &indent) {
 	prettyRepr.clear();
+	output = nullptr;
 	indentLevel = indent;
-	currentIndent.clear();
+	currentIndentLevel = 0;
+	indentTable.clear();
 	data->accept(this);
 	return prettyRepr;
 }
 
+/**
+* @brief Writes a pretty representation of @a data into @a output.
+*
+* @param[in] data Data to write a pretty representation of.
+* @param[in] output Stream into which the representation is written.
+* @param[in] indent A single level of indentation.
+*
+* The representation is the same as the one returned by getPrettyRepr(), but
+* it is written in parts of a bounded size as it is being created. Thus, the
+* memory used by the printer depends on the nesting depth of @a data rather
+* than on the size of the representation.
+*/
+void PrettyPrinter::printPrettyRepr(std::shared_ptr<BItem> data,
+		std::ostream &output, const std::string &indent) {
+	prettyRepr.clear();
+	this->output = &output;
+	indentLevel = indent;
+	currentIndentLevel = 0;
+	indentTable.clear();
+	data->accept(this);
+	flush();
+	this->output = nullptr;
+}
+
+/**
+* @brief Sets the format of binary strings.
+*
+* By default, binary strings are escaped like other strings.
+*/
+void PrettyPrinter::setBinaryStringFormat(BinaryStringFormat format) {
+	binaryStringFormat = format;
+}
+
+/**
+* @brief Returns the format of binary strings.
+*/
+BinaryStringFormat PrettyPrinter::getBinaryStringFormat() const {
+	return binaryStringFormat;
+}
+
 /**
 * @brief Stores the current indentation into @c prettyRepr.
+*
+* It is called before every item of a container, so it is also the place
+* where the buffered representation is written into the output stream.
 */
 void PrettyPrinter::storeCurrentIndent() {
-	prettyRepr += currentIndent;
+	flushIfFull();
+	prettyRepr.append(indentTable, 0, currentIndentLevel * indentLevel.size());
 }
 
 /**
 * @brief Increases the current indentation by a single level.
+*
+* The table of indentations is extended only when a level deeper than all
+* the previous ones is reached.
 */
 void PrettyPrinter::increaseIndentLevel() {
-	currentIndent += indentLevel;
+	++currentIndentLevel;
+	if (indentTable.size() < currentIndentLevel * indentLevel.size()) {
+		indentTable += indentLevel;
+	}
 }
 
 /**
 * @brief Decreases the current indentation by a single level.
 */
 void PrettyPrinter::decreaseIndentLevel() {
-	currentIndent = currentIndent.substr(0,
-		currentIndent.size() - indentLevel.size());
+	--currentIndentLevel;
 }
 
 void PrettyPrinter::visit(BDictionary *bDictionary) {
@@ -101,7 +210,7 @@ void PrettyPrinter::visit(BInteger *bInteger) {
 	//
 	//     int
 	//
-	prettyRepr += std::to_string(bInteger->value());
+	appendDecimal(prettyRepr, bInteger->value());
 }
 
 void PrettyPrinter::visit(BList *bList) {
@@ -116,14 +225,21 @@ void PrettyPrinter::visit(BList *bList) {
 	//
 	prettyRepr += "[\n";
 	increaseIndentLevel();
-	bool putComma = false;
-	for (auto bItem : *bList) {
-		if (putComma) {
+	// Items of packed lists are printed directly from the packed values so
+	// that the lists are not converted into separate items.
+	BList::Storage storage = bList->storage();
+	for (BList::size_type i = 0, e = bList->size(); i < e; ++i) {
+		if (i > 0) {
 			prettyRepr += ",\n";
 		}
 		storeCurrentIndent();
-		bItem->accept(this);
-		putComma = true;
+		if (storage == BList::Storage::PackedIntegers) {
+			appendDecimal(prettyRepr, bList->integerAt(i));
+		} else if (storage == BList::Storage::PackedStrings) {
+			storeString(bList->stringAt(i));
+		} else {
+			static_cast<const BList &>(*bList)[i]->accept(this);
+		}
 	}
 	if (!bList->empty()) {
 		prettyRepr += "\n";
@@ -139,8 +255,73 @@ void PrettyPrinter::visit(BString *bString) {
 	//
 	//     "string"
 	//
-	// We have to put a backslash before quotes, i.e. replace " with \".
-	prettyRepr += '"' + replace(*bString->value(), '"', std::string(R"(\")")) + '"';
+	storeString(*bString->value());
+}
+
+/**
+* @brief Stores a quoted representation of @a str into @c prettyRepr.
+*
+* Long strings are stored in parts so that they do not have to be buffered
+* whole when printing into a stream.
+*/
+void PrettyPrinter::storeString(const std::string &str) {
+	if (binaryStringFormat != BinaryStringFormat::Escaped &&
+			containsBinaryChar(str.data(), str.size())) {
+		storeBinaryString(str);
+		return;
+	}
+
+	prettyRepr += '"';
+	for (std::size_t i = 0; i < str.size(); i += OUTPUT_BUFFER_SIZE) {
+		appendEscaped(prettyRepr, str.data() + i,
+			std::min(OUTPUT_BUFFER_SIZE, str.size() - i));
+		flushIfFull();
+	}
+	prettyRepr += '"';
+}
+
+/**
+* @brief Stores a representation of the binary @a str in the set format into
+*        @c prettyRepr.
+*/
+void PrettyPrinter::storeBinaryString(const std::string &str) {
+	prettyRepr += '<';
+	if (binaryStringFormat == BinaryStringFormat::Summary) {
+		appendDecimal(prettyRepr, static_cast<std::int64_t>(str.size()));
+		prettyRepr += " bytes: ";
+		appendHex(prettyRepr, str.data(), std::min(SUMMARY_SIZE, str.size()));
+		if (str.size() > SUMMARY_SIZE) {
+			prettyRepr += "...";
+		}
+	} else {
+		for (std::size_t i = 0; i < str.size(); i += OUTPUT_BUFFER_SIZE) {
+			appendHex(prettyRepr, str.data() + i,
+				std::min(OUTPUT_BUFFER_SIZE, str.size() - i));
+			flushIfFull();
+		}
+	}
+	prettyRepr += '>';
+}
+
+/**
+* @brief Writes the buffered representation into the output stream when the
+*        buffer is full.
+*/
+void PrettyPrinter::flushIfFull() {
+	if (prettyRepr.size() >= OUTPUT_BUFFER_SIZE) {
+		flush();
+	}
+}
+
+/**
+* @brief Writes the buffered representation into the output stream (if any).
+*/
+void PrettyPrinter::flush() {
+	if (output) {
+		output->write(prettyRepr.data(),
+			static_cast<std::streamsize>(prettyRepr.size()));
+		prettyRepr.clear();
+	}
 }
 
 /**
@@ -157,4 +338,18 @@ std::string getPrettyRepr(std::shared_ptr<BItem> data,
 	return prettyPrinter->getPrettyRepr(data, indent);
 }
 
+/**
+* @brief Writes a pretty representation of @a data into @a output.
+*
+* This function can be handy if you just want to pretty-print data without
+* explicitly creating a pretty printer.
+*
+* See PrettyPrinter::printPrettyRepr() for more details.
+*/
+void printPrettyRepr(std::shared_ptr<BItem> data, std::ostream &output,
+		const std::string &indent) {
+	auto prettyPrinter = PrettyPrinter::create();
+	prettyPrinter->printPrettyRepr(data, output, indent);
+}
+
 } // namespace bencoding
@@ -0,0 +1,345 @@
+/**
+* @file      Scanner.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the Scanner class.
+*/
+
+#include "Scanner.h"
+
+#include <cstring>
+
+#include "Decoder.h"
+#include "Utils.h"
+
+namespace bencoding {
+
+/**
+* @brief Constructs an empty reference.
+*/
+StringRef::StringRef(): refData(""), refSize(0) {}
+
+/**
+* @brief Constructs a reference to @a size bytes starting at @a data.
+*/
+StringRef::StringRef(const char *data, std::size_t size):
+	refData(data), refSize(size) {}
+
+/**
+* @brief Constructs a reference to the given null-terminated string.
+*/
+StringRef::StringRef(const char *str):
+	refData(str), refSize(std::strlen(str)) {}
+
+/**
+* @brief Constructs a reference to the contents of the given string.
+*/
+StringRef::StringRef(const std::string &str):
+	refData(str.data()), refSize(str.size()) {}
+
+/**
+* @brief Returns a pointer to the first referenced byte.
+*/
+const char *StringRef::data() const {
+	return refData;
+}
+
+/**
+* @brief Returns the number of referenced bytes.
+*/
+std::size_t StringRef::size() const {
+	return refSize;
+}
+
+/**
+* @brief Checks if the reference is empty.
+*/
+bool StringRef::empty() const {
+	return refSize == 0;
+}
+
+/**
+* @brief Returns a copy of the referenced bytes.
+*/
+std::string StringRef::str() const {
+	return std::string(refData, refSize);
+}
+
+/**
+* @brief Returns an iterator to the beginning of the referenced bytes.
+*/
+const char *StringRef::begin() const {
+	return refData;
+}
+
+/**
+* @brief Returns an iterator to the end of the referenced bytes.
+*/
+const char *StringRef::end() const {
+	return refData + refSize;
+}
+
+/**
+* @brief Lexicographically compares the referenced bytes with @a other.
+*
+* The comparison is performed on unsigned bytes, so it orders strings in the
+* same way as @c std::string does.
+*
+* @return A negative value, zero, or a positive value when the reference is
+*         less than, equal to, or greater than @a other, respectively.
+*/
+int StringRef::compare(const StringRef &other) const {
+	std::size_t commonSize = refSize < other.refSize ? refSize : other.refSize;
+	int result = commonSize > 0 ? std::memcmp(refData, other.refData, commonSize) : 0;
+	if (result != 0) {
+		return result;
+	}
+	return refSize < other.refSize ? -1 : (refSize > other.refSize ? 1 : 0);
+}
+
+/**
+* @brief Checks if the referenced bytes are equal.
+*/
+bool operator==(const StringRef &lhs, const StringRef &rhs) {
+	return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+/**
+* @brief Checks if the referenced bytes differ.
+*/
+bool operator!=(const StringRef &lhs, const StringRef &rhs) {
+	return !(lhs == rhs);
+}
+
+/**
+* @brief Checks if @a lhs is lexicographically less than @a rhs.
+*/
+bool operator<(const StringRef &lhs, const StringRef &rhs) {
+	return lhs.compare(rhs) < 0;
+}
+
+/**
+* @brief Constructs a scanner of @a size bytes starting at @a data.
+*/
+Scanner::Scanner(const char *data, std::size_t size):
+	first(data), current(data), last(data + size) {}
+
+/**
+* @brief Constructs a scanner of the given @a data.
+*
+* @a data are not copied, so they have to outlive the scanner.
+*/
+Scanner::Scanner(const std::string &data):
+	Scanner(data.data(), data.size()) {}
+
+/**
+* @brief Returns the number of bytes that have already been scanned.
+*/
+std::size_t Scanner::position() const {
+	return current - first;
+}
+
+/**
+* @brief Returns the number of bytes that have not been scanned yet.
+*/
+std::size_t Scanner::remaining() const {
+	return last - current;
+}
+
+/**
+* @brief Checks if all the data have been scanned.
+*/
+bool Scanner::atEnd() const {
+	return current == last;
+}
+
+/**
+* @brief Returns the next byte without scanning it.
+*
+* If all the data have been scanned, DecodingError is thrown.
+*/
+char Scanner::peek() const {
+	if (atEnd()) {
+		throw DecodingError("unexpected end of data");
+	}
+	return *current;
+}
+
+/**
+* @brief Scans the beginning of a dictionary.
+*
+* Scan the items by alternating readString() for keys and the appropriate
+* function for values until atContainerEnd() returns @c true, and then call
+* leaveContainer().
+*/
+void Scanner::enterDictionary() {
+	readExpectedChar('d');
+}
+
+/**
+* @brief Scans the beginning of a list.
+*
+* Scan the items until atContainerEnd() returns @c true, and then call
+* leaveContainer().
+*/
+void Scanner::enterList() {
+	readExpectedChar('l');
+}
+
+/**
+* @brief Checks if the scanner is at the end of the current container.
+*/
+bool Scanner::atContainerEnd() const {
+	return peek() == 'e';
+}
+
+/**
+* @brief Scans the end of the current container.
+*/
+void Scanner::leaveContainer() {
+	readExpectedChar('e');
+}
+
+/**
+* @brief Scans a string and returns a reference to its contents.
+*
+* See Decoder::decodeString() for the format.
+*/
+StringRef Scanner::readString() {
+	std::size_t length = readStringLength();
+	StringRef str(current, length);
+	current += length;
+	return str;
+}
+
+/**
+* @brief Scans an integer and returns its value.
+*
+* See Decoder::decodeInteger() for the format. Integers that do not fit into
+* 64 bits are rejected.
+*/
+std::int64_t Scanner::readInteger() {
+	readExpectedChar('i');
+	bool negative = false;
+	if (peek() == '-') {
+		negative = true;
+		++current;
+	}
+	if (peek() < '0' || peek() > '9') {
+		throw DecodingError("expected a digit in an encoded integer");
+	}
+	if (peek() == '0' && current + 1 < last && current[1] != 'e') {
+		throw DecodingError("encoded integer contains leading zeros");
+	}
+
+	std::int64_t value;
+	const char *end = readDecimalDigits(current, last, negative, value);
+	if (!end) {
+		throw DecodingError("encoded integer does not fit into 64 bits");
+	}
+	current = end;
+	readExpectedChar('e');
+	return value;
+}
+
+/**
+* @brief Skips the next item (including nested items) and returns a reference
+*        to its encoded form.
+*
+* The returned reference spans the item exactly as it appears in the scanned
+* data, so it can be hashed or copied without re-encoding. Nesting is tracked
+* by a counter, so deeply nested data do not exhaust the stack.
+*/
+StringRef Scanner::skipItem() {
+	const char *itemStart = current;
+	std::size_t depth = 0;
+	do {
+		switch (peek()) {
+			case 'd':
+			case 'l':
+				++current;
+				++depth;
+				break;
+			case 'e':
+				if (depth == 0) {
+					throw DecodingError("unexpected end of a container");
+				}
+				++current;
+				--depth;
+				break;
+			case 'i':
+				skipInteger();
+				break;
+			default:
+				skipString();
+				break;
+		}
+	} while (depth > 0);
+	return StringRef(itemStart, current - itemStart);
+}
+
+/**
+* @brief Throws DecodingError if there are characters left to scan.
+*/
+void Scanner::readEnd() const {
+	if (!atEnd()) {
+		throw DecodingError("input contains undecoded characters");
+	}
+}
+
+/**
+* @brief Scans @a expectedChar and throws DecodingError if there is a
+*        different character.
+*/
+void Scanner::readExpectedChar(char expectedChar) {
+	if (peek() != expectedChar) {
+		throw DecodingError(std::string("expected '") + expectedChar +
+			"', got '" + *current + "'");
+	}
+	++current;
+}
+
+/**
+* @brief Scans a string length and the following colon.
+*
+* The length is checked against the remaining data, so a bogus length is
+* reported before anything is read.
+*/
+std::size_t Scanner::readStringLength() {
+	if (peek() < '0' || peek() > '9') {
+		throw DecodingError(std::string("unexpected character: '") +
+			*current + "'");
+	}
+	std::size_t length = 0;
+	while (peek() >= '0' && peek() <= '9') {
+		length = length * 10 + static_cast<std::size_t>(*current - '0');
+		if (length > remaining()) {
+			throw DecodingError("string length exceeds the size of the data");
+		}
+		++current;
+	}
+	readExpectedChar(':');
+	if (length > remaining()) {
+		throw DecodingError("string length exceeds the size of the data");
+	}
+	return length;
+}
+
+/**
+* @brief Skips an integer.
+*
+* The integer is validated by readInteger(), so skipItem() rejects the same
+* malformed integers as decode().
+*/
+void Scanner::skipInteger() {
+	readInteger();
+}
+
+/**
+* @brief Skips a string without referencing its contents.
+*/
+void Scanner::skipString() {
+	current += readStringLength();
+}
+
+} // namespace bencoding
@@ -0,0 +1,81 @@
+/**
+* @file      Schema.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the non-template parts of the binding of
+*            bencoded data to C++ structures.
+*/
+
+#include "Schema.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "Encoder.h"
+#include "Utils.h"
+
+namespace bencoding {
+namespace internal {
+
+/**
+* @brief Appends an encoded integer with the given @a value to @a out.
+*
+* @throws std::out_of_range When @a value does not fit into 64-bit signed
+*         integers, which are the integers that the decoders accept.
+*/
+void appendEncodedUnsignedInteger(std::string &out, std::uint64_t value) {
+	if (value > static_cast<std::uint64_t>(
+			std::numeric_limits<std::int64_t>::max())) {
+		throw std::out_of_range("integer " + std::to_string(value) +
+			" does not fit into a 64-bit signed integer");
+	}
+	appendEncodedInteger(out, static_cast<std::int64_t>(value));
+}
+
+/**
+* @brief Appends an encoded string with the given contents to @a out.
+*/
+void appendEncodedString(std::string &out, const char *data, std::size_t size) {
+	appendEncodedStringHeader(out, size);
+	out.append(data, size);
+}
+
+/**
+* @brief Appends the encoded @a item to @a out.
+*
+* A null @a item is encoded as an empty string so that the result stays
+* decodable.
+*/
+void appendEncodedItem(std::string &out, const std::shared_ptr<BItem> &item) {
+	if (!item) {
+		out += "0:";
+		return;
+	}
+	out += encode(item);
+}
+
+/**
+* @brief Decodes the next item from @a scanner into a BItem.
+*/
+std::shared_ptr<BItem> decodeItem(Scanner &scanner) {
+	return decode(scanner.skipItem().str());
+}
+
+/**
+* @brief Throws DecodingError saying that @a value does not fit into the
+*        member it is decoded into.
+*/
+void throwIntegerOutOfRange(std::int64_t value) {
+	throw DecodingError("integer " + std::to_string(value) +
+		" does not fit into the bound member");
+}
+
+/**
+* @brief Throws DecodingError saying that there are undecoded characters.
+*/
+void throwUndecodedCharacters() {
+	throw DecodingError("input contains undecoded characters");
+}
+
+} // namespace internal
+} // namespace bencoding
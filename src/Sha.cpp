@@ -0,0 +1,574 @@
+/**
+* @file      Sha.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the SHA-1 and SHA-256 hash functions.
+*/
+
+#include "Sha.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BENCODING_HAVE_SHA_NI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace bencoding {
+
+namespace {
+
+/// Initial state of SHA-1.
+const std::uint32_t SHA1_INITIAL_STATE[5] = {
+	0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+/// Initial state of SHA-256.
+const std::uint32_t SHA256_INITIAL_STATE[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+	0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/// Round constants of SHA-256.
+const std::uint32_t SHA256_K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+	0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+	0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+	0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+	0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+	0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline std::uint32_t rotl(std::uint32_t x, unsigned n) {
+	return (x << n) | (x >> (32 - n));
+}
+
+inline std::uint32_t rotr(std::uint32_t x, unsigned n) {
+	return (x >> n) | (x << (32 - n));
+}
+
+inline std::uint32_t loadBigEndian(const unsigned char *p) {
+	return (static_cast<std::uint32_t>(p[0]) << 24) |
+		(static_cast<std::uint32_t>(p[1]) << 16) |
+		(static_cast<std::uint32_t>(p[2]) << 8) |
+		static_cast<std::uint32_t>(p[3]);
+}
+
+inline void storeBigEndian(unsigned char *p, std::uint32_t x) {
+	p[0] = static_cast<unsigned char>(x >> 24);
+	p[1] = static_cast<unsigned char>(x >> 16);
+	p[2] = static_cast<unsigned char>(x >> 8);
+	p[3] = static_cast<unsigned char>(x);
+}
+
+/**
+* @brief Portable SHA-1 compression function.
+*/
+void sha1CompressPortable(std::uint32_t *state,
+		const unsigned char *blocks, std::size_t numOfBlocks) {
+	for (; numOfBlocks > 0; --numOfBlocks, blocks += ShaBase::BlockSize) {
+		std::uint32_t w[80];
+		for (unsigned i = 0; i < 16; ++i) {
+			w[i] = loadBigEndian(blocks + 4 * i);
+		}
+		for (unsigned i = 16; i < 80; ++i) {
+			w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+		}
+
+		std::uint32_t a = state[0];
+		std::uint32_t b = state[1];
+		std::uint32_t c = state[2];
+		std::uint32_t d = state[3];
+		std::uint32_t e = state[4];
+		for (unsigned i = 0; i < 80; ++i) {
+			std::uint32_t f, k;
+			if (i < 20) {
+				f = (b & c) | (~b & d);
+				k = 0x5a827999;
+			} else if (i < 40) {
+				f = b ^ c ^ d;
+				k = 0x6ed9eba1;
+			} else if (i < 60) {
+				f = (b & c) | (b & d) | (c & d);
+				k = 0x8f1bbcdc;
+			} else {
+				f = b ^ c ^ d;
+				k = 0xca62c1d6;
+			}
+			std::uint32_t t = rotl(a, 5) + f + e + k + w[i];
+			e = d;
+			d = c;
+			c = rotl(b, 30);
+			b = a;
+			a = t;
+		}
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+	}
+}
+
+/**
+* @brief Portable SHA-256 compression function.
+*/
+void sha256CompressPortable(std::uint32_t *state,
+		const unsigned char *blocks, std::size_t numOfBlocks) {
+	for (; numOfBlocks > 0; --numOfBlocks, blocks += ShaBase::BlockSize) {
+		std::uint32_t w[64];
+		for (unsigned i = 0; i < 16; ++i) {
+			w[i] = loadBigEndian(blocks + 4 * i);
+		}
+		for (unsigned i = 16; i < 64; ++i) {
+			std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		std::uint32_t a = state[0];
+		std::uint32_t b = state[1];
+		std::uint32_t c = state[2];
+		std::uint32_t d = state[3];
+		std::uint32_t e = state[4];
+		std::uint32_t f = state[5];
+		std::uint32_t g = state[6];
+		std::uint32_t h = state[7];
+		for (unsigned i = 0; i < 64; ++i) {
+			std::uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+			std::uint32_t ch = (e & f) ^ (~e & g);
+			std::uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+			std::uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+			std::uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+			std::uint32_t t2 = s0 + maj;
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+	}
+}
+
+#ifdef BENCODING_HAVE_SHA_NI
+
+// In non-optimized builds, GCC implements some of the intrinsics as macros
+// with C-style casts.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+
+/**
+* @brief Checks if the CPU supports the SHA extensions (and SSSE3 and SSE4.1,
+*        which the accelerated compression functions use as well).
+*/
+bool cpuSupportsShaExtensions() {
+	unsigned eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return false;
+	}
+	bool hasSsse3 = (ecx & (1u << 9)) != 0;
+	bool hasSse41 = (ecx & (1u << 19)) != 0;
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return false;
+	}
+	bool hasSha = (ebx & (1u << 29)) != 0;
+	return hasSsse3 && hasSse41 && hasSha;
+}
+
+/**
+* @brief Performs four rounds of SHA-1 (group @a g out of 20) with SHA-NI.
+*
+* @a eIn carries the E value for this group and @a eOut receives the E value
+* for the next group. @a m0 is the message vector consumed by this group and
+* @a m1, @a m2, @a m3 are the following ones (modulo four). The message
+* schedule for later groups is computed on the fly.
+*/
+#define BENCODING_SHA1_GROUP(g, eIn, eOut, m0, m1, m2, m3) \
+	eIn = _mm_sha1nexte_epu32(eIn, m0); \
+	eOut = abcd; \
+	if ((g) >= 3) { m1 = _mm_sha1msg2_epu32(m1, m0); } \
+	abcd = _mm_sha1rnds4_epu32(abcd, eIn, (g) / 5); \
+	if ((g) <= 16) { m3 = _mm_sha1msg1_epu32(m3, m0); } \
+	if ((g) >= 2 && (g) <= 17) { m2 = _mm_xor_si128(m2, m0); }
+
+/**
+* @brief SHA-1 compression function using the SHA CPU extensions.
+*/
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha1CompressShaNi(std::uint32_t *state,
+		const unsigned char *blocks, std::size_t numOfBlocks) {
+	const __m128i byteSwapMask = _mm_set_epi64x(
+		0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+	__m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+	abcd = _mm_shuffle_epi32(abcd, 0x1b);
+	__m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+	__m128i e1 = _mm_setzero_si128();
+
+	for (; numOfBlocks > 0; --numOfBlocks, blocks += ShaBase::BlockSize) {
+		const __m128i abcdSaved = abcd;
+		const __m128i eSaved = e0;
+
+		__m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks)), byteSwapMask);
+		__m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks + 16)), byteSwapMask);
+		__m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks + 32)), byteSwapMask);
+		__m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks + 48)), byteSwapMask);
+
+		// Rounds 0-3 add the first message vector to E directly.
+		e0 = _mm_add_epi32(e0, msg0);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+		// Rounds 4-7.
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+		// Rounds 8-79.
+		BENCODING_SHA1_GROUP(2, e0, e1, msg2, msg3, msg0, msg1)
+		BENCODING_SHA1_GROUP(3, e1, e0, msg3, msg0, msg1, msg2)
+		BENCODING_SHA1_GROUP(4, e0, e1, msg0, msg1, msg2, msg3)
+		BENCODING_SHA1_GROUP(5, e1, e0, msg1, msg2, msg3, msg0)
+		BENCODING_SHA1_GROUP(6, e0, e1, msg2, msg3, msg0, msg1)
+		BENCODING_SHA1_GROUP(7, e1, e0, msg3, msg0, msg1, msg2)
+		BENCODING_SHA1_GROUP(8, e0, e1, msg0, msg1, msg2, msg3)
+		BENCODING_SHA1_GROUP(9, e1, e0, msg1, msg2, msg3, msg0)
+		BENCODING_SHA1_GROUP(10, e0, e1, msg2, msg3, msg0, msg1)
+		BENCODING_SHA1_GROUP(11, e1, e0, msg3, msg0, msg1, msg2)
+		BENCODING_SHA1_GROUP(12, e0, e1, msg0, msg1, msg2, msg3)
+		BENCODING_SHA1_GROUP(13, e1, e0, msg1, msg2, msg3, msg0)
+		BENCODING_SHA1_GROUP(14, e0, e1, msg2, msg3, msg0, msg1)
+		BENCODING_SHA1_GROUP(15, e1, e0, msg3, msg0, msg1, msg2)
+		BENCODING_SHA1_GROUP(16, e0, e1, msg0, msg1, msg2, msg3)
+		BENCODING_SHA1_GROUP(17, e1, e0, msg1, msg2, msg3, msg0)
+		BENCODING_SHA1_GROUP(18, e0, e1, msg2, msg3, msg0, msg1)
+		BENCODING_SHA1_GROUP(19, e1, e0, msg3, msg0, msg1, msg2)
+
+		e0 = _mm_sha1nexte_epu32(e0, eSaved);
+		abcd = _mm_add_epi32(abcd, abcdSaved);
+	}
+
+	abcd = _mm_shuffle_epi32(abcd, 0x1b);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state), abcd);
+	state[4] = static_cast<std::uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+#undef BENCODING_SHA1_GROUP
+
+/**
+* @brief Performs four rounds of SHA-256 (group @a g out of 16) with SHA-NI.
+*
+* @a m0 is the message vector consumed by this group and @a m1, @a m2, @a m3
+* are the following ones (modulo four). The message schedule for later groups
+* is computed on the fly.
+*/
+#define BENCODING_SHA256_GROUP(g, m0, m1, m2, m3) \
+	msg = _mm_add_epi32(m0, _mm_loadu_si128( \
+		reinterpret_cast<const __m128i *>(SHA256_K + 4 * (g)))); \
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+	if ((g) >= 3 && (g) <= 14) { \
+		m1 = _mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)); \
+		m1 = _mm_sha256msg2_epu32(m1, m0); \
+	} \
+	msg = _mm_shuffle_epi32(msg, 0x0e); \
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg); \
+	if ((g) >= 1 && (g) <= 12) { m3 = _mm_sha256msg1_epu32(m3, m0); }
+
+/**
+* @brief SHA-256 compression function using the SHA CPU extensions.
+*/
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha256CompressShaNi(std::uint32_t *state,
+		const unsigned char *blocks, std::size_t numOfBlocks) {
+	const __m128i byteSwapMask = _mm_set_epi64x(
+		0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	// The instructions operate on the state split into (A, B, E, F) and
+	// (C, D, G, H).
+	__m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+	__m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+	tmp = _mm_shuffle_epi32(tmp, 0xb1);
+	state1 = _mm_shuffle_epi32(state1, 0x1b);
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+	for (; numOfBlocks > 0; --numOfBlocks, blocks += ShaBase::BlockSize) {
+		const __m128i state0Saved = state0;
+		const __m128i state1Saved = state1;
+
+		__m128i msg;
+		__m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks)), byteSwapMask);
+		__m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks + 16)), byteSwapMask);
+		__m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks + 32)), byteSwapMask);
+		__m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(blocks + 48)), byteSwapMask);
+
+		BENCODING_SHA256_GROUP(0, msg0, msg1, msg2, msg3)
+		BENCODING_SHA256_GROUP(1, msg1, msg2, msg3, msg0)
+		BENCODING_SHA256_GROUP(2, msg2, msg3, msg0, msg1)
+		BENCODING_SHA256_GROUP(3, msg3, msg0, msg1, msg2)
+		BENCODING_SHA256_GROUP(4, msg0, msg1, msg2, msg3)
+		BENCODING_SHA256_GROUP(5, msg1, msg2, msg3, msg0)
+		BENCODING_SHA256_GROUP(6, msg2, msg3, msg0, msg1)
+		BENCODING_SHA256_GROUP(7, msg3, msg0, msg1, msg2)
+		BENCODING_SHA256_GROUP(8, msg0, msg1, msg2, msg3)
+		BENCODING_SHA256_GROUP(9, msg1, msg2, msg3, msg0)
+		BENCODING_SHA256_GROUP(10, msg2, msg3, msg0, msg1)
+		BENCODING_SHA256_GROUP(11, msg3, msg0, msg1, msg2)
+		BENCODING_SHA256_GROUP(12, msg0, msg1, msg2, msg3)
+		BENCODING_SHA256_GROUP(13, msg1, msg2, msg3, msg0)
+		BENCODING_SHA256_GROUP(14, msg2, msg3, msg0, msg1)
+		BENCODING_SHA256_GROUP(15, msg3, msg0, msg1, msg2)
+
+		state0 = _mm_add_epi32(state0, state0Saved);
+		state1 = _mm_add_epi32(state1, state1Saved);
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1b);
+	state1 = _mm_shuffle_epi32(state1, 0xb1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state), state0);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), state1);
+}
+
+#undef BENCODING_SHA256_GROUP
+
+#pragma GCC diagnostic pop
+
+/// Does the CPU support the SHA extensions? Detected once at startup.
+const bool CPU_HAS_SHA_EXTENSIONS = cpuSupportsShaExtensions();
+
+#else
+
+/// SHA extensions are not supported on this platform.
+const bool CPU_HAS_SHA_EXTENSIONS = false;
+
+#endif
+
+/**
+* @brief Selects the SHA-1 compression function for @a implementation.
+*/
+void (*selectSha1Compress(ShaImplementation implementation))(
+		std::uint32_t *, const unsigned char *, std::size_t) {
+#ifdef BENCODING_HAVE_SHA_NI
+	if (implementation == ShaImplementation::Auto && CPU_HAS_SHA_EXTENSIONS) {
+		return sha1CompressShaNi;
+	}
+#else
+	static_cast<void>(implementation);
+#endif
+	return sha1CompressPortable;
+}
+
+/**
+* @brief Selects the SHA-256 compression function for @a implementation.
+*/
+void (*selectSha256Compress(ShaImplementation implementation))(
+		std::uint32_t *, const unsigned char *, std::size_t) {
+#ifdef BENCODING_HAVE_SHA_NI
+	if (implementation == ShaImplementation::Auto && CPU_HAS_SHA_EXTENSIONS) {
+		return sha256CompressShaNi;
+	}
+#else
+	static_cast<void>(implementation);
+#endif
+	return sha256CompressPortable;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Constructs a hash that uses the given compression function.
+*/
+ShaBase::ShaBase(CompressFunction compress):
+	state(), compress(compress), buffer(), bufferSize(0), totalSize(0) {}
+
+/**
+* @brief Hashes @a size bytes starting at @a data.
+*
+* Complete blocks are passed to the compression function directly from @a
+* data, without copying them.
+*/
+void ShaBase::update(const char *data, std::size_t size) {
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+	totalSize += size;
+
+	if (bufferSize > 0) {
+		std::size_t toCopy = BlockSize - bufferSize;
+		if (toCopy > size) {
+			toCopy = size;
+		}
+		std::memcpy(buffer + bufferSize, bytes, toCopy);
+		bufferSize += toCopy;
+		bytes += toCopy;
+		size -= toCopy;
+		if (bufferSize < BlockSize) {
+			return;
+		}
+		compress(state, buffer, 1);
+		bufferSize = 0;
+	}
+
+	std::size_t numOfBlocks = size / BlockSize;
+	if (numOfBlocks > 0) {
+		compress(state, bytes, numOfBlocks);
+		bytes += numOfBlocks * BlockSize;
+		size -= numOfBlocks * BlockSize;
+	}
+
+	if (size > 0) {
+		std::memcpy(buffer, bytes, size);
+		bufferSize = size;
+	}
+}
+
+/**
+* @brief Hashes the given @a data.
+*/
+void ShaBase::update(const std::string &data) {
+	update(data.data(), data.size());
+}
+
+/**
+* @brief Pads the hashed data and returns the first @a digestSize bytes of the
+*        resulting state.
+*
+* The hash cannot be updated afterwards.
+*/
+std::string ShaBase::finish(std::size_t digestSize) {
+	const std::uint64_t totalBits = totalSize * 8;
+
+	buffer[bufferSize++] = 0x80;
+	if (bufferSize > BlockSize - 8) {
+		std::memset(buffer + bufferSize, 0, BlockSize - bufferSize);
+		compress(state, buffer, 1);
+		bufferSize = 0;
+	}
+	std::memset(buffer + bufferSize, 0, BlockSize - 8 - bufferSize);
+	storeBigEndian(buffer + BlockSize - 8, static_cast<std::uint32_t>(totalBits >> 32));
+	storeBigEndian(buffer + BlockSize - 4, static_cast<std::uint32_t>(totalBits));
+	compress(state, buffer, 1);
+	bufferSize = 0;
+
+	std::string digest(digestSize, char());
+	for (std::size_t i = 0; i < digestSize / 4; ++i) {
+		storeBigEndian(reinterpret_cast<unsigned char *>(&digest[4 * i]), state[i]);
+	}
+	return digest;
+}
+
+/**
+* @brief Constructs a SHA-1 hash.
+*
+* @param[in] implementation Compression function to be used.
+*/
+Sha1::Sha1(ShaImplementation implementation):
+		ShaBase(selectSha1Compress(implementation)) {
+	std::memcpy(state, SHA1_INITIAL_STATE, sizeof(SHA1_INITIAL_STATE));
+}
+
+/**
+* @brief Returns the digest (20 raw bytes) of the hashed data.
+*
+* The hash cannot be updated afterwards.
+*/
+std::string Sha1::digest() {
+	return finish(DigestSize);
+}
+
+/**
+* @brief Checks if SHA-1 is computed by using the SHA CPU extensions when @c
+*        ShaImplementation::Auto is requested.
+*/
+bool Sha1::hasHardwareSupport() {
+	return CPU_HAS_SHA_EXTENSIONS;
+}
+
+/**
+* @brief Constructs a SHA-256 hash.
+*
+* @param[in] implementation Compression function to be used.
+*/
+Sha256::Sha256(ShaImplementation implementation):
+		ShaBase(selectSha256Compress(implementation)) {
+	std::memcpy(state, SHA256_INITIAL_STATE, sizeof(SHA256_INITIAL_STATE));
+}
+
+/**
+* @brief Returns the digest (32 raw bytes) of the hashed data.
+*
+* The hash cannot be updated afterwards.
+*/
+std::string Sha256::digest() {
+	return finish(DigestSize);
+}
+
+/**
+* @brief Checks if SHA-256 is computed by using the SHA CPU extensions when
+*        @c ShaImplementation::Auto is requested.
+*/
+bool Sha256::hasHardwareSupport() {
+	return CPU_HAS_SHA_EXTENSIONS;
+}
+
+/**
+* @brief Returns the SHA-1 digest (20 raw bytes) of @a size bytes starting at
+*        @a data.
+*/
+std::string sha1(const char *data, std::size_t size) {
+	Sha1 hash;
+	hash.update(data, size);
+	return hash.digest();
+}
+
+/**
+* @brief Returns the SHA-1 digest (20 raw bytes) of @a data.
+*/
+std::string sha1(const std::string &data) {
+	return sha1(data.data(), data.size());
+}
+
+/**
+* @brief Returns the SHA-256 digest (32 raw bytes) of @a size bytes starting
+*        at @a data.
+*/
+std::string sha256(const char *data, std::size_t size) {
+	Sha256 hash;
+	hash.update(data, size);
+	return hash.digest();
+}
+
+/**
+* @brief Returns the SHA-256 digest (32 raw bytes) of @a data.
+*/
+std::string sha256(const std::string &data) {
+	return sha256(data.data(), data.size());
+}
+
+} // namespace bencoding
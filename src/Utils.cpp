@@ -7,8 +7,295 @@
 
 #include "Utils.h"
 
+#include <limits>
+
+#if defined(__SSE2__)
+#define BENCODING_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace bencoding {
 
+namespace {
+
+/// Decimal representations of all two-digit numbers.
+const char TWO_DIGITS[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/**
+* @brief Is @a c one of the given special @a chars (see findSpecialChar())?
+*/
+inline bool isSpecialChar(unsigned char c, SpecialChars chars) {
+	return c < 0x20 || c == '"' || c == '\\' ||
+		(c == 0x7f && chars == SpecialChars::EscapedOrDel) ||
+		(c >= 0x80 && chars == SpecialChars::EscapedOrNonAscii);
+}
+
+/**
+* @brief Is @a c a control character that does not appear in text?
+*/
+inline bool isBinaryChar(unsigned char c) {
+	return (c < 0x20 && c != '\t' && c != '\n' && c != '\r') || c == 0x7f;
+}
+
+/**
+* @brief Rotates @a x left by @a bits.
+*/
+inline std::uint64_t rotateLeft(std::uint64_t x, unsigned bits) {
+	return (x << bits) | (x >> (64 - bits));
+}
+
+/**
+* @brief Performs one SipRound over the given state.
+*/
+inline void sipRound(std::uint64_t &v0, std::uint64_t &v1,
+		std::uint64_t &v2, std::uint64_t &v3) {
+	v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);
+	v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;
+	v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;
+	v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);
+}
+
+/**
+* @brief Reads @a size (at most 8) bytes from @a data as a little-endian
+*        number.
+*/
+inline std::uint64_t readLittleEndian(const char *data, std::size_t size) {
+	std::uint64_t num = 0;
+	for (std::size_t i = 0; i < size; ++i) {
+		num |= std::uint64_t(static_cast<unsigned char>(data[i])) << (8 * i);
+	}
+	return num;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Converts the decimal digits in <tt>[first, last)</tt> into a number.
+*
+* @param[in] first Beginning of the digits.
+* @param[in] last End of the digits.
+* @param[out] num Place to store the converted number.
+*
+* @return @c true if the conversion was successful, @c false otherwise.
+*
+* The range has to consist only of decimal digits (at least one). Signs,
+* whitespace, and other characters are rejected. The conversion fails if the
+* number does not fit into 64 bits. In contrast to strToNum(), no memory is
+* allocated and the current locale is not consulted. If the conversion fails,
+* @a num is left unchanged.
+*/
+bool parseUnsignedDecimal(const char *first, const char *last,
+		std::uint64_t &num) {
+	if (first == last) {
+		return false;
+	}
+
+	const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+	std::uint64_t convNum = 0;
+	for (; first != last; ++first) {
+		if (*first < '0' || *first > '9') {
+			return false;
+		}
+		unsigned digit = static_cast<unsigned>(*first - '0');
+		if (convNum > (max - digit) / 10) {
+			return false;
+		}
+		convNum = convNum * 10 + digit;
+	}
+	num = convNum;
+	return true;
+}
+
+/**
+* @brief Converts the decimal integer in <tt>[first, last)</tt> into a number.
+*
+* The range has to consist of an optional @c '-' followed by decimal digits.
+* See parseUnsignedDecimal() for more details.
+*/
+bool parseDecimal(const char *first, const char *last, std::int64_t &num) {
+	bool negative = first != last && *first == '-';
+	if (negative) {
+		++first;
+	}
+	if (first == last) {
+		return false;
+	}
+
+	std::int64_t convNum = 0;
+	if (readDecimalDigits(first, last, negative, convNum) != last) {
+		return false;
+	}
+	num = convNum;
+	return true;
+}
+
+/**
+* @brief Reads the decimal digits at the beginning of <tt>[first, last)</tt>
+*        as the magnitude of a number with the given sign.
+*
+* @param[in] first Beginning of the digits.
+* @param[in] last End of the data.
+* @param[in] negative Is the number negative?
+* @param[out] num Place to store the number.
+*
+* @return The end of the digits, or a null pointer when the number does not
+*         fit into 64 bits (in which case @a num is left unchanged).
+*
+* Reading stops at the first character that is not a digit, so the callers
+* check the characters around the digits (e.g. that there is at least one).
+*/
+const char *readDecimalDigits(const char *first, const char *last,
+		bool negative, std::int64_t &num) {
+	// Accumulate the magnitude as unsigned so that the most negative value is
+	// representable.
+	const std::uint64_t limit = negative ?
+		static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1 :
+		static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+	std::uint64_t magnitude = 0;
+	for (; first != last && *first >= '0' && *first <= '9'; ++first) {
+		unsigned digit = static_cast<unsigned>(*first - '0');
+		if (magnitude > (limit - digit) / 10) {
+			return nullptr;
+		}
+		magnitude = magnitude * 10 + digit;
+	}
+	// Negate in unsigned arithmetic so that the most negative number does not
+	// overflow.
+	num = negative ? static_cast<std::int64_t>(0 - magnitude) :
+		static_cast<std::int64_t>(magnitude);
+	return first;
+}
+
+/**
+* @brief Writes the decimal representation of @a num into @a buffer.
+*
+* @param[out] buffer Place to store the representation. It has to have room
+*                    for at least @c MAX_DECIMAL_LENGTH characters.
+* @param[in] num Number to be written.
+*
+* @return Number of written characters.
+*
+* The representation is not null-terminated. In contrast to @c
+* std::to_string(), no memory is allocated and the current locale is not
+* consulted. Two digits are produced per division.
+*/
+std::size_t writeUnsignedDecimal(char *buffer, std::uint64_t num) {
+	// Produce the digits from the end into a temporary buffer so that the
+	// length does not have to be computed beforehand.
+	char digits[MAX_DECIMAL_LENGTH];
+	char *end = digits + MAX_DECIMAL_LENGTH;
+	char *p = end;
+	while (num >= 100) {
+		unsigned pos = static_cast<unsigned>(num % 100) * 2;
+		num /= 100;
+		*--p = TWO_DIGITS[pos + 1];
+		*--p = TWO_DIGITS[pos];
+	}
+	if (num >= 10) {
+		unsigned pos = static_cast<unsigned>(num) * 2;
+		*--p = TWO_DIGITS[pos + 1];
+		*--p = TWO_DIGITS[pos];
+	} else {
+		*--p = static_cast<char>('0' + num);
+	}
+
+	std::size_t length = end - p;
+	for (std::size_t i = 0; i < length; ++i) {
+		buffer[i] = p[i];
+	}
+	return length;
+}
+
+/**
+* @brief Writes the decimal representation of @a num into @a buffer.
+*
+* See writeUnsignedDecimal() for more details. Negative numbers are prefixed
+* with @c '-'.
+*/
+std::size_t writeDecimal(char *buffer, std::int64_t num) {
+	if (num >= 0) {
+		return writeUnsignedDecimal(buffer, static_cast<std::uint64_t>(num));
+	}
+	// Negate in unsigned arithmetic so that the most negative number does not
+	// overflow.
+	buffer[0] = '-';
+	return 1 + writeUnsignedDecimal(buffer + 1, 0 - static_cast<std::uint64_t>(num));
+}
+
+/**
+* @brief Appends the decimal representation of @a num to @a str.
+*
+* No temporary string is created.
+*/
+void appendDecimal(std::string &str, std::int64_t num) {
+	char buffer[MAX_DECIMAL_LENGTH];
+	str.append(buffer, writeDecimal(buffer, num));
+}
+
+/**
+* @brief Writes an encoded integer with the given value (e.g. @c i-42e) into
+*        @a buffer.
+*
+* @param[out] buffer Place to store the integer. It has to have room for at
+*                    least @c MAX_ENCODED_INTEGER_LENGTH characters.
+* @param[in] num Value of the integer.
+*
+* @return Number of written characters.
+*/
+std::size_t writeEncodedInteger(char *buffer, std::int64_t num) {
+	std::size_t length = 0;
+	buffer[length++] = 'i';
+	length += writeDecimal(buffer + length, num);
+	buffer[length++] = 'e';
+	return length;
+}
+
+/**
+* @brief Writes the part of an encoded string of @a size bytes that precedes
+*        its contents (e.g. @c 4: for a string of four bytes) into @a buffer.
+*
+* @param[out] buffer Place to store the header. It has to have room for at
+*                    least @c MAX_ENCODED_STRING_HEADER_LENGTH characters.
+* @param[in] size Size of the contents of the string.
+*
+* @return Number of written characters.
+*/
+std::size_t writeEncodedStringHeader(char *buffer, std::size_t size) {
+	std::size_t length = writeUnsignedDecimal(buffer, size);
+	buffer[length++] = ':';
+	return length;
+}
+
+/**
+* @brief Appends an encoded integer with the given value to @a str.
+*
+* See writeEncodedInteger() for more details.
+*/
+void appendEncodedInteger(std::string &str, std::int64_t num) {
+	char buffer[MAX_ENCODED_INTEGER_LENGTH];
+	str.append(buffer, writeEncodedInteger(buffer, num));
+}
+
+/**
+* @brief Appends the header of an encoded string of @a size bytes to @a str.
+*
+* See writeEncodedStringHeader() for more details.
+*/
+void appendEncodedStringHeader(std::string &str, std::size_t size) {
+	char buffer[MAX_ENCODED_STRING_HEADER_LENGTH];
+	str.append(buffer, writeEncodedStringHeader(buffer, size));
+}
+
 /**
 * @brief Reads data from the given @a stream up to @a sentinel, which is left
 *        in @a stream.
@@ -75,4 +362,132 @@ std::string replace(const std::string &str, char what,
 	return result;
 }
 
+/**
+* @brief Returns the index of the first of the given special @a chars in
+*        @a size bytes starting at @a data, or @a size if there is none.
+*
+* It is used to find the characters that have to be escaped in quoted
+* strings, so runs of the other characters can be copied at once. With SSE2,
+* 16 characters are checked at once.
+*/
+std::size_t findSpecialChar(const char *data, std::size_t size,
+		SpecialChars chars) {
+	std::size_t i = 0;
+#ifdef BENCODING_HAVE_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i lastControl = _mm_set1_epi8(0x1f);
+	// When a character class is not searched for, its comparison is made
+	// redundant (a quote instead of DEL, no bits instead of the highest one),
+	// so the loop has no branches depending on chars.
+	const __m128i del = _mm_set1_epi8(
+		chars == SpecialChars::EscapedOrDel ? 0x7f : '"');
+	const __m128i highBits = _mm_set1_epi8(
+		chars == SpecialChars::EscapedOrNonAscii ? static_cast<char>(0x80) : 0);
+	for (; i + 16 <= size; i += 16) {
+		__m128i chunk = _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(data + i));
+		// An unsigned c is a control character if max(c, 0x1f) == 0x1f.
+		__m128i special = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+				_mm_cmpeq_epi8(chunk, backslash)),
+			_mm_or_si128(
+				_mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControl), lastControl),
+				_mm_cmpeq_epi8(chunk, del)));
+		// movemask picks the highest bit of each byte.
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+			_mm_or_si128(special, _mm_and_si128(chunk, highBits))));
+		if (mask != 0) {
+			return i + static_cast<std::size_t>(__builtin_ctz(mask));
+		}
+	}
+#endif
+	while (i < size &&
+			!isSpecialChar(static_cast<unsigned char>(data[i]), chars)) {
+		++i;
+	}
+	return i;
+}
+
+/**
+* @brief Checks if @a size bytes starting at @a data contain a control
+*        character other than a tab, newline, or carriage return.
+*
+* Such characters do not appear in text, so they indicate binary data. With
+* SSE2, 16 characters are checked at once.
+*/
+bool containsBinaryChar(const char *data, std::size_t size) {
+	std::size_t i = 0;
+#ifdef BENCODING_HAVE_SSE2
+	const __m128i lastControl = _mm_set1_epi8(0x1f);
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i carriageReturn = _mm_set1_epi8('\r');
+	const __m128i del = _mm_set1_epi8(0x7f);
+	for (; i + 16 <= size; i += 16) {
+		__m128i chunk = _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(data + i));
+		__m128i control = _mm_cmpeq_epi8(
+			_mm_max_epu8(chunk, lastControl), lastControl);
+		__m128i text = _mm_or_si128(_mm_cmpeq_epi8(chunk, tab),
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, newline),
+				_mm_cmpeq_epi8(chunk, carriageReturn)));
+		__m128i binary = _mm_or_si128(_mm_andnot_si128(text, control),
+			_mm_cmpeq_epi8(chunk, del));
+		if (_mm_movemask_epi8(binary) != 0) {
+			return true;
+		}
+	}
+#endif
+	for (; i < size; ++i) {
+		if (isBinaryChar(static_cast<unsigned char>(data[i]))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+* @brief Computes SipHash-2-4 of the given data under the given 128-bit key.
+*
+* @param[in] data Data to be hashed.
+* @param[in] size Number of bytes in @a data.
+* @param[in] key0 Lower half of the key.
+* @param[in] key1 Upper half of the key.
+*
+* SipHash is a keyed hash: without the key, it is infeasible to find inputs
+* with colliding hashes. Hash tables whose keys come from untrusted input
+* should therefore use it with a randomly chosen key.
+*/
+std::uint64_t sipHash(const char *data, std::size_t size,
+		std::uint64_t key0, std::uint64_t key1) {
+	std::uint64_t v0 = key0 ^ 0x736f6d6570736575ULL;
+	std::uint64_t v1 = key1 ^ 0x646f72616e646f6dULL;
+	std::uint64_t v2 = key0 ^ 0x6c7967656e657261ULL;
+	std::uint64_t v3 = key1 ^ 0x7465646279746573ULL;
+
+	const char *end = data + size - size % 8;
+	for (; data != end; data += 8) {
+		std::uint64_t m = readLittleEndian(data, 8);
+		v3 ^= m;
+		sipRound(v0, v1, v2, v3);
+		sipRound(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+
+	std::uint64_t length = size;
+	std::uint64_t m = (length << 56) | readLittleEndian(data, size % 8);
+	v3 ^= m;
+	sipRound(v0, v1, v2, v3);
+	sipRound(v0, v1, v2, v3);
+	v0 ^= m;
+
+	v2 ^= 0xff;
+	sipRound(v0, v1, v2, v3);
+	sipRound(v0, v1, v2, v3);
+	sipRound(v0, v1, v2, v3);
+	sipRound(v0, v1, v2, v3);
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
 } // namespace bencoding
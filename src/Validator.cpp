@@ -0,0 +1,258 @@
+/**
+* @file      Validator.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Implementation of the validation of canonical bencoded data.
+*/
+
+#include "Validator.h"
+
+#include <cstring>
+
+#include "Decoder.h"
+#include "Scanner.h"
+
+namespace bencoding {
+
+namespace {
+
+/**
+* @brief Single pass checker of canonical bencoded data.
+*
+* Errors are reported through a pointer to a static message, so the checker
+* never allocates.
+*/
+class CanonicalChecker {
+public:
+	CanonicalChecker(const char *data, std::size_t size):
+		first(data), current(data), last(data + size), error(nullptr) {}
+
+	bool check();
+
+	/// Returns the message describing the first violation.
+	const char *errorMessage() const { return error; }
+
+	/// Returns the position of the first violation.
+	std::size_t errorPosition() const { return current - first; }
+
+private:
+	bool checkItem(std::size_t depth);
+	bool checkDictionary(std::size_t depth);
+	bool checkList(std::size_t depth);
+	bool checkInteger();
+	bool checkString(StringRef *str);
+	bool fail(const char *message);
+
+	bool atEnd() const { return current == last; }
+	static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+private:
+	const char *first;
+	const char *current;
+	const char *last;
+	const char *error;
+};
+
+/**
+* @brief Checks that the data contain exactly one canonical item.
+*/
+bool CanonicalChecker::check() {
+	if (!checkItem(0)) {
+		return false;
+	}
+	if (!atEnd()) {
+		return fail("input contains undecoded characters");
+	}
+	return true;
+}
+
+bool CanonicalChecker::checkItem(std::size_t depth) {
+	if (atEnd()) {
+		return fail("unexpected end of data");
+	}
+	switch (*current) {
+		case 'd':
+			return checkDictionary(depth);
+		case 'l':
+			return checkList(depth);
+		case 'i':
+			return checkInteger();
+		default:
+			return checkString(nullptr);
+	}
+}
+
+bool CanonicalChecker::checkDictionary(std::size_t depth) {
+	if (depth >= MAX_VALIDATED_NESTING_DEPTH) {
+		return fail("nesting is too deep");
+	}
+	++current;
+	bool isFirstKey = true;
+	StringRef previousKey;
+	while (!atEnd() && *current != 'e') {
+		const char *keyStart = current;
+		StringRef key;
+		if (!checkString(&key)) {
+			return false;
+		}
+		int order = isFirstKey ? -1 : previousKey.compare(key);
+		if (order >= 0) {
+			// Report the violation at the beginning of the key.
+			current = keyStart;
+			return fail(order == 0 ? "duplicate dictionary key" :
+				"dictionary keys are not sorted");
+		}
+		isFirstKey = false;
+		previousKey = key;
+		if (!checkItem(depth + 1)) {
+			return false;
+		}
+	}
+	if (atEnd()) {
+		return fail("unterminated dictionary");
+	}
+	++current;
+	return true;
+}
+
+bool CanonicalChecker::checkList(std::size_t depth) {
+	if (depth >= MAX_VALIDATED_NESTING_DEPTH) {
+		return fail("nesting is too deep");
+	}
+	++current;
+	while (!atEnd() && *current != 'e') {
+		if (!checkItem(depth + 1)) {
+			return false;
+		}
+	}
+	if (atEnd()) {
+		return fail("unterminated list");
+	}
+	++current;
+	return true;
+}
+
+bool CanonicalChecker::checkInteger() {
+	++current;
+	bool negative = false;
+	if (!atEnd() && *current == '-') {
+		negative = true;
+		++current;
+	}
+	const char *digits = current;
+	while (!atEnd() && isDigit(*current)) {
+		++current;
+	}
+	std::size_t numOfDigits = current - digits;
+	if (numOfDigits == 0) {
+		return fail("integer without digits");
+	} else if (*digits == '0' && numOfDigits > 1) {
+		return fail("integer with leading zeros");
+	} else if (*digits == '0' && negative) {
+		return fail("negative zero");
+	} else if (numOfDigits > 19 || (numOfDigits == 19 && std::memcmp(digits,
+			negative ? "9223372036854775808" : "9223372036854775807", 19) > 0)) {
+		// Such integers cannot be decoded into BInteger::ValueType.
+		return fail("integer does not fit into 64 bits");
+	} else if (atEnd() || *current != 'e') {
+		return fail("unterminated integer");
+	}
+	++current;
+	return true;
+}
+
+/**
+* @brief Checks a string and stores a reference to its contents into @a str
+*        (if it is non-null).
+*/
+bool CanonicalChecker::checkString(StringRef *str) {
+	if (atEnd() || !isDigit(*current)) {
+		return fail(str ? "dictionary key is not a string" : "unexpected character");
+	}
+	const char *digits = current;
+	std::size_t length = 0;
+	while (!atEnd() && isDigit(*current)) {
+		length = length * 10 + static_cast<std::size_t>(*current - '0');
+		if (length > static_cast<std::size_t>(last - current)) {
+			return fail("string length exceeds the size of the data");
+		}
+		++current;
+	}
+	if (*digits == '0' && current - digits > 1) {
+		return fail("string length with leading zeros");
+	} else if (atEnd() || *current != ':') {
+		return fail("missing colon after string length");
+	}
+	++current;
+	if (length > static_cast<std::size_t>(last - current)) {
+		return fail("string length exceeds the size of the data");
+	}
+	if (str) {
+		*str = StringRef(current, length);
+	}
+	current += length;
+	return true;
+}
+
+bool CanonicalChecker::fail(const char *message) {
+	error = message;
+	return false;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Checks that @a size bytes starting at @a data are canonically
+*        bencoded.
+*
+* The data are canonical when they contain exactly one item and
+*  - dictionary keys are strings sorted by their raw bytes without duplicates,
+*  - integers and string lengths have no leading zeros,
+*  - there is no negative zero (@c i-0e).
+*
+* Canonical data are re-encoded by Encoder to exactly the same bytes. The check
+* is a single linear scan that neither builds BItems nor allocates memory.
+* Lists and dictionaries can be nested up to @c MAX_VALIDATED_NESTING_DEPTH.
+*
+* When the data are not canonical, DecodingError describing the first
+* violation is thrown.
+*/
+void validate(const char *data, std::size_t size) {
+	CanonicalChecker checker(data, size);
+	if (!checker.check()) {
+		throw DecodingError(std::string(checker.errorMessage()) +
+			" at offset " + std::to_string(checker.errorPosition()));
+	}
+}
+
+/**
+* @brief Checks that @a data are canonically bencoded.
+*
+* See validate(const char *, std::size_t) for more details.
+*/
+void validate(const std::string &data) {
+	validate(data.data(), data.size());
+}
+
+/**
+* @brief Returns @c true if @a size bytes starting at @a data are canonically
+*        bencoded, @c false otherwise.
+*
+* In contrast to validate(), this function does not throw.
+*/
+bool isCanonical(const char *data, std::size_t size) {
+	CanonicalChecker checker(data, size);
+	return checker.check();
+}
+
+/**
+* @brief Returns @c true if @a data are canonically bencoded, @c false
+*        otherwise.
+*
+* See isCanonical(const char *, std::size_t) for more details.
+*/
+bool isCanonical(const std::string &data) {
+	return isCanonical(data.data(), data.size());
+}
+
+} // namespace bencoding
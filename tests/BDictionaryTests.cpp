@@ -5,6 +5,10 @@
 * @brief     Tests for the BDictionary class.
 */
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "BDictionary.h"
@@ -16,7 +20,31 @@ namespace tests {
 
 using namespace testing;
 
-class BDictionaryTests: public Test {};
+class BDictionaryTests: public Test {
+protected:
+	static std::shared_ptr<BDictionary> createWideDictionary(int numOfItems);
+	static std::string keyFor(int i);
+};
+
+/**
+* @brief Creates a dictionary mapping keyFor(i) to @c i for @c i in
+*        [0, @a numOfItems).
+*/
+std::shared_ptr<BDictionary> BDictionaryTests::createWideDictionary(
+		int numOfItems) {
+	auto d = BDictionary::create();
+	for (int i = 0; i < numOfItems; ++i) {
+		(*d)[keyFor(i)] = BInteger::create(i);
+	}
+	return d;
+}
+
+/**
+* @brief Returns a key for the given number.
+*/
+std::string BDictionaryTests::keyFor(int i) {
+	return "key" + std::to_string(i);
+}
 
 TEST_F(BDictionaryTests,
 DictionaryIsEmptyAfterCreation) {
@@ -142,5 +170,292 @@ IterationWorksCorrectlyOverDictionaryWithTwoItems) {
 	ASSERT_EQ(d->end(), i);
 }
 
+//
+// Bulk creation and hinted insertion.
+//
+
+TEST_F(BDictionaryTests,
+DictionaryCreatedFromSortedVectorOfItemsContainsTheItems) {
+	std::vector<BDictionary::value_type> items{
+		{BString::create("a"), BInteger::create(1)},
+		{BString::create("b"), BInteger::create(2)}
+	};
+
+	auto d = BDictionary::create(items);
+
+	ASSERT_EQ(2, d->size());
+	EXPECT_EQ(items[0].second, (*d)["a"]);
+	EXPECT_EQ(items[1].second, (*d)["b"]);
+}
+
+TEST_F(BDictionaryTests,
+DictionaryCreatedFromUnsortedVectorOfItemsIsSortedAndLastValueWins) {
+	auto d = BDictionary::create(std::vector<BDictionary::value_type>{
+		{BString::create("b"), BInteger::create(1)},
+		{BString::create("a"), BInteger::create(2)},
+		{BString::create("b"), BInteger::create(3)}
+	});
+
+	ASSERT_EQ(2, d->size());
+	EXPECT_EQ("a", *d->begin()->first->value());
+	EXPECT_EQ(3, d->getValue<BInteger>("b")->value());
+}
+
+TEST_F(BDictionaryTests,
+InsertWithHintInsertsItemWithNewKey) {
+	auto d = BDictionary::create();
+	(*d)["a"] = BInteger::create(1);
+
+	auto i = d->insert(d->end(),
+		BDictionary::value_type(BString::create("b"), BInteger::create(2)));
+
+	EXPECT_EQ("b", *i->first->value());
+	EXPECT_EQ(2, d->size());
+}
+
+TEST_F(BDictionaryTests,
+InsertWithHintDoesNotReplaceItemWithExistingKey) {
+	auto d = BDictionary::create();
+	auto value = BInteger::create(1);
+	(*d)["a"] = value;
+
+	auto i = d->insert(d->end(),
+		BDictionary::value_type(BString::create("a"), BInteger::create(2)));
+
+	EXPECT_EQ(value, i->second);
+	EXPECT_EQ(1, d->size());
+}
+
+TEST_F(BDictionaryTests,
+InsertWithHintUpdatesHashIndex) {
+	auto d = createWideDictionary(BDictionary::HASH_INDEX_THRESHOLD);
+	ASSERT_TRUE(d->hasKey("key0"));
+	ASSERT_TRUE(d->isHashIndexed());
+
+	d->insert(d->end(),
+		BDictionary::value_type(BString::create("zzz"), BInteger::create(1)));
+
+	EXPECT_TRUE(d->hasKey("zzz"));
+}
+
+//
+// Lookup.
+//
+
+TEST_F(BDictionaryTests,
+FindReturnsIteratorToItemWithGivenKey) {
+	auto d = BDictionary::create();
+	(*d)["a"] = BInteger::create(1);
+
+	auto i = d->find("a");
+	ASSERT_NE(d->end(), i);
+	EXPECT_EQ(1, i->second->as<BInteger>()->value());
+	EXPECT_EQ(i, d->find(BString::create("a")));
+}
+
+TEST_F(BDictionaryTests,
+FindReturnsEndWhenThereIsNoItemWithGivenKey) {
+	auto d = BDictionary::create();
+	(*d)["a"] = BInteger::create(1);
+
+	EXPECT_EQ(d->end(), d->find("b"));
+}
+
+TEST_F(BDictionaryTests,
+SmallDictionaryIsNotHashIndexed) {
+	auto d = createWideDictionary(10);
+
+	d->find("key1");
+
+	EXPECT_FALSE(d->isHashIndexed());
+}
+
+TEST_F(BDictionaryTests,
+WideDictionaryIsHashIndexedUponLookup) {
+	const int numOfItems = BDictionary::HASH_INDEX_THRESHOLD * 4;
+	auto d = createWideDictionary(numOfItems);
+
+	for (int i = 0; i < numOfItems; ++i) {
+		auto item = d->find(keyFor(i));
+		ASSERT_NE(d->end(), item) << "key: " << keyFor(i);
+		EXPECT_EQ(i, item->second->as<BInteger>()->value());
+	}
+	EXPECT_EQ(d->end(), d->find("missing"));
+	EXPECT_TRUE(d->isHashIndexed());
+}
+
+TEST_F(BDictionaryTests,
+HashIndexedDictionaryIsIteratedInSortedOrder) {
+	auto d = createWideDictionary(BDictionary::HASH_INDEX_THRESHOLD * 2);
+	ASSERT_TRUE(d->hasKey("key0"));
+
+	std::string previousKey;
+	for (const auto &item : *d) {
+		EXPECT_LT(previousKey, *item.first->value());
+		previousKey = *item.first->value();
+	}
+}
+
+TEST_F(BDictionaryTests,
+HashIndexIsKeptUpToDateByInsertionsAndErasures) {
+	const int numOfItems = BDictionary::HASH_INDEX_THRESHOLD * 2;
+	auto d = createWideDictionary(numOfItems);
+	std::map<std::string, int> expected;
+	for (int i = 0; i < numOfItems; ++i) {
+		expected[keyFor(i)] = i;
+	}
+	ASSERT_TRUE(d->hasKey("key0"));
+
+	// Erase every third item and insert new items (which also grows the
+	// index).
+	for (int i = 0; i < numOfItems; i += 3) {
+		EXPECT_EQ(1, d->erase(keyFor(i)));
+		expected.erase(keyFor(i));
+	}
+	for (int i = numOfItems; i < 3 * numOfItems; ++i) {
+		(*d)[keyFor(i)] = BInteger::create(i);
+		expected[keyFor(i)] = i;
+	}
+
+	ASSERT_EQ(expected.size(), d->size());
+	for (int i = 0; i < 3 * numOfItems; ++i) {
+		auto item = d->find(keyFor(i));
+		if (expected.count(keyFor(i))) {
+			ASSERT_NE(d->end(), item) << "key: " << keyFor(i);
+			EXPECT_EQ(i, item->second->as<BInteger>()->value());
+		} else {
+			EXPECT_EQ(d->end(), item) << "key: " << keyFor(i);
+		}
+	}
+}
+
+TEST_F(BDictionaryTests,
+EraseReturnsZeroWhenThereIsNoItemWithGivenKey) {
+	auto d = createWideDictionary(BDictionary::HASH_INDEX_THRESHOLD);
+
+	EXPECT_EQ(0, d->erase("missing"));
+	EXPECT_EQ(BDictionary::HASH_INDEX_THRESHOLD, d->size());
+}
+
+//
+// Structural sharing.
+//
+
+TEST_F(BDictionaryTests,
+CloneSharesValuesWithOriginalDictionary) {
+	auto d = BDictionary::create({
+		{BString::create("a"), BInteger::create(1)}
+	});
+
+	auto copy = d->clone();
+
+	ASSERT_EQ(1, copy->size());
+	EXPECT_EQ((*d)["a"], (*copy)["a"]);
+	EXPECT_FALSE(copy->isFrozen());
+}
+
+TEST_F(BDictionaryTests,
+ModifyingCloneDoesNotModifyOriginalDictionary) {
+	auto d = BDictionary::create({
+		{BString::create("a"), BInteger::create(1)}
+	});
+
+	auto copy = d->clone();
+	(*copy)["b"] = BInteger::create(2);
+	copy->erase("a");
+
+	EXPECT_EQ(1, d->size());
+	EXPECT_TRUE(d->hasKey("a"));
+	EXPECT_EQ(1, copy->size());
+	EXPECT_TRUE(copy->hasKey("b"));
+}
+
+TEST_F(BDictionaryTests,
+CloneOfHashIndexedDictionaryFindsAllItems) {
+	auto d = createWideDictionary(BDictionary::HASH_INDEX_THRESHOLD);
+	ASSERT_NE(d->end(), d->find(keyFor(0)));
+
+	auto copy = d->clone();
+	(*copy)["new"] = BInteger::create(0);
+
+	for (int i = 0; i < static_cast<int>(BDictionary::HASH_INDEX_THRESHOLD); ++i) {
+		ASSERT_NE(copy->end(), copy->find(keyFor(i))) << "key: " << keyFor(i);
+	}
+	EXPECT_EQ(d->end(), d->find("new"));
+}
+
+TEST_F(BDictionaryTests,
+FreezeFreezesDictionaryItsKeysAndValues) {
+	auto key = BString::create("a");
+	auto value = BInteger::create(1);
+	auto d = BDictionary::create({{key, value}});
+
+	d->freeze();
+
+	EXPECT_TRUE(d->isFrozen());
+	EXPECT_TRUE(key->isFrozen());
+	EXPECT_TRUE(value->isFrozen());
+}
+
+TEST_F(BDictionaryTests,
+ModifiersThrowFrozenItemErrorWhenDictionaryIsFrozen) {
+	auto d = BDictionary::create({{BString::create("a"), BInteger::create(1)}});
+	d->freeze();
+
+	EXPECT_THROW(d->setValue("b", BInteger::create(2)), FrozenItemError);
+	EXPECT_THROW(d->erase("a"), FrozenItemError);
+	EXPECT_THROW(d->unfrozenValue("a"), FrozenItemError);
+	EXPECT_EQ(1, d->size());
+}
+
+TEST_F(BDictionaryTests,
+AccessOperatorThrowsFrozenItemErrorEvenForExistingKeyWhenDictionaryIsFrozen) {
+	auto d = BDictionary::create({{BString::create("a"), BInteger::create(1)}});
+	d->freeze();
+
+	EXPECT_THROW((*d)["a"], FrozenItemError);
+	EXPECT_THROW((*d)[BString::create("a")], FrozenItemError);
+}
+
+TEST_F(BDictionaryTests,
+FindByStringValueFindsItemInSmallDictionary) {
+	auto value = BInteger::create(1);
+	auto d = BDictionary::create({
+		{BString::create("a"), BInteger::create(0)},
+		{BString::create("b"), value}
+	});
+
+	const BDictionary &constD = *d;
+	EXPECT_EQ(value, constD.find("b")->second);
+	EXPECT_EQ(constD.end(), constD.find("c"));
+}
+
+TEST_F(BDictionaryTests,
+UnfrozenValueCopiesFrozenValueOnPathToModification) {
+	auto info = BDictionary::create({
+		{BString::create("name"), BString::create("old")},
+		{BString::create("length"), BInteger::create(1)}
+	});
+	auto d = BDictionary::create({{BString::create("info"), info}});
+	d->freeze();
+
+	auto copy = d->clone();
+	auto copiedInfo = copy->unfrozenValue("info")->as<BDictionary>();
+	(*copiedInfo)["name"] = BString::create("new");
+
+	EXPECT_EQ("old", *info->getValue<BString>("name")->value());
+	EXPECT_EQ("new", *(*copiedInfo)["name"]->as<BString>()->value());
+	EXPECT_EQ(info->getValue<BItem>("length"), (*copiedInfo)["length"]);
+	EXPECT_EQ(info, d->getValue<BItem>("info"));
+}
+
+TEST_F(BDictionaryTests,
+UnfrozenValueReturnsNullPointerForMissingKey) {
+	auto d = BDictionary::create();
+
+	EXPECT_EQ(nullptr, d->unfrozenValue("missing"));
+	EXPECT_EQ(nullptr, d->unfrozenValue(BString::create("missing")));
+}
+
 } // namespace tests
 } // namespace bencoding
@@ -31,5 +31,28 @@ ValueReturnsCorrectValueAfterSet) {
 	EXPECT_EQ(10, i->value());
 }
 
+TEST_F(BIntegerTests,
+CloneHasSameValueAndIsNotFrozen) {
+	auto i = BInteger::create(5);
+	i->freeze();
+
+	auto copy = i->clone();
+	copy->setValue(10);
+
+	EXPECT_TRUE(i->isFrozen());
+	EXPECT_FALSE(copy->isFrozen());
+	EXPECT_EQ(5, i->value());
+	EXPECT_EQ(10, copy->value());
+}
+
+TEST_F(BIntegerTests,
+SetValueThrowsFrozenItemErrorWhenIntegerIsFrozen) {
+	auto i = BInteger::create(5);
+	i->freeze();
+
+	EXPECT_THROW(i->setValue(10), FrozenItemError);
+	EXPECT_EQ(5, i->value());
+}
+
 } // namespace tests
 } // namespace bencoding
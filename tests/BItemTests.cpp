@@ -0,0 +1,214 @@
+/**
+* @file      BItemTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the BItem class.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BItem.h"
+#include "BItemDispatch.h"
+#include "BList.h"
+#include "BString.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class BItemTests: public Test {};
+
+//
+// Type.
+//
+
+TEST_F(BItemTests,
+TypeReturnsTypeOfItem) {
+	EXPECT_EQ(BItem::Type::Integer, BInteger::create(1)->type());
+	EXPECT_EQ(BItem::Type::String, BString::create("")->type());
+	EXPECT_EQ(BItem::Type::List, BList::create()->type());
+	EXPECT_EQ(BItem::Type::Dictionary, BDictionary::create()->type());
+}
+
+TEST_F(BItemTests,
+IsReturnsTrueOnlyForTypeOfItem) {
+	std::shared_ptr<BItem> item(BList::create());
+
+	EXPECT_TRUE(item->is<BList>());
+	EXPECT_TRUE(item->is<BItem>());
+	EXPECT_FALSE(item->is<BInteger>());
+	EXPECT_FALSE(item->is<BString>());
+	EXPECT_FALSE(item->is<BDictionary>());
+}
+
+TEST_F(BItemTests,
+ClonedAndPackedItemsHaveCorrectType) {
+	auto list = BList::createPackedStrings({"a"});
+
+	EXPECT_TRUE((*list)[0]->is<BString>());
+	EXPECT_TRUE(list->clone()->is<BList>());
+}
+
+//
+// Casting.
+//
+
+TEST_F(BItemTests,
+AsReturnsItemOfCorrectTypeSharingOwnership) {
+	std::shared_ptr<BItem> item(BInteger::create(5));
+
+	auto bInteger = item->as<BInteger>();
+
+	ASSERT_TRUE(bInteger != nullptr);
+	EXPECT_EQ(5, bInteger->value());
+	EXPECT_EQ(2, item.use_count());
+}
+
+TEST_F(BItemTests,
+AsReturnsNullPointerForItemOfOtherType) {
+	std::shared_ptr<BItem> item(BInteger::create(5));
+
+	EXPECT_EQ(nullptr, item->as<BString>());
+	EXPECT_EQ(1, item.use_count());
+}
+
+TEST_F(BItemTests,
+AsPtrReturnsItemOfCorrectTypeWithoutSharingOwnership) {
+	std::shared_ptr<BItem> item(BString::create("test"));
+
+	BString *bString = item->asPtr<BString>();
+
+	EXPECT_EQ(item.get(), bString);
+	EXPECT_EQ(1, item.use_count());
+}
+
+TEST_F(BItemTests,
+AsPtrReturnsNullPointerForItemOfOtherType) {
+	std::shared_ptr<const BItem> item(BString::create("test"));
+
+	EXPECT_EQ(nullptr, item->asPtr<BList>());
+	EXPECT_EQ(nullptr, item->asPtr<BDictionary>());
+}
+
+TEST_F(BItemTests,
+GetItemPtrAndGetValuePtrDoNotShareOwnership) {
+	auto bInteger = BInteger::create(1);
+	auto list = BList::create({bInteger});
+	auto dict = BDictionary::create({{BString::create("a"), bInteger}});
+
+	EXPECT_EQ(bInteger.get(), list->getItemPtr<BInteger>(0));
+	EXPECT_EQ(bInteger.get(), dict->getValuePtr<BInteger>("a"));
+	EXPECT_EQ(nullptr, dict->getValuePtr<BInteger>("b"));
+	EXPECT_EQ(nullptr, dict->getValuePtr<BString>("a"));
+	EXPECT_EQ(3, bInteger.use_count());
+}
+
+TEST_F(BItemTests,
+ItemCastSharesOwnershipWithGivenPointer) {
+	std::shared_ptr<BItem> item(BInteger::create(5));
+
+	auto bInteger = itemCast<BInteger>(item);
+
+	EXPECT_EQ(item.get(), bInteger.get());
+	EXPECT_EQ(2, item.use_count());
+	EXPECT_EQ(nullptr, itemCast<BString>(item));
+	EXPECT_EQ(nullptr, itemCast<BString>(std::shared_ptr<BItem>()));
+}
+
+TEST_F(BItemTests,
+AsToBItemReturnsSameItem) {
+	std::shared_ptr<BItem> item(BInteger::create(1));
+
+	EXPECT_EQ(item, item->as<BItem>());
+	EXPECT_EQ(item.get(), item->asPtr<BItem>());
+}
+
+//
+// Dispatching.
+//
+
+namespace {
+
+/**
+* @brief Returns a description of the item it is called with.
+*/
+class Describer {
+public:
+	std::string operator()(BInteger &bInteger) const {
+		return "integer " + std::to_string(bInteger.value());
+	}
+
+	std::string operator()(BString &bString) const {
+		return "string " + *bString.value();
+	}
+
+	std::string operator()(BList &bList) const {
+		return "list of " + std::to_string(bList.size());
+	}
+
+	std::string operator()(BDictionary &bDictionary) const {
+		return "dictionary of " + std::to_string(bDictionary.size());
+	}
+};
+
+/**
+* @brief Returns the number of items in the item it is called with
+*        (including itself).
+*/
+class Counter {
+public:
+	std::size_t operator()(const BInteger &) const {
+		return 1;
+	}
+
+	std::size_t operator()(const BString &) const {
+		return 1;
+	}
+
+	std::size_t operator()(const BList &bList) const {
+		std::size_t count = 1;
+		for (const auto &item : bList) {
+			count += dispatch(*item, *this);
+		}
+		return count;
+	}
+
+	std::size_t operator()(const BDictionary &bDictionary) const {
+		std::size_t count = 1;
+		for (const auto &item : bDictionary) {
+			count += dispatch(*item.second, *this);
+		}
+		return count;
+	}
+};
+
+} // anonymous namespace
+
+TEST_F(BItemTests,
+DispatchCallsFunctionWithItemOfCorrectType) {
+	EXPECT_EQ("integer 5", dispatch(*BInteger::create(5), Describer()));
+	EXPECT_EQ("string test", dispatch(*BString::create("test"), Describer()));
+	EXPECT_EQ("list of 1", dispatch(*BList::create({BInteger::create(1)}),
+		Describer()));
+	EXPECT_EQ("dictionary of 0", dispatch(*BDictionary::create(), Describer()));
+}
+
+TEST_F(BItemTests,
+DispatchWorksWithConstantItems) {
+	std::shared_ptr<const BItem> item(BDictionary::create({
+		{BString::create("a"), BList::create({BInteger::create(1),
+			BString::create("b")})}
+	}));
+
+	EXPECT_EQ(4, dispatch(*item, Counter()));
+}
+
+} // namespace tests
+} // namespace bencoding
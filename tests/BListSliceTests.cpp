@@ -0,0 +1,100 @@
+/**
+* @file      BListSliceTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the BListSlice class.
+*/
+
+#include <gtest/gtest.h>
+
+#include "BInteger.h"
+#include "BList.h"
+#include "BListSlice.h"
+#include "BString.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class BListSliceTests: public Test {
+protected:
+	BListSliceTests(): list(BList::create()) {
+		for (int i = 0; i < 5; ++i) {
+			list->push_back(BInteger::create(i));
+		}
+	}
+
+protected:
+	std::shared_ptr<BList> list;
+};
+
+TEST_F(BListSliceTests,
+DefaultConstructedSliceIsEmpty) {
+	BListSlice slice;
+
+	EXPECT_TRUE(slice.empty());
+	EXPECT_EQ(0, slice.size());
+	EXPECT_EQ(slice.begin(), slice.end());
+}
+
+TEST_F(BListSliceTests,
+SliceRefersToItemsOfListWithoutCopyingThem) {
+	auto slice = list->slice(1, 4);
+
+	ASSERT_EQ(3, slice.size());
+	EXPECT_EQ((*list)[1], slice[0]);
+	EXPECT_EQ((*list)[3], slice[2]);
+	EXPECT_EQ((*list)[1], slice.front());
+	EXPECT_EQ((*list)[3], slice.back());
+}
+
+TEST_F(BListSliceTests,
+SliceOfPackedListReadsPackedValuesWithoutConvertingList) {
+	auto packed = BList::createPackedStrings({"a", "b", "c"});
+
+	auto slice = packed->slice(1);
+
+	ASSERT_EQ(2, slice.size());
+	EXPECT_EQ("b", *slice.front()->as<BString>()->value());
+	EXPECT_EQ("c", *slice[1]->as<BString>()->value());
+	EXPECT_EQ(BList::Storage::PackedStrings, packed->storage());
+}
+
+TEST_F(BListSliceTests,
+SliceCountsNegativeIndexesFromEnd) {
+	auto slice = list->slice(-2);
+
+	ASSERT_EQ(2, slice.size());
+	EXPECT_EQ(3, slice.front()->as<BInteger>()->value());
+	EXPECT_EQ(4, slice.back()->as<BInteger>()->value());
+}
+
+TEST_F(BListSliceTests,
+SliceIsEmptyWhenStartIndexIsNotLessThanEndIndex) {
+	EXPECT_TRUE(list->slice(3, 3).empty());
+	EXPECT_TRUE(list->slice(4, 2).empty());
+}
+
+TEST_F(BListSliceTests,
+IterationWorksCorrectlyOverSlice) {
+	auto slice = list->slice(2, 5);
+
+	BInteger::ValueType expectedValue = 2;
+	for (const auto &item : slice) {
+		EXPECT_EQ(expectedValue++, item->as<BInteger>()->value());
+	}
+	EXPECT_EQ(5, expectedValue);
+}
+
+TEST_F(BListSliceTests,
+ToListCreatesListSharingItemsOfSlice) {
+	auto sliceList = list->slice(1, 3).toList();
+
+	ASSERT_EQ(2, sliceList->size());
+	EXPECT_EQ((*list)[1], (*sliceList)[0]);
+	EXPECT_EQ((*list)[2], (*sliceList)[1]);
+}
+
+} // namespace tests
+} // namespace bencoding
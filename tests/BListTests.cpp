@@ -5,17 +5,50 @@
 * @brief     Tests for the BList class.
 */
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "BInteger.h"
 #include "BList.h"
+#include "BString.h"
 
 namespace bencoding {
 namespace tests {
 
 using namespace testing;
 
-class BListTests: public Test {};
+class BListTests: public Test {
+protected:
+	static std::shared_ptr<BList> createListOfIntegers(int count);
+	static std::vector<BInteger::ValueType> valuesOf(
+		const std::shared_ptr<BList> &list);
+};
+
+/**
+* @brief Creates a list containing integers 0, 1, ..., @a count - 1.
+*/
+std::shared_ptr<BList> BListTests::createListOfIntegers(int count) {
+	auto l = BList::create();
+	for (int i = 0; i < count; ++i) {
+		l->push_back(BInteger::create(i));
+	}
+	return l;
+}
+
+/**
+* @brief Returns values of the integers in the given list.
+*/
+std::vector<BInteger::ValueType> BListTests::valuesOf(
+		const std::shared_ptr<BList> &list) {
+	std::vector<BInteger::ValueType> values;
+	// getItem() works also for frozen lists.
+	for (BList::size_type i = 0; i < list->size(); ++i) {
+		values.push_back(list->getItem<BInteger>(i)->value());
+	}
+	return values;
+}
 
 TEST_F(BListTests,
 ListIsEmptyAfterCreation) {
@@ -204,5 +237,325 @@ IterationWorksCorrectlyOverConstantListWithTwoItemsUsingCPrefixedMethods) {
 	ASSERT_EQ(cl->cend(), i);
 }
 
+//
+// Packed storage.
+//
+
+TEST_F(BListTests,
+ListIsStoredAsItemsAfterCreation) {
+	EXPECT_EQ(BList::Storage::Items, BList::create()->storage());
+}
+
+TEST_F(BListTests,
+PackedIntegersCanBeAccessedWithoutConvertingList) {
+	auto l = BList::createPackedIntegers({1, 2, 3});
+
+	ASSERT_EQ(3, l->size());
+	EXPECT_EQ(2, l->integerAt(1));
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, 2, 3}), l->packedIntegers());
+	EXPECT_EQ(BList::Storage::PackedIntegers, l->storage());
+}
+
+TEST_F(BListTests,
+PackedStringsCanBeAccessedWithoutConvertingList) {
+	auto l = BList::createPackedStrings({"a", "bc"});
+
+	ASSERT_EQ(2, l->size());
+	EXPECT_EQ("bc", l->stringAt(1));
+	EXPECT_EQ(BList::Storage::PackedStrings, l->storage());
+}
+
+TEST_F(BListTests,
+IntegerAtAndStringAtWorkAlsoForListsStoredAsItems) {
+	auto l = BList::create();
+	l->push_back(BInteger::create(5));
+	l->push_back(BString::create("x"));
+
+	EXPECT_EQ(5, l->integerAt(0));
+	EXPECT_EQ("x", l->stringAt(1));
+}
+
+TEST_F(BListTests,
+AccessToItemsConvertsPackedIntegersIntoItems) {
+	auto l = BList::createPackedIntegers({1, 2, 3});
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, 2, 3}), valuesOf(l));
+	EXPECT_EQ(BList::Storage::Items, l->storage());
+	EXPECT_EQ(3, l->size());
+}
+
+TEST_F(BListTests,
+AccessToItemsConvertsPackedStringsIntoItems) {
+	auto l = BList::createPackedStrings({"a", "bc"});
+
+	auto first = l->front()->as<BString>();
+	ASSERT_TRUE(first != nullptr);
+	EXPECT_EQ("a", *first->value());
+	EXPECT_EQ(BList::Storage::Items, l->storage());
+	// The conversion happens only once, so the items keep their identity.
+	EXPECT_EQ(first, l->front());
+}
+
+TEST_F(BListTests,
+AppendingItemToPackedListConvertsList) {
+	auto l = BList::createPackedIntegers({1});
+
+	l->push_back(BString::create("a"));
+
+	ASSERT_EQ(2, l->size());
+	EXPECT_EQ(1, l->integerAt(0));
+	EXPECT_EQ("a", l->stringAt(1));
+}
+
+TEST_F(BListTests,
+PopBackAndRangeEraseKeepListPacked) {
+	auto l = BList::createPackedIntegers({0, 1, 2, 3, 4});
+
+	l->pop_back();
+	l->range_erase(1, 3);
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 3}), l->packedIntegers());
+}
+
+TEST_F(BListTests,
+ClearResetsStorageToItems) {
+	auto l = BList::createPackedStrings({"a"});
+
+	l->clear();
+
+	EXPECT_TRUE(l->empty());
+	EXPECT_EQ(BList::Storage::Items, l->storage());
+}
+
+TEST_F(BListTests,
+ConstantAccessToItemsDoesNotConvertPackedList) {
+	std::shared_ptr<const BList> l = BList::createPackedIntegers({1, 2, 3});
+
+	std::vector<BInteger::ValueType> values;
+	for (const auto &item : *l) {
+		values.push_back(item->as<BInteger>()->value());
+	}
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, 2, 3}), values);
+	EXPECT_EQ(1, l->front()->as<BInteger>()->value());
+	EXPECT_EQ(3, l->back()->as<BInteger>()->value());
+	EXPECT_EQ(2, (*l)[1]->as<BInteger>()->value());
+	EXPECT_EQ(3, l->cend() - l->cbegin());
+	EXPECT_EQ(BList::Storage::PackedIntegers, l->storage());
+}
+
+TEST_F(BListTests,
+StringReturnedByStringAtStaysValidAfterConstantAccessToItems) {
+	std::shared_ptr<const BList> l = BList::createPackedStrings({"a", "bc"});
+
+	const std::string &str = l->stringAt(1);
+	l->begin();
+	l->front();
+
+	EXPECT_EQ("bc", str);
+	EXPECT_EQ(&str, &l->stringAt(1));
+}
+
+TEST_F(BListTests,
+UnpackConvertsPackedList) {
+	auto l = BList::createPackedStrings({"a"});
+
+	l->unpack();
+
+	EXPECT_EQ(BList::Storage::Items, l->storage());
+	EXPECT_EQ("a", l->stringAt(0));
+}
+
+//
+// Bulk modifications.
+//
+
+TEST_F(BListTests,
+RangeEraseRemovesItemsInGivenRange) {
+	auto l = createListOfIntegers(6);
+
+	l->range_erase(1, 4);
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 4, 5}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+RangeEraseCountsNegativeIndexesFromEnd) {
+	auto l = createListOfIntegers(6);
+
+	l->range_erase(-3, -1);
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 1, 2, 5}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+RangeEraseWithOnlyStartIndexRemovesItemsUpToEnd) {
+	auto l = createListOfIntegers(6);
+
+	l->range_erase(2);
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 1}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+RangeEraseDoesNothingForEmptyRange) {
+	auto l = createListOfIntegers(3);
+
+	l->range_erase(2, 1);
+
+	EXPECT_EQ(3, l->size());
+}
+
+TEST_F(BListTests,
+InsertInsertsItemBeforeGivenPosition) {
+	auto l = createListOfIntegers(2);
+
+	auto i = l->insert(l->begin() + 1, BInteger::create(7));
+
+	EXPECT_EQ(l->begin() + 1, i);
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 7, 1}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+InsertInsertsRangeOfItemsBeforeGivenPosition) {
+	auto l = createListOfIntegers(2);
+	auto other = createListOfIntegers(3);
+
+	auto i = l->insert(l->begin() + 1, other->begin(), other->end());
+
+	EXPECT_EQ(l->begin() + 1, i);
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 0, 1, 2, 1}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+EraseRemovesItemsInGivenRange) {
+	auto l = createListOfIntegers(5);
+
+	auto i = l->erase(l->begin() + 1, l->begin() + 3);
+
+	EXPECT_EQ(l->begin() + 1, i);
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 3, 4}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+EraseRemovesSingleItem) {
+	auto l = createListOfIntegers(3);
+
+	l->erase(l->begin());
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, 2}), valuesOf(l));
+}
+
+TEST_F(BListTests,
+RemoveIfRemovesMatchingItemsAndKeepsOrderOfRemainingItems) {
+	auto l = createListOfIntegers(7);
+
+	auto numOfRemovedItems = l->remove_if(
+		[](const BList::value_type &item) {
+			return item->as<BInteger>()->value() % 2 == 1;
+		}
+	);
+
+	EXPECT_EQ(3, numOfRemovedItems);
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 2, 4, 6}), valuesOf(l));
+}
+
+//
+// Structural sharing.
+//
+
+TEST_F(BListTests,
+CloneSharesItemsWithOriginalList) {
+	auto l = createListOfIntegers(3);
+
+	auto copy = l->clone();
+
+	ASSERT_EQ(3, copy->size());
+	EXPECT_EQ((*l)[1], (*copy)[1]);
+	EXPECT_FALSE(copy->isFrozen());
+}
+
+TEST_F(BListTests,
+CloneOfPackedListStaysPacked) {
+	auto l = BList::createPackedIntegers({1, 2, 3});
+
+	auto copy = l->clone();
+
+	EXPECT_EQ(BList::Storage::PackedIntegers, copy->storage());
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, 2, 3}), copy->packedIntegers());
+}
+
+TEST_F(BListTests,
+ModifyingCloneDoesNotModifyOriginalList) {
+	auto l = createListOfIntegers(3);
+
+	auto copy = l->clone();
+	copy->push_back(BInteger::create(3));
+	copy->erase(copy->begin());
+
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 1, 2}), valuesOf(l));
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, 2, 3}), valuesOf(copy));
+}
+
+TEST_F(BListTests,
+FreezeFreezesListAndItsItems) {
+	auto inner = createListOfIntegers(1);
+	auto l = BList::create({inner});
+
+	l->freeze();
+
+	EXPECT_TRUE(l->isFrozen());
+	EXPECT_TRUE(inner->isFrozen());
+	EXPECT_TRUE(inner->getItem<BInteger>(0)->isFrozen());
+}
+
+TEST_F(BListTests,
+ItemsOfFrozenPackedListAreFrozen) {
+	auto l = BList::createPackedStrings({"a", "b"});
+
+	l->freeze();
+
+	EXPECT_TRUE(l->getItem<BString>(0)->isFrozen());
+}
+
+TEST_F(BListTests,
+ModifiersThrowFrozenItemErrorWhenListIsFrozen) {
+	auto l = BList::create({BInteger::create(1)});
+	l->freeze();
+
+	EXPECT_THROW(l->push_back(BInteger::create(2)), FrozenItemError);
+	EXPECT_THROW(l->pop_back(), FrozenItemError);
+	EXPECT_THROW(l->unfrozenItem(0), FrozenItemError);
+	EXPECT_EQ(1, l->size());
+}
+
+TEST_F(BListTests,
+UnfrozenItemCopiesOnlyFrozenItem) {
+	auto inner = createListOfIntegers(2);
+	auto other = BString::create("test");
+	auto l = BList::create({inner, other});
+	l->freeze();
+	auto copy = l->clone();
+
+	auto item = copy->unfrozenItem(0)->as<BList>();
+	item->push_back(BInteger::create(2));
+
+	EXPECT_NE(inner, item);
+	EXPECT_EQ(item, (*copy)[0]);
+	EXPECT_EQ(other, (*copy)[1]);
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 1}), valuesOf(inner));
+	EXPECT_EQ(std::vector<BInteger::ValueType>({0, 1, 2}), valuesOf(item));
+	// The unchanged items in the copied item are still shared.
+	EXPECT_EQ(inner->getItem<BInteger>(0), item->getItem<BInteger>(0));
+}
+
+TEST_F(BListTests,
+UnfrozenItemReturnsUnfrozenItemAsIs) {
+	auto item = BInteger::create(1);
+	auto l = BList::create({item});
+
+	EXPECT_EQ(item, l->unfrozenItem(0));
+}
+
 } // namespace tests
 } // namespace bencoding
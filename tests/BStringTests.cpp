@@ -38,5 +38,40 @@ LengthReturnsCorrectValue) {
 	EXPECT_EQ(4, s->length());
 }
 
+TEST_F(BStringTests,
+CloneHasSameValueAndIsNotFrozen) {
+	auto s = BString::create("test");
+	s->freeze();
+
+	auto copy = s->clone();
+	copy->setValue("other");
+
+	EXPECT_TRUE(s->isFrozen());
+	EXPECT_FALSE(copy->isFrozen());
+	EXPECT_EQ("test", *s->value());
+	EXPECT_EQ("other", *copy->value());
+}
+
+TEST_F(BStringTests,
+ModifyingValueOfCloneDoesNotChangeFrozenOriginal) {
+	auto s = BString::create("test");
+	s->freeze();
+
+	auto copy = s->clone();
+	*copy->value() = "XYZ";
+
+	EXPECT_EQ("test", *s->value());
+	EXPECT_EQ("XYZ", *copy->value());
+}
+
+TEST_F(BStringTests,
+SetValueThrowsFrozenItemErrorWhenStringIsFrozen) {
+	auto s = BString::create("test");
+	s->freeze();
+
+	EXPECT_THROW(s->setValue("other"), FrozenItemError);
+	EXPECT_EQ("test", *s->value());
+}
+
 } // namespace tests
 } // namespace bencoding
@@ -0,0 +1,326 @@
+/**
+* @file      BinaryCacheTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the binary cache of decoded data.
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "BinaryCache.h"
+#include "Decoder.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class BinaryCacheTests: public Test {
+protected:
+	virtual void TearDown() override;
+
+	std::string createFile(const std::string &content);
+
+protected:
+	/// Path to the file created by the test (if any).
+	std::string createdFile;
+};
+
+void BinaryCacheTests::TearDown() {
+	if (!createdFile.empty()) {
+		std::remove(createdFile.c_str());
+	}
+}
+
+/**
+* @brief Creates a temporary file with the given @a content and returns a
+*        path to it.
+*/
+std::string BinaryCacheTests::createFile(const std::string &content) {
+	createdFile = TempDir() + "bencoding-binary-cache";
+	std::ofstream file(createdFile, std::ios::out | std::ios::binary);
+	file << content;
+	return createdFile;
+}
+
+//
+// Items
+//
+
+TEST_F(BinaryCacheTests,
+IntegerCanBeRead) {
+	std::string image(bencodeToBinaryCache("i-9223372036854775808e"));
+
+	auto root = BinaryCache(image).root();
+
+	ASSERT_TRUE(root.isInteger());
+	EXPECT_EQ(CachedItem::Type::Integer, root.type());
+	EXPECT_EQ(INT64_MIN, root.integerValue());
+}
+
+TEST_F(BinaryCacheTests,
+StringCanBeRead) {
+	std::string image(bencodeToBinaryCache(std::string("5:a\0b:c", 7)));
+
+	auto root = BinaryCache(image).root();
+
+	ASSERT_TRUE(root.isString());
+	EXPECT_EQ(std::string("a\0b:c", 5), root.stringValue().str());
+}
+
+TEST_F(BinaryCacheTests,
+ItemsOfListCanBeRead) {
+	std::string image(bencodeToBinaryCache("li1e4:testlee"));
+
+	auto root = BinaryCache(image).root();
+
+	ASSERT_TRUE(root.isList());
+	ASSERT_EQ(3, root.size());
+	EXPECT_EQ(1, root[0].integerValue());
+	EXPECT_EQ("test", root[1].stringValue().str());
+	EXPECT_TRUE(root[2].isList());
+	EXPECT_TRUE(root[2].empty());
+}
+
+TEST_F(BinaryCacheTests,
+EntriesOfDictionaryCanBeRead) {
+	std::string image(bencodeToBinaryCache("d1:ai1e1:bd1:ci2eee"));
+
+	auto root = BinaryCache(image).root();
+
+	ASSERT_TRUE(root.isDictionary());
+	ASSERT_EQ(2, root.size());
+	EXPECT_EQ("a", root.keyAt(0).str());
+	EXPECT_EQ(1, root.valueAt(0).integerValue());
+	EXPECT_EQ("b", root.keyAt(1).str());
+	EXPECT_EQ(2, root.valueAt(1).find("c").integerValue());
+}
+
+TEST_F(BinaryCacheTests,
+FindReturnsValueOfExistingKey) {
+	std::string data("d");
+	for (char c = 'a'; c <= 'z'; ++c) {
+		data += std::string("1:") + c + "i" + std::to_string(c) + "e";
+	}
+	data += "e";
+	std::string image(bencodeToBinaryCache(data));
+
+	auto root = BinaryCache(image).root();
+
+	for (char c = 'a'; c <= 'z'; ++c) {
+		auto value = root.find(std::string(1, c));
+		ASSERT_TRUE(static_cast<bool>(value));
+		EXPECT_EQ(c, value.integerValue());
+	}
+}
+
+TEST_F(BinaryCacheTests,
+FindReturnsNullItemForNonExistingKey) {
+	std::string image(bencodeToBinaryCache("d1:ai1e1:ci2ee"));
+
+	auto root = BinaryCache(image).root();
+
+	EXPECT_FALSE(root.find("b"));
+	EXPECT_FALSE(root.find(""));
+	EXPECT_FALSE(root.find("d"));
+}
+
+TEST_F(BinaryCacheTests,
+FindReturnsNullItemWhenItemIsNotDictionary) {
+	std::string image(bencodeToBinaryCache("li1ee"));
+
+	EXPECT_FALSE(BinaryCache(image).root().find("a"));
+}
+
+TEST_F(BinaryCacheTests,
+NullItemHasNoValue) {
+	CachedItem item;
+
+	EXPECT_FALSE(item);
+	EXPECT_FALSE(item.isInteger());
+	EXPECT_FALSE(item.isString());
+	EXPECT_FALSE(item.isList());
+	EXPECT_FALSE(item.isDictionary());
+	EXPECT_EQ(0, item.size());
+}
+
+TEST_F(BinaryCacheTests,
+UnsortedKeysAreSortedInCache) {
+	std::string image(bencodeToBinaryCache("d1:bi2e1:ai1ee"));
+
+	auto root = BinaryCache(image).root();
+
+	EXPECT_EQ("a", root.keyAt(0).str());
+	EXPECT_EQ(2, root.find("b").integerValue());
+}
+
+TEST_F(BinaryCacheTests,
+DuplicateKeysAreRejected) {
+	EXPECT_THROW(bencodeToBinaryCache("d1:ai1e1:ai2ee"), DecodingError);
+}
+
+TEST_F(BinaryCacheTests,
+MalformedDataAreRejected) {
+	EXPECT_THROW(bencodeToBinaryCache("li1e"), DecodingError);
+	EXPECT_THROW(bencodeToBinaryCache("i1ei2e"), DecodingError);
+}
+
+//
+// Conversions
+//
+
+TEST_F(BinaryCacheTests,
+ConversionBackToBencodeReturnsOriginalData) {
+	std::string data("d8:announce15:http://tracker/4:infod5:filesld6:length"
+		"i10e4:pathl1:aeed6:lengthi-20e4:pathl1:b1:ceee4:name4:test"
+		"6:pieces3:\x01\x02\x03" "ee");
+
+	std::string image(bencodeToBinaryCache(data));
+
+	EXPECT_EQ(data, binaryCacheToBencode(BinaryCache(image).root()));
+}
+
+TEST_F(BinaryCacheTests,
+SubtreeCanBeConvertedToBencode) {
+	std::string image(bencodeToBinaryCache("d4:infod4:name4:testee"));
+
+	auto info = BinaryCache(image).root().find("info");
+
+	EXPECT_EQ("d4:name4:teste", binaryCacheToBencode(info));
+}
+
+TEST_F(BinaryCacheTests,
+DeeplyNestedCacheCanBeConvertedToBencode) {
+	std::string data(std::string(100000, 'l') + std::string(100000, 'e'));
+
+	std::string image(bencodeToBinaryCache(data));
+
+	EXPECT_EQ(data, binaryCacheToBencode(BinaryCache(image).root()));
+}
+
+TEST_F(BinaryCacheTests,
+CacheIsPositionIndependent) {
+	std::string image(bencodeToBinaryCache("d1:ali1e1:bee"));
+	std::string copy("xyz" + image);
+
+	auto root = BinaryCache(copy.data() + 3, image.size()).root();
+
+	EXPECT_EQ("b", root.find("a")[1].stringValue().str());
+}
+
+//
+// Corrupted caches
+//
+
+TEST_F(BinaryCacheTests,
+DataThatAreNotCacheAreRejected) {
+	std::string data("d1:ai1ee1234567");
+
+	EXPECT_THROW(BinaryCache cache(data), DecodingError);
+	EXPECT_THROW(BinaryCache cache(data.data(), 0), DecodingError);
+}
+
+TEST_F(BinaryCacheTests,
+TruncatedCacheIsRejected) {
+	std::string image(bencodeToBinaryCache("l4:testi1ee"));
+	std::string truncated(image.substr(0, image.size() - 1));
+
+	EXPECT_THROW(BinaryCache(truncated).root(), DecodingError);
+}
+
+TEST_F(BinaryCacheTests,
+OffsetOutsideOfCacheIsRejected) {
+	std::string image(bencodeToBinaryCache("li1ee"));
+	// The offset of the first item of the list (the last four bytes).
+	image[image.size() - 1] = '\x7f';
+
+	auto root = BinaryCache(image).root();
+
+	EXPECT_THROW(root[0], DecodingError);
+}
+
+TEST_F(BinaryCacheTests,
+OffsetOfContainerInItselfIsRejected) {
+	std::string image(bencodeToBinaryCache("li1ee"));
+	// Make the first item of the list point to the list itself.
+	std::string rootOffset(image.substr(8, 4));
+	image.replace(image.size() - 4, 4, rootOffset);
+
+	auto root = BinaryCache(image).root();
+
+	EXPECT_THROW(root[0], DecodingError);
+}
+
+TEST_F(BinaryCacheTests,
+IndexOutOfRangeIsRejected) {
+	std::string listImage(bencodeToBinaryCache("li1ee"));
+	std::string dictionaryImage(bencodeToBinaryCache("d1:ai1ee"));
+
+	auto list = BinaryCache(listImage).root();
+	auto dictionary = BinaryCache(dictionaryImage).root();
+
+	EXPECT_THROW(list[1], DecodingError);
+	EXPECT_THROW(dictionary.keyAt(1), DecodingError);
+	EXPECT_THROW(dictionary.valueAt(1), DecodingError);
+}
+
+TEST_F(BinaryCacheTests,
+ConversionOfCacheWithSharedItemsToBencodeIsRejected) {
+	// The integer is at offset 12 (right after the header). Every list
+	// contains the previous one twice, so the bencoded form of the last list
+	// would have 2^40 integers.
+	std::string image(bencodeToBinaryCache("i1e"));
+	auto toBytes = [](std::uint32_t value) {
+		std::string bytes;
+		for (std::size_t i = 0; i < 4; ++i) {
+			bytes += static_cast<char>(value >> (8 * i) & 0xff);
+		}
+		return bytes;
+	};
+	std::uint32_t previous = 12;
+	for (std::size_t i = 0; i < 40; ++i) {
+		std::uint32_t offset = static_cast<std::uint32_t>(image.size());
+		image += 'l' + toBytes(2) + toBytes(previous) + toBytes(previous);
+		previous = offset;
+	}
+	// Make the last list the root.
+	image.replace(8, 4, toBytes(previous));
+
+	EXPECT_THROW(binaryCacheToBencode(BinaryCache(image).root()),
+		DecodingError);
+}
+
+//
+// Mapped caches
+//
+
+TEST_F(BinaryCacheTests,
+MappedCacheCanBeQueried) {
+	std::string path(createFile(bencodeToBinaryCache("d4:infod4:name4:testee")));
+
+	MappedBinaryCache cache(path);
+
+	EXPECT_EQ("test",
+		cache.root().find("info").find("name").stringValue().str());
+}
+
+TEST_F(BinaryCacheTests,
+MappingNonExistingFileThrowsException) {
+	EXPECT_THROW(MappedBinaryCache(TempDir() + "bencoding-no-such-file"),
+		std::runtime_error);
+}
+
+TEST_F(BinaryCacheTests,
+MappingFileThatIsNotCacheThrowsException) {
+	std::string path(createFile("d1:ai1ee"));
+
+	EXPECT_THROW(MappedBinaryCache cache(path), DecodingError);
+}
+
+} // namespace tests
+} // namespace bencoding
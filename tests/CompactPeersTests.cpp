@@ -0,0 +1,144 @@
+/**
+* @file      CompactPeersTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for decoding and encoding of compact peers.
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "CompactPeers.h"
+#include "Decoder.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class CompactPeersTests: public Test {
+protected:
+	char buffer[128];
+};
+
+//
+// IPv4
+//
+
+TEST_F(CompactPeersTests,
+IPv4PeersAreDecodedInHostByteOrder) {
+	std::string peers("\x7f\x00\x00\x01\x1a\xe1\xc0\xa8\x01\xff\xff\xff", 12);
+	std::vector<IPv4Peer> result;
+
+	decodeCompactPeers(peers, result);
+
+	ASSERT_EQ(2, result.size());
+	EXPECT_EQ(0x7f000001u, result[0].address);
+	EXPECT_EQ(6881, result[0].port);
+	EXPECT_EQ(0xc0a801ffu, result[1].address);
+	EXPECT_EQ(65535, result[1].port);
+}
+
+TEST_F(CompactPeersTests,
+DecodingIPv4PeersReplacesPreviousContents) {
+	std::vector<IPv4Peer> result(5);
+
+	decodeCompactPeers(std::string(6, '\0'), result);
+
+	EXPECT_EQ(1, result.size());
+}
+
+TEST_F(CompactPeersTests,
+DecodingIPv4PeersThrowsDecodingErrorWhenSizeIsNotMultipleOfPeerSize) {
+	std::vector<IPv4Peer> result;
+
+	EXPECT_THROW(decodeCompactPeers(std::string(7, '\0'), result),
+		DecodingError);
+}
+
+TEST_F(CompactPeersTests,
+IPv4PeersAreWrittenAsCompactString) {
+	IPv4Peer peers[] = {{0x7f000001u, 6881}, {0xc0a801ffu, 65535}};
+	EncodedWriter writer(buffer);
+
+	writeCompactPeers(writer, peers, 2);
+
+	EXPECT_EQ(std::string("12:\x7f\x00\x00\x01\x1a\xe1\xc0\xa8\x01\xff\xff\xff",
+		15), writer.written().str());
+}
+
+TEST_F(CompactPeersTests,
+NoIPv4PeersAreWrittenAsEmptyString) {
+	EncodedWriter writer(buffer);
+
+	writeCompactPeers(writer, static_cast<const IPv4Peer *>(nullptr), 0);
+
+	EXPECT_EQ("0:", writer.written().str());
+}
+
+TEST_F(CompactPeersTests,
+WritingIPv4PeersReportsOverflowWhenBufferIsTooSmall) {
+	IPv4Peer peers[] = {{1, 2}, {3, 4}};
+	EncodedWriter writer(buffer, 10);
+
+	writeCompactPeers(writer, peers, 2);
+
+	EXPECT_TRUE(writer.overflowed());
+	EXPECT_EQ(0, writer.size());
+}
+
+//
+// IPv6
+//
+
+TEST_F(CompactPeersTests,
+IPv6PeersAreDecoded) {
+	std::string peers(16, '\0');
+	peers[15] = '\x01';
+	peers += std::string("\x1a\xe1", 2);
+	std::vector<IPv6Peer> result;
+
+	decodeCompactPeers(peers, result);
+
+	ASSERT_EQ(1, result.size());
+	EXPECT_EQ(0, result[0].address[0]);
+	EXPECT_EQ(1, result[0].address[15]);
+	EXPECT_EQ(6881, result[0].port);
+}
+
+TEST_F(CompactPeersTests,
+DecodingIPv6PeersThrowsDecodingErrorWhenSizeIsNotMultipleOfPeerSize) {
+	std::vector<IPv6Peer> result;
+
+	EXPECT_THROW(decodeCompactPeers(std::string(12, '\0'), result),
+		DecodingError);
+}
+
+TEST_F(CompactPeersTests,
+WrittenIPv6PeersAreDecodedBackIntoSamePeers) {
+	IPv6Peer peers[2] = {};
+	peers[0].address[0] = 0x20;
+	peers[0].address[15] = 0x01;
+	peers[0].port = 6881;
+	peers[1].address[7] = 0xff;
+	peers[1].port = 1;
+	EncodedWriter writer(buffer);
+	writeCompactPeers(writer, peers, 2);
+	std::vector<IPv6Peer> result;
+
+	decodeCompactPeers(StringRef(writer.written().data() + 3, 36), result);
+
+	EXPECT_EQ("36:", writer.written().str().substr(0, 3));
+	ASSERT_EQ(2, result.size());
+	EXPECT_EQ(0x20, result[0].address[0]);
+	EXPECT_EQ(0x01, result[0].address[15]);
+	EXPECT_EQ(6881, result[0].port);
+	EXPECT_EQ(0xff, result[1].address[7]);
+	EXPECT_EQ(1, result[1].port);
+}
+
+} // namespace tests
+} // namespace bencoding
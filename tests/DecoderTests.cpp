@@ -5,8 +5,11 @@
 * @brief     Tests for the Decoder class.
 */
 
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -143,6 +146,25 @@ DictionaryWithKeysThatAreNotSortedIsDecodedCorrectly) {
 	EXPECT_EQ(2, static_cast<int>(value2->value()));
 }
 
+TEST_F(DecoderTests,
+DictionaryWhoseKeysAreSortedOnlyPartiallyIsDecodedCorrectly) {
+	// Sorted keys are appended, the other ones are inserted in the usual way
+	// (including a duplicate of an already appended key).
+	std::string data("d1:ai1e1:ci3e1:bi2e1:ai4e1:di5ee");
+	std::shared_ptr<BItem> bItem(decoder->decode(data));
+
+	auto bDictionary = bItem->as<BDictionary>();
+	ASSERT_EQ(4, static_cast<int>(bDictionary->size()));
+	std::string keys;
+	std::vector<BInteger::ValueType> values;
+	for (const auto &item : *bDictionary) {
+		keys += *item.first->value();
+		values.push_back(item.second->as<BInteger>()->value());
+	}
+	EXPECT_EQ("abcd", keys);
+	EXPECT_EQ(std::vector<BInteger::ValueType>({4, 2, 3, 5}), values);
+}
+
 TEST_F(DecoderTests,
 DecodeThrowsDecodingErrorWhenDecodingDictionaryWithoutEndingE) {
 	EXPECT_THROW(decoder->decode("d"), DecodingError);
@@ -239,6 +261,25 @@ DecodeThrowsDecodingErrorWhenDecodingIntegerOfInvalidValue) {
 	EXPECT_THROW(decoder->decode("i1.1e"), DecodingError);
 }
 
+TEST_F(DecoderTests,
+LimitsOf64BitIntegersAreCorrectlyDecoded) {
+	auto maxItem = decoder->decode("i9223372036854775807e");
+	auto minItem = decoder->decode("i-9223372036854775808e");
+
+	EXPECT_EQ(std::numeric_limits<BInteger::ValueType>::max(),
+		maxItem->as<BInteger>()->value());
+	EXPECT_EQ(std::numeric_limits<BInteger::ValueType>::min(),
+		minItem->as<BInteger>()->value());
+}
+
+TEST_F(DecoderTests,
+DecodeThrowsDecodingErrorWhenDecodingIntegerThatDoesNotFitInto64Bits) {
+	EXPECT_THROW(decoder->decode("i9223372036854775808e"), DecodingError);
+	EXPECT_THROW(decoder->decode("i-9223372036854775809e"), DecodingError);
+	EXPECT_THROW(decoder->decode("i123456789012345678901234567890e"),
+		DecodingError);
+}
+
 //
 // List decoding.
 //
@@ -301,6 +342,50 @@ DecodeThrowsDecodingErrorWhenListItemIsInvalidIsMissingFromEndOfList) {
 	EXPECT_THROW(decoder->decode("l$e"), DecodingError);
 }
 
+TEST_F(DecoderTests,
+ListPackingIsEnabledByDefault) {
+	EXPECT_TRUE(decoder->isListPackingEnabled());
+}
+
+TEST_F(DecoderTests,
+ListOfIntegersIsDecodedIntoPackedForm) {
+	auto bList = decoder->decode("li1ei-2ei3ee")->as<BList>();
+
+	ASSERT_EQ(BList::Storage::PackedIntegers, bList->storage());
+	EXPECT_EQ(std::vector<BInteger::ValueType>({1, -2, 3}),
+		bList->packedIntegers());
+}
+
+TEST_F(DecoderTests,
+ListOfStringsIsDecodedIntoPackedForm) {
+	auto bList = decoder->decode("l1:a0:4:spame")->as<BList>();
+
+	ASSERT_EQ(BList::Storage::PackedStrings, bList->storage());
+	EXPECT_EQ(std::vector<std::string>({"a", "", "spam"}),
+		bList->packedStrings());
+}
+
+TEST_F(DecoderTests,
+ListOfMixedItemsIsDecodedIntoItems) {
+	auto bList = decoder->decode("li1ei2e1:ae")->as<BList>();
+
+	ASSERT_EQ(BList::Storage::Items, bList->storage());
+	ASSERT_EQ(3, bList->size());
+	EXPECT_EQ(1, bList->integerAt(0));
+	EXPECT_EQ(2, bList->integerAt(1));
+	EXPECT_EQ("a", bList->stringAt(2));
+}
+
+TEST_F(DecoderTests,
+ListsAreDecodedIntoItemsWhenListPackingIsDisabled) {
+	decoder->setListPacking(false);
+
+	auto bList = decoder->decode("li1ei2ee")->as<BList>();
+
+	EXPECT_EQ(BList::Storage::Items, bList->storage());
+	EXPECT_EQ(2, bList->size());
+}
+
 //
 // String decoding.
 //
@@ -348,6 +433,138 @@ DecodeThrowsDecodingErrorWhenStringHasNotEnoughCharacters) {
 	EXPECT_THROW(decoder->decode("3:aa"), DecodingError);
 }
 
+TEST_F(DecoderTests,
+DecodeThrowsDecodingErrorWhenStringLengthExceedsInputSize) {
+	EXPECT_THROW(decoder->decode("99999999999:x"), DecodingError);
+}
+
+TEST_F(DecoderTests,
+DecodeThrowsDecodingErrorWhenStringLengthDoesNotFitInto64Bits) {
+	EXPECT_THROW(decoder->decode("123456789012345678901234567890:x"),
+		DecodingError);
+}
+
+//
+// Strict mode.
+//
+
+TEST_F(DecoderTests,
+DecoderIsNotInStrictModeByDefault) {
+	EXPECT_FALSE(decoder->isInStrictMode());
+}
+
+TEST_F(DecoderTests,
+DecoderInStrictModeDecodesCanonicalData) {
+	decoder->setStrictMode(true);
+	std::shared_ptr<BItem> bItem(decoder->decode("d3:cowi0e4:spaml0:i-1eee"));
+
+	ADD_SCOPED_TRACE;
+	assertDecodedAs<BDictionary>(bItem);
+	EXPECT_EQ(2, static_cast<int>(bItem->as<BDictionary>()->size()));
+}
+
+TEST_F(DecoderTests,
+DecoderInStrictModeThrowsDecodingErrorForUnsortedKeys) {
+	decoder->setStrictMode(true);
+
+	EXPECT_THROW(decoder->decode("d4:spam4:eggs3:cow3:mooe"), DecodingError);
+}
+
+TEST_F(DecoderTests,
+DecoderInStrictModeThrowsDecodingErrorForDuplicateKeys) {
+	decoder->setStrictMode(true);
+
+	EXPECT_THROW(decoder->decode("d3:cowi1e3:cowi2ee"), DecodingError);
+}
+
+TEST_F(DecoderTests,
+DecoderInStrictModeThrowsDecodingErrorForNonCanonicalIntegers) {
+	decoder->setStrictMode(true);
+
+	EXPECT_THROW(decoder->decode("i-0e"), DecodingError);
+	EXPECT_THROW(decoder->decode("i+1e"), DecodingError);
+}
+
+TEST_F(DecoderTests,
+DecoderInStrictModeThrowsDecodingErrorForStringLengthWithLeadingZeros) {
+	decoder->setStrictMode(true);
+
+	EXPECT_THROW(decoder->decode("04:spam"), DecodingError);
+}
+
+TEST_F(DecoderTests,
+DuplicateKeysAreMergedWhenNotInStrictMode) {
+	std::shared_ptr<BItem> bItem(decoder->decode("d3:cowi1e3:cowi2ee"));
+
+	auto bDictionary = bItem->as<BDictionary>();
+	ASSERT_EQ(1, static_cast<int>(bDictionary->size()));
+	EXPECT_EQ(2, bDictionary->begin()->second->as<BInteger>()->value());
+}
+
+//
+// Memory limit.
+//
+
+TEST_F(DecoderTests,
+DecoderHasNoMemoryLimitByDefault) {
+	EXPECT_EQ(Decoder::NO_MEMORY_LIMIT, decoder->getMemoryLimit());
+}
+
+TEST_F(DecoderTests,
+DecodeSucceedsWhenDecodedDataFitIntoMemoryLimit) {
+	decoder->setMemoryLimit(1024);
+
+	auto bItem = decoder->decode("d3:cow3:moo4:spaml1:a1:bee");
+	EXPECT_EQ(2, bItem->as<BDictionary>()->size());
+}
+
+TEST_F(DecoderTests,
+DecodeThrowsDecodingErrorWhenStringExceedsMemoryLimit) {
+	decoder->setMemoryLimit(1024);
+
+	EXPECT_THROW(decoder->decode("2000:" + std::string(2000, 'x')),
+		DecodingError);
+}
+
+TEST_F(DecoderTests,
+DecodeThrowsDecodingErrorWhenManySmallItemsExceedMemoryLimit) {
+	std::string data("l");
+	for (int i = 0; i < 1000; ++i) {
+		data += "i0e";
+	}
+	data += "e";
+	decoder->setMemoryLimit(1024);
+
+	EXPECT_THROW(decoder->decode(data), DecodingError);
+}
+
+TEST_F(DecoderTests,
+MemoryLimitAppliesToEachDecodingSeparately) {
+	decoder->setMemoryLimit(1024);
+	std::string data("500:" + std::string(500, 'x'));
+
+	EXPECT_NO_THROW(decoder->decode(data));
+	EXPECT_NO_THROW(decoder->decode(data));
+}
+
+TEST_F(DecoderTests,
+DecodeFromStreamThrowsDecodingErrorWhenDeclaredStringLengthIsHuge) {
+	// The string is read in chunks, so the declared length is never allocated
+	// at once.
+	std::istringstream input("99999999999:x");
+
+	EXPECT_THROW(decoder->decode(input), DecodingError);
+}
+
+TEST_F(DecoderTests,
+DecodeFromStreamReadsStringsLongerThanSingleChunk) {
+	std::string str(Decoder::STREAM_CHUNK_SIZE * 2 + 13, 'x');
+	std::istringstream input(std::to_string(str.size()) + ":" + str);
+
+	auto bItem = decoder->decode(input);
+	EXPECT_EQ(str, *bItem->as<BString>()->value());
+}
+
 //
 // Other.
 //
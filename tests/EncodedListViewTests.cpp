@@ -0,0 +1,97 @@
+/**
+* @file      EncodedListViewTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the EncodedListView class.
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Decoder.h"
+#include "EncodedListView.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class EncodedListViewTests: public Test {};
+
+TEST_F(EncodedListViewTests,
+ViewOfEmptyListIsEmpty) {
+	std::string data("le");
+	EncodedListView view(data);
+
+	EXPECT_TRUE(view.empty());
+	EXPECT_EQ(0, view.size());
+}
+
+TEST_F(EncodedListViewTests,
+ViewReferencesEncodedFormsOfItems) {
+	std::string data("li1e4:spamd1:ai2eel1:bee");
+	EncodedListView view(data);
+
+	ASSERT_EQ(4, view.size());
+	EXPECT_EQ("i1e", view[0].str());
+	EXPECT_EQ("4:spam", view[1].str());
+	EXPECT_EQ("d1:ai2ee", view[2].str());
+	EXPECT_EQ("l1:be", view[3].str());
+	EXPECT_EQ(data.data() + 1, view[0].data());
+}
+
+TEST_F(EncodedListViewTests,
+IterationWorksCorrectlyOverView) {
+	std::string data("l1:a1:b1:ce");
+	EncodedListView view(data);
+
+	std::string concatenatedItems;
+	for (const auto &item : view) {
+		concatenatedItems += item.str();
+	}
+	EXPECT_EQ("1:a1:b1:c", concatenatedItems);
+}
+
+TEST_F(EncodedListViewTests,
+EncodedItemsReturnsSingleReferenceSpanningGivenItems) {
+	std::string data("li1ei2ei3ei4ee");
+	EncodedListView view(data);
+
+	EXPECT_EQ("i2ei3e", view.encodedItems(1, 3).str());
+	EXPECT_TRUE(view.encodedItems(2, 2).empty());
+}
+
+TEST_F(EncodedListViewTests,
+EncodeSliceReturnsListThatDecodesToGivenItems) {
+	std::string data("li1e1:ai2e1:be");
+	EncodedListView view(data);
+
+	EXPECT_EQ("l1:ai2ee", view.encodeSlice(1, 3));
+	EXPECT_EQ("le", view.encodeSlice(4, 4));
+	EXPECT_NO_THROW(decode(view.encodeSlice(0, 4)));
+}
+
+TEST_F(EncodedListViewTests,
+CreationThrowsDecodingErrorWhenDataAreNotList) {
+	std::string data("i1e");
+
+	EXPECT_THROW({ EncodedListView view(data); }, DecodingError);
+}
+
+TEST_F(EncodedListViewTests,
+CreationThrowsDecodingErrorWhenListIsNotTerminated) {
+	std::string data("li1e");
+
+	EXPECT_THROW({ EncodedListView view(data); }, DecodingError);
+}
+
+TEST_F(EncodedListViewTests,
+CreationThrowsDecodingErrorWhenDataContainTrailingCharacters) {
+	std::string data("lei1e");
+
+	EXPECT_THROW({ EncodedListView view(data); }, DecodingError);
+}
+
+} // namespace tests
+} // namespace bencoding
@@ -0,0 +1,122 @@
+/**
+* @file      EncodedWriterTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the EncodedWriter class.
+*/
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "EncodedWriter.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class EncodedWriterTests: public Test {
+protected:
+	char buffer[64];
+};
+
+TEST_F(EncodedWriterTests,
+WriterIsEmptyAfterConstruction) {
+	EncodedWriter writer(buffer);
+
+	EXPECT_EQ(0, writer.size());
+	EXPECT_EQ(sizeof(buffer), writer.capacity());
+	EXPECT_FALSE(writer.overflowed());
+	EXPECT_EQ("", writer.written().str());
+}
+
+TEST_F(EncodedWriterTests,
+WriteIntegerWritesEncodedInteger) {
+	EncodedWriter writer(buffer);
+
+	writer.writeInteger(0).writeInteger(-42).writeInteger(
+		std::numeric_limits<std::int64_t>::min());
+
+	EXPECT_EQ("i0ei-42ei-9223372036854775808e", writer.written().str());
+}
+
+TEST_F(EncodedWriterTests,
+WriteStringWritesEncodedString) {
+	EncodedWriter writer(buffer);
+
+	writer.writeString("").writeString("test").writeString(
+		std::string("a\0b", 3));
+
+	EXPECT_EQ(std::string("0:4:test3:a\0b", 13), writer.written().str());
+}
+
+TEST_F(EncodedWriterTests,
+WriteStringHeaderReservesSpaceForContentsOfString) {
+	EncodedWriter writer(buffer);
+
+	char *contents = writer.writeStringHeader(3);
+	ASSERT_TRUE(contents != nullptr);
+	contents[0] = 'a';
+	contents[1] = 'b';
+	contents[2] = 'c';
+
+	EXPECT_EQ("3:abc", writer.written().str());
+}
+
+TEST_F(EncodedWriterTests,
+WriteStringHeaderReturnsNullPointerWhenStringDoesNotFit) {
+	EncodedWriter writer(buffer, 4);
+
+	EXPECT_EQ(nullptr, writer.writeStringHeader(3));
+	EXPECT_TRUE(writer.overflowed());
+}
+
+TEST_F(EncodedWriterTests,
+FixedAndVariablePartsAreWrittenTogether) {
+	constexpr auto prefix = fixedString("d") + encodedString("interval") +
+		encodedInteger<1800>() + encodedString("peers");
+	EncodedWriter writer(buffer);
+
+	writer.write(prefix).writeString("abcdef").write(fixedString("e"));
+
+	EXPECT_EQ("d8:intervali1800e5:peers6:abcdefe", writer.written().str());
+	EXPECT_EQ(buffer, writer.written().data());
+}
+
+TEST_F(EncodedWriterTests,
+WriterStopsWritingWhenBufferIsFull) {
+	EncodedWriter writer(buffer, 8);
+
+	writer.writeString("abc").writeString("abc").writeInteger(1);
+
+	EXPECT_TRUE(writer.overflowed());
+	EXPECT_EQ("3:abc", writer.written().str());
+}
+
+TEST_F(EncodedWriterTests,
+DataFillingWholeBufferDoNotOverflow) {
+	EncodedWriter writer(buffer, 5);
+
+	writer.writeString("abc");
+
+	EXPECT_FALSE(writer.overflowed());
+	EXPECT_EQ(5, writer.size());
+}
+
+TEST_F(EncodedWriterTests,
+ClearDiscardsWrittenDataAndOverflow) {
+	EncodedWriter writer(buffer, 4);
+	writer.writeString("abcdef");
+
+	writer.clear();
+	writer.writeInteger(1);
+
+	EXPECT_FALSE(writer.overflowed());
+	EXPECT_EQ("i1e", writer.written().str());
+}
+
+} // namespace tests
+} // namespace bencoding
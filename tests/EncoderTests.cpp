@@ -10,6 +10,7 @@
 #include "BDictionary.h"
 #include "BInteger.h"
 #include "BList.h"
+#include "BListSlice.h"
 #include "BString.h"
 #include "Encoder.h"
 
@@ -117,6 +118,36 @@ NonemptyStringIsCorrectlyEncoded) {
 	EXPECT_EQ("4:test", encoder->encode(data));
 }
 
+TEST_F(EncoderTests,
+PackedListsAreCorrectlyEncodedAndStayPacked) {
+	auto integers = BList::createPackedIntegers({1, -2, 30});
+	auto strings = BList::createPackedStrings({"a", "", "spam"});
+
+	EXPECT_EQ("li1ei-2ei30ee", encode(integers));
+	EXPECT_EQ("l1:a0:4:spame", encode(strings));
+	EXPECT_EQ(BList::Storage::PackedIntegers, integers->storage());
+	EXPECT_EQ(BList::Storage::PackedStrings, strings->storage());
+}
+
+//
+// List slice encoding.
+//
+
+TEST_F(EncoderTests,
+ListSliceIsEncodedAsListOfItsItems) {
+	auto list = BList::create();
+	list->push_back(BInteger::create(1));
+	list->push_back(BString::create("a"));
+	list->push_back(BInteger::create(2));
+
+	EXPECT_EQ("l1:ai2ee", encoder->encode(list->slice(1)));
+}
+
+TEST_F(EncoderTests,
+EmptyListSliceIsEncodedAsEmptyList) {
+	EXPECT_EQ("le", encode(BListSlice()));
+}
+
 //
 // Other.
 //
@@ -0,0 +1,78 @@
+/**
+* @file      FixedStringTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the FixedString class and related functions.
+*/
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "FixedString.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class FixedStringTests: public Test {};
+
+TEST_F(FixedStringTests,
+FixedStringContainsBytesOfStringLiteral) {
+	constexpr auto str = fixedString("abc");
+
+	static_assert(str.size() == 3, "");
+	static_assert(str[1] == 'b', "");
+	EXPECT_EQ("abc", str.str());
+	EXPECT_EQ('\0', str.data()[3]);
+}
+
+TEST_F(FixedStringTests,
+FixedStringCanBeEmpty) {
+	constexpr auto str = fixedString("");
+
+	static_assert(str.size() == 0, "");
+	EXPECT_EQ("", str.str());
+}
+
+TEST_F(FixedStringTests,
+FixedStringsAreConcatenatedAtCompileTime) {
+	constexpr auto str = fixedString("ab") + fixedString("") + fixedString("c");
+
+	static_assert(str.size() == 3, "");
+	static_assert(str[2] == 'c', "");
+	EXPECT_EQ("abc", str.str());
+}
+
+TEST_F(FixedStringTests,
+EncodedStringReturnsCorrectEncoding) {
+	EXPECT_EQ("0:", encodedString("").str());
+	EXPECT_EQ("5:peers", encodedString("peers").str());
+	EXPECT_EQ("12:piece length", encodedString("piece length").str());
+}
+
+TEST_F(FixedStringTests,
+EncodedIntegerReturnsCorrectEncoding) {
+	EXPECT_EQ("i0e", encodedInteger<0>().str());
+	EXPECT_EQ("i1800e", encodedInteger<1800>().str());
+	EXPECT_EQ("i-42e", encodedInteger<-42>().str());
+	EXPECT_EQ("i9223372036854775807e",
+		encodedInteger<std::numeric_limits<std::int64_t>::max()>().str());
+	EXPECT_EQ("i-9223372036854775808e",
+		encodedInteger<std::numeric_limits<std::int64_t>::min()>().str());
+}
+
+TEST_F(FixedStringTests,
+MessageSkeletonIsBuiltAtCompileTime) {
+	constexpr auto prefix = fixedString("d") + encodedString("interval") +
+		encodedInteger<1800>() + encodedString("peers");
+
+	static_assert(prefix.size() == 24, "");
+	EXPECT_EQ("d8:intervali1800e5:peers", prefix.str());
+}
+
+} // namespace tests
+} // namespace bencoding
@@ -0,0 +1,185 @@
+/**
+* @file      FrozenTreeTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for concurrent reading of frozen trees and constant lists.
+*
+* Build with @c -DWITH_TSAN=ON to have the tests checked by ThreadSanitizer.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "BDictionary.h"
+#include "BInteger.h"
+#include "BList.h"
+#include "BString.h"
+#include "Decoder.h"
+#include "Encoder.h"
+#include "TestUtils.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class FrozenTreeTests: public Test {
+protected:
+	static std::size_t readTorrent(const std::shared_ptr<const BDictionary> &torrent,
+		std::size_t numOfFiles);
+	static void runReaders(const std::shared_ptr<const BDictionary> &torrent,
+		std::size_t numOfFiles);
+
+protected:
+	/// Number of the concurrently running readers.
+	static const std::size_t NUM_OF_READERS = 16;
+};
+
+const std::size_t FrozenTreeTests::NUM_OF_READERS;
+
+/**
+* @brief Reads all the files of the given torrent through the @c const
+*        interface and returns the number of the correctly read ones.
+*/
+std::size_t FrozenTreeTests::readTorrent(
+		const std::shared_ptr<const BDictionary> &torrent,
+		std::size_t numOfFiles) {
+	auto info = torrent->getValue<BDictionary>("info");
+	auto files = info->getValue<BList>("files");
+	auto lengths = info->getValue<BDictionary>("lengths");
+	std::size_t numOfCorrectFiles = 0;
+	for (std::size_t i = 0; i < numOfFiles; ++i) {
+		auto path = files->getItem<BList>(i);
+		auto length = lengths->getValue<BInteger>(std::to_string(100000 + i));
+		if (*path->getItem<BString>(1)->value() == "file" + std::to_string(i) &&
+				length && length->value() == static_cast<BInteger::ValueType>(i) &&
+				!lengths->hasKey("missing")) {
+			++numOfCorrectFiles;
+		}
+	}
+	return numOfCorrectFiles;
+}
+
+/**
+* @brief Reads the given torrent from NUM_OF_READERS threads at once and
+*        checks that all of them read it correctly.
+*/
+void FrozenTreeTests::runReaders(
+		const std::shared_ptr<const BDictionary> &torrent,
+		std::size_t numOfFiles) {
+	std::atomic<bool> start(false);
+	std::vector<std::size_t> results(NUM_OF_READERS);
+	std::vector<std::thread> readers;
+	for (std::size_t i = 0; i < NUM_OF_READERS; ++i) {
+		readers.emplace_back([&, i]() {
+			while (!start) {
+				std::this_thread::yield();
+			}
+			results[i] = readTorrent(torrent, numOfFiles);
+		});
+	}
+	start = true;
+	for (auto &reader : readers) {
+		reader.join();
+	}
+
+	for (std::size_t i = 0; i < NUM_OF_READERS; ++i) {
+		EXPECT_EQ(numOfFiles, results[i]) << "reader: " << i;
+	}
+}
+
+TEST_F(FrozenTreeTests,
+FreezingDecodedTreeConvertsPackedListsAndBuildsHashIndexes) {
+	const std::size_t numOfFiles = BDictionary::HASH_INDEX_THRESHOLD;
+	auto torrent = decode(createTorrent(numOfFiles))->as<BDictionary>();
+	auto info = torrent->getValue<BDictionary>("info");
+	auto path = info->getValue<BList>("files")->getItem<BList>(0);
+	ASSERT_EQ(BList::Storage::PackedStrings, path->storage());
+
+	torrent->freeze();
+
+	EXPECT_EQ(BList::Storage::Items, path->storage());
+	EXPECT_TRUE(info->getValue<BDictionary>("lengths")->isHashIndexed());
+}
+
+TEST_F(FrozenTreeTests,
+FrozenTreeCanBeReadFromMultipleThreadsAtOnce) {
+	const std::size_t numOfFiles = 2 * BDictionary::HASH_INDEX_THRESHOLD;
+	auto torrent = decode(createTorrent(numOfFiles))->as<BDictionary>();
+
+	torrent->freeze();
+
+	runReaders(torrent, numOfFiles);
+}
+
+TEST_F(FrozenTreeTests,
+CloneOfFrozenTreeCanBeModifiedWhileFrozenTreeIsRead) {
+	const std::size_t numOfFiles = BDictionary::HASH_INDEX_THRESHOLD;
+	auto torrent = decode(createTorrent(numOfFiles))->as<BDictionary>();
+	torrent->freeze();
+
+	std::thread writer([&]() {
+		auto copy = torrent->clone();
+		auto info = copy->unfrozenValue("info")->as<BDictionary>();
+		(*info)["name"] = BString::create("other");
+		info->unfrozenValue("files")->as<BList>()->pop_back();
+	});
+	runReaders(torrent, numOfFiles);
+	writer.join();
+
+	EXPECT_EQ("test",
+		*torrent->getValue<BDictionary>("info")->getValue<BString>("name")->value());
+}
+
+TEST_F(FrozenTreeTests,
+NonConstantAccessorsOfFrozenListThrowFrozenItemError) {
+	auto list = decode("li1ei2ee")->as<BList>();
+	list->freeze();
+
+	EXPECT_THROW((*list)[0], FrozenItemError);
+	EXPECT_THROW(list->front(), FrozenItemError);
+	EXPECT_THROW(list->back(), FrozenItemError);
+	EXPECT_THROW(list->begin(), FrozenItemError);
+	EXPECT_THROW(list->end(), FrozenItemError);
+	EXPECT_THROW(list->value(), FrozenItemError);
+	EXPECT_EQ("li1ei2ee", encode(list));
+}
+
+TEST_F(FrozenTreeTests,
+PackedListCanBeReadThroughConstantInterfaceFromMultipleThreadsAtOnce) {
+	std::vector<std::string> strings;
+	for (std::size_t i = 0; i < 1000; ++i) {
+		strings.push_back(std::to_string(i));
+	}
+	std::shared_ptr<const BList> list(BList::createPackedStrings(strings));
+
+	std::vector<std::size_t> results(NUM_OF_READERS);
+	std::vector<std::thread> readers;
+	for (std::size_t i = 0; i < NUM_OF_READERS; ++i) {
+		readers.emplace_back([&, i]() {
+			std::size_t index = 0;
+			for (const auto &item : *list) {
+				if (*item->as<BString>()->value() == list->stringAt(index++)) {
+					++results[i];
+				}
+			}
+		});
+	}
+	for (auto &reader : readers) {
+		reader.join();
+	}
+
+	for (std::size_t i = 0; i < NUM_OF_READERS; ++i) {
+		EXPECT_EQ(strings.size(), results[i]) << "reader: " << i;
+	}
+	EXPECT_EQ(BList::Storage::PackedStrings, list->storage());
+}
+
+} // namespace tests
+} // namespace bencoding
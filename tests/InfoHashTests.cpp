@@ -0,0 +1,92 @@
+/**
+* @file      InfoHashTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the computation of info hashes.
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Decoder.h"
+#include "InfoHash.h"
+#include "Sha.h"
+#include "TestUtils.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class InfoHashTests: public Test {
+protected:
+	InfoHashTests():
+		info("d6:lengthi6e4:name8:file.txte"),
+		torrent("d8:announce18:http://tracker.com4:info" + info +
+			"7:comment3:fooe") {}
+
+protected:
+	/// Encoded info dictionary of the torrent.
+	std::string info;
+
+	/// Encoded torrent.
+	std::string torrent;
+};
+
+TEST_F(InfoHashTests,
+FindInfoDictionaryReturnsReferenceToEncodedInfoDictionary) {
+	StringRef found = findInfoDictionary(torrent);
+
+	EXPECT_EQ(info, found.str());
+	EXPECT_EQ(torrent.data() + torrent.find(info), found.data());
+}
+
+TEST_F(InfoHashTests,
+InfoHashV1IsSha1OfEncodedInfoDictionary) {
+	EXPECT_EQ("6a64f5e2e3e01f06912135bc73c025162cb7a4d4",
+		toHex(infoHashV1(torrent)));
+}
+
+TEST_F(InfoHashTests,
+InfoHashV2IsSha256OfEncodedInfoDictionary) {
+	EXPECT_EQ("9105fd980a3912f7e98bc916c196461414303c5e8d76290d587c04d60209e703",
+		toHex(infoHashV2(torrent)));
+}
+
+TEST_F(InfoHashTests,
+InfoHashIsComputedFromInfoDictionaryContainingNestedItems) {
+	std::string nestedInfo("d5:filesld6:lengthi1e4:pathl1:aeee4:name1:xe");
+	std::string data("d4:info" + nestedInfo + "e");
+
+	EXPECT_EQ(sha1(nestedInfo), infoHashV1(data));
+}
+
+TEST_F(InfoHashTests,
+InfoHashThrowsDecodingErrorWhenThereIsNoInfoDictionary) {
+	EXPECT_THROW(infoHashV1("d8:announce3:fooe"), DecodingError);
+}
+
+TEST_F(InfoHashTests,
+InfoHashThrowsDecodingErrorWhenInfoIsNotDictionary) {
+	EXPECT_THROW(infoHashV1("d4:infoi1ee"), DecodingError);
+}
+
+TEST_F(InfoHashTests,
+InfoHashThrowsDecodingErrorWhenDataAreNotDictionary) {
+	EXPECT_THROW(infoHashV1("l4:infoe"), DecodingError);
+}
+
+TEST_F(InfoHashTests,
+InfoHashThrowsDecodingErrorWhenInfoDictionaryContainsMalformedInteger) {
+	EXPECT_THROW(infoHashV1("d4:infod6:lengthiGARBAGEe4:name1:xee"),
+		DecodingError);
+}
+
+TEST_F(InfoHashTests,
+InfoHashThrowsDecodingErrorWhenInfoDictionaryIsTruncated) {
+	EXPECT_THROW(infoHashV1("d4:infod4:name3:fo"), DecodingError);
+}
+
+} // namespace tests
+} // namespace bencoding
@@ -0,0 +1,384 @@
+/**
+* @file      JsonTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the transcoding between bencoded data and JSON.
+*/
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Decoder.h"
+#include "Json.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class JsonTests: public Test {};
+
+//
+// Bencode to JSON
+//
+
+TEST_F(JsonTests,
+IntegerIsTranscodedToNumber) {
+	EXPECT_EQ("-42", bencodeToJson("i-42e"));
+}
+
+TEST_F(JsonTests,
+StringIsTranscodedToString) {
+	EXPECT_EQ("\"test\"", bencodeToJson("4:test"));
+}
+
+TEST_F(JsonTests,
+EmptyListIsTranscodedToEmptyArray) {
+	EXPECT_EQ("[]", bencodeToJson("le"));
+}
+
+TEST_F(JsonTests,
+EmptyDictionaryIsTranscodedToEmptyObject) {
+	EXPECT_EQ("{}", bencodeToJson("de"));
+}
+
+TEST_F(JsonTests,
+ListIsTranscodedToArray) {
+	EXPECT_EQ("[1,\"a\",[],{}]", bencodeToJson("li1e1:aledee"));
+}
+
+TEST_F(JsonTests,
+DictionaryIsTranscodedToObject) {
+	EXPECT_EQ("{\"a\":1,\"b\":[2,3],\"c\":{\"d\":\"e\"}}",
+		bencodeToJson("d1:ai1e1:bli2ei3ee1:cd1:d1:eee"));
+}
+
+TEST_F(JsonTests,
+DeeplyNestedListsAreTranscoded) {
+	std::string data(10000, 'l');
+	data += std::string(10000, 'e');
+
+	std::string json(bencodeToJson(data));
+
+	EXPECT_EQ(std::string(10000, '[') + std::string(10000, ']'), json);
+}
+
+TEST_F(JsonTests,
+SpecialCharactersAreEscaped) {
+	std::string data("\"\\\n\t\r\b\f\x01\x1f\x7f");
+
+	EXPECT_EQ("\"\\\"\\\\\\n\\t\\r\\b\\f\\u0001\\u001f\x7f\"",
+		bencodeToJson(std::to_string(data.size()) + ":" + data));
+}
+
+TEST_F(JsonTests,
+EscapedCharactersInLongStringsAreEscaped) {
+	std::string data(std::string(20, 'a') + "\"" + std::string(20, 'b') +
+		"\n");
+
+	EXPECT_EQ("\"" + std::string(20, 'a') + "\\\"" + std::string(20, 'b') +
+		"\\n\"", bencodeToJson(std::to_string(data.size()) + ":" + data));
+}
+
+TEST_F(JsonTests,
+ValidUtf8IsWrittenAsIs) {
+	std::string data("\xc5\xa1\xe2\x82\xac\xf0\x9f\x98\x80 and more text");
+
+	EXPECT_EQ("\"" + data + "\"",
+		bencodeToJson(std::to_string(data.size()) + ":" + data));
+}
+
+TEST_F(JsonTests,
+InvalidUtf8IsWrittenInBase64ByDefault) {
+	EXPECT_EQ("[\"/w==\",\"//8=\",\"////\",\"/////w==\"]",
+		bencodeToJson("l1:\xff" "2:\xff\xff" "3:\xff\xff\xff"
+			"4:\xff\xff\xff\xff" "e"));
+}
+
+TEST_F(JsonTests,
+InvalidUtf8IsWrittenInHexWhenRequested) {
+	EXPECT_EQ("\"00ff10\"",
+		bencodeToJson(std::string("3:\x00\xff\x10", 5), JsonBinaryStrings::Hex));
+}
+
+TEST_F(JsonTests,
+InvalidUtf8IsRejectedWhenRequested) {
+	EXPECT_THROW(bencodeToJson("1:\xff", JsonBinaryStrings::Reject),
+		DecodingError);
+}
+
+TEST_F(JsonTests,
+InvalidUtf8InKeyIsEncoded) {
+	EXPECT_EQ("{\"ff\":1}",
+		bencodeToJson("d1:\xffi1ee", JsonBinaryStrings::Hex));
+}
+
+TEST_F(JsonTests,
+OverlongUtf8SequenceIsInvalid) {
+	EXPECT_EQ("\"c0af\"", bencodeToJson("2:\xc0\xaf", JsonBinaryStrings::Hex));
+}
+
+TEST_F(JsonTests,
+EncodedSurrogateIsInvalid) {
+	EXPECT_EQ("\"eda080\"",
+		bencodeToJson("3:\xed\xa0\x80", JsonBinaryStrings::Hex));
+}
+
+TEST_F(JsonTests,
+CodePointAfterLastOneIsInvalid) {
+	EXPECT_EQ("\"f4908080\"",
+		bencodeToJson("4:\xf4\x90\x80\x80", JsonBinaryStrings::Hex));
+}
+
+TEST_F(JsonTests,
+TruncatedUtf8SequenceIsInvalid) {
+	EXPECT_EQ("\"61e282\"",
+		bencodeToJson("3:a\xe2\x82", JsonBinaryStrings::Hex));
+}
+
+TEST_F(JsonTests,
+JsonIsWrittenIntoStream) {
+	std::ostringstream output;
+
+	bencodeToJson("d1:ai1e1:b1:ce", output);
+
+	EXPECT_EQ("{\"a\":1,\"b\":\"c\"}", output.str());
+}
+
+TEST_F(JsonTests,
+LongJsonIsWrittenIntoStreamWhole) {
+	std::string data("l");
+	std::string expectedJson("[");
+	for (int i = 0; i < 50000; ++i) {
+		data += "i" + std::to_string(i) + "e";
+		expectedJson += (i > 0 ? "," : "") + std::to_string(i);
+	}
+	data += "e";
+	expectedJson += "]";
+	std::ostringstream output;
+
+	bencodeToJson(data, output);
+
+	EXPECT_EQ(expectedJson, output.str());
+}
+
+TEST_F(JsonTests,
+MalformedDataAreRejected) {
+	EXPECT_THROW(bencodeToJson("li1e"), DecodingError);
+	EXPECT_THROW(bencodeToJson("d1:ae"), DecodingError);
+	EXPECT_THROW(bencodeToJson("di1ei2ee"), DecodingError);
+	EXPECT_THROW(bencodeToJson("5:abc"), DecodingError);
+	EXPECT_THROW(bencodeToJson(""), DecodingError);
+}
+
+TEST_F(JsonTests,
+TrailingDataAreRejected) {
+	EXPECT_THROW(bencodeToJson("i1ei2e"), DecodingError);
+}
+
+//
+// JSON to bencode
+//
+
+TEST_F(JsonTests,
+IntegerIsTranscodedToInteger) {
+	EXPECT_EQ("i-42e", jsonToBencode("-42"));
+}
+
+TEST_F(JsonTests,
+NegativeZeroIsTranscodedToZero) {
+	EXPECT_EQ("i0e", jsonToBencode("-0"));
+}
+
+TEST_F(JsonTests,
+ExtremeIntegersAreTranscoded) {
+	EXPECT_EQ("li9223372036854775807ei-9223372036854775808ee",
+		jsonToBencode("[9223372036854775807, -9223372036854775808]"));
+}
+
+TEST_F(JsonTests,
+TooLargeIntegerIsRejected) {
+	EXPECT_THROW(jsonToBencode("9223372036854775808"), DecodingError);
+}
+
+TEST_F(JsonTests,
+NonIntegralNumbersAreRejected) {
+	EXPECT_THROW(jsonToBencode("1.5"), DecodingError);
+	EXPECT_THROW(jsonToBencode("1e3"), DecodingError);
+}
+
+TEST_F(JsonTests,
+NumberWithLeadingZerosIsRejected) {
+	EXPECT_THROW(jsonToBencode("01"), DecodingError);
+}
+
+TEST_F(JsonTests,
+BooleansAreTranscodedToIntegers) {
+	EXPECT_EQ("li1ei0ee", jsonToBencode("[true,false]"));
+}
+
+TEST_F(JsonTests,
+NullIsRejected) {
+	EXPECT_THROW(jsonToBencode("null"), DecodingError);
+}
+
+TEST_F(JsonTests,
+JsonStringIsTranscodedToString) {
+	EXPECT_EQ("4:test", jsonToBencode("\"test\""));
+}
+
+TEST_F(JsonTests,
+EscapeSequencesInStringAreReplaced) {
+	EXPECT_EQ("10:\"\\/\b\f\n\r\tA\x01",
+		jsonToBencode("\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u0041\\u0001\""));
+}
+
+TEST_F(JsonTests,
+UnicodeEscapeSequencesAreEncodedInUtf8) {
+	EXPECT_EQ("9:\xc5\xa1\xf0\x9f\x98\x80\xe2\x82\xac",
+		jsonToBencode("\"\\u0161\\ud83d\\ude00\\u20AC\""));
+}
+
+TEST_F(JsonTests,
+LoneSurrogateIsRejected) {
+	EXPECT_THROW(jsonToBencode("\"\\ud83d\""), DecodingError);
+	EXPECT_THROW(jsonToBencode("\"\\ude00\""), DecodingError);
+}
+
+TEST_F(JsonTests,
+UnescapedControlCharacterIsRejected) {
+	EXPECT_THROW(jsonToBencode("\"a\nb\""), DecodingError);
+}
+
+TEST_F(JsonTests,
+ArrayIsTranscodedToList) {
+	EXPECT_EQ("li1e1:aledee", jsonToBencode(" [ 1 , \"a\" , [ ] , { } ] "));
+}
+
+TEST_F(JsonTests,
+ObjectWithSortedKeysIsTranscodedToDictionary) {
+	EXPECT_EQ("d1:ai1e1:bli2ei3ee1:cd1:d1:eee",
+		jsonToBencode("{\"a\": 1, \"b\": [2, 3], \"c\": {\"d\": \"e\"}}"));
+}
+
+TEST_F(JsonTests,
+KeysOfObjectAreSorted) {
+	EXPECT_EQ("d1:ai1e2:bbd1:xi1e1:yi2ee1:cli3eee",
+		jsonToBencode("{\"c\": [3], \"bb\": {\"y\": 2, \"x\": 1}, \"a\": 1}"));
+}
+
+TEST_F(JsonTests,
+KeysAreSortedAsRawBytes) {
+	EXPECT_EQ("d1:Bi1e1:ai2e2:\xc3\xa1i3ee",
+		jsonToBencode("{\"\\u00e1\": 3, \"a\": 2, \"B\": 1}"));
+}
+
+TEST_F(JsonTests,
+KeysContainingColonsAreSorted) {
+	EXPECT_EQ("d2:a:i1e2:b:i2ee", jsonToBencode("{\"b:\": 2, \"a:\": 1}"));
+}
+
+TEST_F(JsonTests,
+DuplicateKeysAreRejected) {
+	EXPECT_THROW(jsonToBencode("{\"a\": 1, \"a\": 2}"), DecodingError);
+	EXPECT_THROW(jsonToBencode("{\"b\": 1, \"a\": 2, \"b\": 3}"),
+		DecodingError);
+}
+
+TEST_F(JsonTests,
+TooLargeObjectIsRejected) {
+	EXPECT_THROW(jsonToBencode("{\"a\": \"0123456789\", \"b\": 1}", 10),
+		DecodingError);
+}
+
+TEST_F(JsonTests,
+ObjectWithTooLargeLastValueIsRejected) {
+	std::string json("{\"a\": \"" + std::string(1000, 'x') + "\"}");
+
+	EXPECT_THROW(jsonToBencode(json, 100), DecodingError);
+}
+
+TEST_F(JsonTests,
+ObjectWithTooLargeArrayOfSmallObjectsIsRejected) {
+	std::string json("{\"a\": [");
+	for (std::size_t i = 0; i < 1000; ++i) {
+		json += i == 0 ? "{\"k\": 1}" : ", {\"k\": 1}";
+	}
+	json += "]}";
+
+	EXPECT_THROW(jsonToBencode(json, 100), DecodingError);
+}
+
+TEST_F(JsonTests,
+SizeOfObjectsIsNotLimitedOutsideOfThem) {
+	std::string json("[\"" + std::string(1000, 'x') + "\", {\"a\": 1}]");
+
+	EXPECT_NO_THROW(jsonToBencode(json, 100));
+}
+
+TEST_F(JsonTests,
+DeeplyNestedArraysAreTranscoded) {
+	std::string json(std::string(10000, '[') + std::string(10000, ']'));
+
+	EXPECT_EQ(std::string(10000, 'l') + std::string(10000, 'e'),
+		jsonToBencode(json));
+}
+
+TEST_F(JsonTests,
+BencodeIsWrittenIntoStream) {
+	std::ostringstream output;
+
+	jsonToBencode("{\"b\": 2, \"a\": 1}", output);
+
+	EXPECT_EQ("d1:ai1e1:bi2ee", output.str());
+}
+
+TEST_F(JsonTests,
+LongBencodeWithUnsortedObjectsIsWrittenIntoStreamWhole) {
+	std::string json("[");
+	std::string expectedData("l");
+	for (int i = 0; i < 20000; ++i) {
+		json += std::string(i > 0 ? "," : "") + "{\"y\": " +
+			std::to_string(i) + ", \"x\": [" + std::to_string(i) + "]}";
+		expectedData += "d1:xli" + std::to_string(i) + "ee1:yi" +
+			std::to_string(i) + "ee";
+	}
+	json += "]";
+	expectedData += "e";
+	std::ostringstream output;
+
+	jsonToBencode(json, output);
+
+	EXPECT_EQ(expectedData, output.str());
+}
+
+TEST_F(JsonTests,
+MalformedJsonIsRejected) {
+	EXPECT_THROW(jsonToBencode(""), DecodingError);
+	EXPECT_THROW(jsonToBencode("[1,]"), DecodingError);
+	EXPECT_THROW(jsonToBencode("[1 2]"), DecodingError);
+	EXPECT_THROW(jsonToBencode("{\"a\" 1}"), DecodingError);
+	EXPECT_THROW(jsonToBencode("{1: 1}"), DecodingError);
+	EXPECT_THROW(jsonToBencode("[1}"), DecodingError);
+	EXPECT_THROW(jsonToBencode("\"abc"), DecodingError);
+	EXPECT_THROW(jsonToBencode("tru"), DecodingError);
+	EXPECT_THROW(jsonToBencode("\"\\x\""), DecodingError);
+}
+
+TEST_F(JsonTests,
+TrailingDataAfterJsonAreRejected) {
+	EXPECT_THROW(jsonToBencode("1 2"), DecodingError);
+}
+
+TEST_F(JsonTests,
+TranscodingToJsonAndBackPreservesCanonicalData) {
+	std::string data("d4:infod6:lengthi12345e4:name8:file.txte"
+		"4:listli-1e0:1:\"ee");
+
+	EXPECT_EQ(data, jsonToBencode(bencodeToJson(data)));
+}
+
+} // namespace tests
+} // namespace bencoding
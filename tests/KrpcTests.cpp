@@ -0,0 +1,248 @@
+/**
+* @file      KrpcTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the codec of KRPC messages.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Decoder.h"
+#include "Krpc.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class KrpcTests: public Test {
+protected:
+	static void decodeFrom(const std::string &data);
+	std::string encode(const KrpcMessage &message);
+
+protected:
+	char buffer[KrpcMessage::MAX_SIZE];
+};
+
+/**
+* @brief Decodes a message from @a data and discards it.
+*/
+void KrpcTests::decodeFrom(const std::string &data) {
+	decodeKrpcMessage(data);
+}
+
+/**
+* @brief Encodes @a message into the buffer and returns the encoded data.
+*/
+std::string KrpcTests::encode(const KrpcMessage &message) {
+	EncodedWriter writer(buffer);
+	encodeKrpcMessage(message, writer);
+	EXPECT_FALSE(writer.overflowed());
+	return writer.written().str();
+}
+
+//
+// Decoding
+//
+
+TEST_F(KrpcTests,
+QueryIsDecoded) {
+	std::string data("d1:ad2:id20:abcdefghij01234567894:wantl2:n4e"
+		"12:implied_porti1ee1:q9:get_peers1:t2:aa1:v4:LT011:y1:qe");
+
+	auto message = decodeKrpcMessage(data);
+
+	EXPECT_EQ(KrpcMessage::Type::Query, message.type);
+	EXPECT_EQ("get_peers", message.method.str());
+	EXPECT_EQ("aa", message.transactionId.str());
+	EXPECT_EQ("LT01", message.version.str());
+	ASSERT_EQ(3, message.numOfArguments());
+	StringRef id;
+	ASSERT_TRUE(message.getString("id", id));
+	EXPECT_EQ("abcdefghij0123456789", id.str());
+	EXPECT_EQ(data.data() + 12, id.data());
+	std::int64_t impliedPort = 0;
+	ASSERT_TRUE(message.getInteger("implied_port", impliedPort));
+	EXPECT_EQ(1, impliedPort);
+	const KrpcValue *want = message.find("want");
+	ASSERT_TRUE(want != nullptr);
+	EXPECT_EQ(KrpcValue::Kind::Encoded, want->kind());
+	EXPECT_EQ("l2:n4e", want->str().str());
+}
+
+TEST_F(KrpcTests,
+ResponseIsDecoded) {
+	std::string data("d1:rd2:id20:mnopqrstuvwxyz123456e1:t2:aa1:y1:re");
+	auto message = decodeKrpcMessage(data);
+
+	EXPECT_EQ(KrpcMessage::Type::Response, message.type);
+	StringRef id;
+	EXPECT_TRUE(message.getString("id", id));
+	EXPECT_EQ("mnopqrstuvwxyz123456", id.str());
+}
+
+TEST_F(KrpcTests,
+ErrorIsDecoded) {
+	std::string data("d1:eli201e23:A Generic Error Ocurrede1:t2:aa1:y1:ee");
+	auto message = decodeKrpcMessage(data);
+
+	EXPECT_EQ(KrpcMessage::Type::Error, message.type);
+	EXPECT_EQ(201, message.errorCode);
+	EXPECT_EQ("A Generic Error Ocurred", message.errorMessage.str());
+}
+
+TEST_F(KrpcTests,
+UnknownKeysAreIgnored) {
+	std::string data("d2:ip6:abcdef1:rd2:id1:xe1:t2:aa1:y1:re");
+	auto message = decodeKrpcMessage(data);
+
+	EXPECT_EQ(1, message.numOfArguments());
+}
+
+TEST_F(KrpcTests,
+GettersReturnFalseWhenArgumentIsMissingOrHasDifferentType) {
+	std::string data("d1:rd2:id1:x4:porti1ee1:t2:aa1:y1:re");
+	auto message = decodeKrpcMessage(data);
+	StringRef str("unchanged");
+	std::int64_t value = 42;
+
+	EXPECT_FALSE(message.getString("port", str));
+	EXPECT_FALSE(message.getString("token", str));
+	EXPECT_FALSE(message.getInteger("id", value));
+	EXPECT_EQ("unchanged", str.str());
+	EXPECT_EQ(42, value);
+}
+
+TEST_F(KrpcTests,
+DecodingThrowsDecodingErrorWhenRequiredKeyIsMissing) {
+	EXPECT_THROW(decodeFrom("d1:rde1:y1:re"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom("d1:rde1:t2:aae"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom("d1:ade1:t2:aa1:y1:qe"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom("d1:q4:ping1:t2:aa1:y1:qe"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom("d1:t2:aa1:y1:ee"),
+		DecodingError);
+}
+
+TEST_F(KrpcTests,
+DecodingThrowsDecodingErrorWhenTypeIsInvalid) {
+	EXPECT_THROW(decodeFrom("d1:rde1:t2:aa1:y1:xe"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom("d1:rde1:t2:aa1:y2:rre"),
+		DecodingError);
+}
+
+TEST_F(KrpcTests,
+DecodingThrowsDecodingErrorWhenMessageIsMalformed) {
+	EXPECT_THROW(decodeFrom("d1:rde1:t2:aa1:y1:r"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom("d1:rde1:t2:aa1:y1:ree"),
+		DecodingError);
+	EXPECT_THROW(decodeFrom(("d1:rd2:idi1e2:idi2ee"
+		"1:t2:aa1:y1:re")), DecodingError);
+	EXPECT_THROW(decodeFrom(("d1:eli201e1:xi1ee"
+		"1:t2:aa1:y1:ee")), DecodingError);
+}
+
+TEST_F(KrpcTests,
+DecodingThrowsDecodingErrorWhenThereAreTooManyArguments) {
+	std::string data("d1:rd");
+	for (std::size_t i = 0; i <= KrpcMessage::MAX_ARGUMENTS; ++i) {
+		data += "2:" + std::to_string(i + 10) + "i0e";
+	}
+	data += "e1:t2:aa1:y1:re";
+
+	EXPECT_THROW(decodeKrpcMessage(data), DecodingError);
+}
+
+TEST_F(KrpcTests,
+DecodingThrowsDecodingErrorWhenMessageIsTooLarge) {
+	std::string data("d1:rd1:x" + std::to_string(KrpcMessage::MAX_SIZE) + ":" +
+		std::string(KrpcMessage::MAX_SIZE, 'x') + "e1:t2:aa1:y1:re");
+
+	EXPECT_THROW(decodeKrpcMessage(data), DecodingError);
+}
+
+//
+// Encoding
+//
+
+TEST_F(KrpcTests,
+QueryIsEncodedWithSortedKeys) {
+	KrpcMessage message;
+	message.type = KrpcMessage::Type::Query;
+	message.transactionId = "aa";
+	message.method = "announce_peer";
+	message.addArgument("token", KrpcValue::string("tok"));
+	message.addArgument("port", KrpcValue::integer(6881));
+	message.addArgument("id", KrpcValue::string("abc"));
+	message.addArgument("want", KrpcValue::encoded("l2:n4e"));
+
+	EXPECT_EQ("d1:ad2:id3:abc4:porti6881e5:token3:tok4:wantl2:n4ee"
+		"1:q13:announce_peer1:t2:aa1:y1:qe", encode(message));
+}
+
+TEST_F(KrpcTests,
+ResponseIsEncodedWithVersion) {
+	KrpcMessage message;
+	message.type = KrpcMessage::Type::Response;
+	message.transactionId = "aa";
+	message.version = "LT01";
+	message.addArgument("id", KrpcValue::string("abc"));
+
+	EXPECT_EQ("d1:rd2:id3:abce1:t2:aa1:v4:LT011:y1:re", encode(message));
+}
+
+TEST_F(KrpcTests,
+ErrorIsEncoded) {
+	KrpcMessage message;
+	message.type = KrpcMessage::Type::Error;
+	message.transactionId = "aa";
+	message.errorCode = 201;
+	message.errorMessage = "Error";
+
+	EXPECT_EQ("d1:eli201e5:Errore1:t2:aa1:y1:ee", encode(message));
+}
+
+TEST_F(KrpcTests,
+DecodedMessageIsEncodedBackIntoSameData) {
+	std::string data("d1:ad2:id20:abcdefghij01234567896:target"
+		"20:mnopqrstuvwxyz123456e1:q9:find_node1:t2:aa1:y1:qe");
+
+	EXPECT_EQ(data, encode(decodeKrpcMessage(data)));
+}
+
+TEST_F(KrpcTests,
+EncodingReportsOverflowWhenBufferIsTooSmall) {
+	KrpcMessage message;
+	message.type = KrpcMessage::Type::Response;
+	message.transactionId = "aa";
+	message.addArgument("id", KrpcValue::string("abc"));
+	EncodedWriter writer(buffer, 10);
+
+	encodeKrpcMessage(message, writer);
+
+	EXPECT_TRUE(writer.overflowed());
+}
+
+TEST_F(KrpcTests,
+AddArgumentThrowsLengthErrorWhenThereAreTooManyArguments) {
+	KrpcMessage message;
+	for (std::size_t i = 0; i < KrpcMessage::MAX_ARGUMENTS; ++i) {
+		message.addArgument("x", KrpcValue::integer(0));
+	}
+
+	EXPECT_THROW(message.addArgument("x", KrpcValue::integer(0)),
+		std::length_error);
+}
+
+} // namespace tests
+} // namespace bencoding
@@ -0,0 +1,219 @@
+/**
+* @file      PiecesTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the access to piece hashes and for piece verification.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "BString.h"
+#include "Decoder.h"
+#include "Pieces.h"
+#include "Sha.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class PiecesTests: public Test {
+protected:
+	virtual void TearDown() override;
+
+	PayloadFile createFile(const std::string &name, const std::string &content);
+
+protected:
+	/// Paths to the files created by the test.
+	std::vector<std::string> createdFiles;
+};
+
+void PiecesTests::TearDown() {
+	for (const auto &path : createdFiles) {
+		std::remove(path.c_str());
+	}
+}
+
+/**
+* @brief Creates a temporary file with the given @a content and returns it as
+*        a payload file.
+*/
+PayloadFile PiecesTests::createFile(const std::string &name,
+		const std::string &content) {
+	std::string path(TempDir() + "bencoding-pieces-" + name);
+	std::ofstream file(path, std::ios::out | std::ios::binary);
+	file << content;
+	createdFiles.push_back(path);
+	return PayloadFile{path, content.size()};
+}
+
+//
+// PieceHashes
+//
+
+TEST_F(PiecesTests,
+PieceHashesProvidesAccessToSingleHashes) {
+	std::string hashes(std::string(20, 'a') + std::string(20, 'b'));
+
+	PieceHashes pieceHashes(hashes);
+
+	EXPECT_EQ(2, pieceHashes.size());
+	EXPECT_FALSE(pieceHashes.empty());
+	EXPECT_EQ(PieceHashes::V1_HASH_SIZE, pieceHashes.hashSize());
+	EXPECT_EQ(std::string(20, 'b'), pieceHashes[1].str());
+	EXPECT_EQ(hashes.data() + 20, pieceHashes[1].data());
+	EXPECT_EQ(hashes.data(), pieceHashes.data());
+}
+
+TEST_F(PiecesTests,
+PieceHashesCanHaveV2Hashes) {
+	std::string hashes(64, 'x');
+
+	PieceHashes pieceHashes(hashes, PieceHashes::V2_HASH_SIZE);
+
+	EXPECT_EQ(2, pieceHashes.size());
+	EXPECT_EQ(32, pieceHashes[0].size());
+}
+
+TEST_F(PiecesTests,
+PieceHashesCanBeCreatedFromBString) {
+	auto hashes = BString::create(std::string(40, 'a'));
+
+	PieceHashes pieceHashes(*hashes);
+
+	EXPECT_EQ(2, pieceHashes.size());
+	EXPECT_EQ(hashes->value()->data(), pieceHashes.data());
+}
+
+TEST_F(PiecesTests,
+PieceHashesIsEmptyWhenThereAreNoHashes) {
+	PieceHashes pieceHashes(StringRef(""));
+
+	EXPECT_TRUE(pieceHashes.empty());
+	EXPECT_EQ(0, pieceHashes.size());
+}
+
+TEST_F(PiecesTests,
+PieceHashesThrowsDecodingErrorWhenSizeIsNotMultipleOfHashSize) {
+	std::string hashes(21, 'a');
+
+	EXPECT_THROW(PieceHashes pieceHashes(hashes), DecodingError);
+}
+
+TEST_F(PiecesTests,
+MatchesReturnsTrueOnlyForEqualDigest) {
+	std::string hashes(sha1("abc"));
+	PieceHashes pieceHashes(hashes);
+
+	EXPECT_TRUE(pieceHashes.matches(0, sha1("abc")));
+	EXPECT_FALSE(pieceHashes.matches(0, sha1("abd")));
+}
+
+//
+// Verification
+//
+
+TEST_F(PiecesTests,
+VerifyPiecesReturnsValidityOfPiecesSpanningMultipleFiles) {
+	std::vector<PayloadFile> files{
+		createFile("1", "abcde"),
+		createFile("2", ""),
+		createFile("3", "fghij")
+	};
+	std::string hashes(sha1("abcd") + sha1("XXXX") + sha1("ij"));
+
+	auto result = verifyPieces(files, 4, PieceHashes(hashes), 2);
+
+	EXPECT_EQ(std::vector<bool>({true, false, true}), result);
+}
+
+TEST_F(PiecesTests,
+VerifyPiecesMarksPiecesOfMissingOrShortFilesAsInvalid) {
+	std::vector<PayloadFile> files{
+		createFile("1", "abcd"),
+		PayloadFile{TempDir() + "bencoding-pieces-nonexistent", 4},
+		createFile("3", "ab")
+	};
+	files[2].length = 4;
+	std::string hashes(sha1("abcd") + sha1("efgh") + sha1("abcd"));
+
+	auto result = verifyPieces(files, 4, PieceHashes(hashes));
+
+	EXPECT_EQ(std::vector<bool>({true, false, false}), result);
+}
+
+TEST_F(PiecesTests,
+VerifyPiecesGivesSameResultsForAnyNumberOfThreads) {
+	std::string content;
+	std::string hashes;
+	for (int i = 0; i < 50; ++i) {
+		std::string piece(16, static_cast<char>('a' + i % 26));
+		content += piece;
+		hashes += i % 7 == 0 ? sha1("invalid") : sha1(piece);
+	}
+	std::vector<PayloadFile> files{createFile("1", content)};
+
+	auto expected = verifyPieces(files, 16, PieceHashes(hashes), 1);
+	for (unsigned numOfThreads = 2; numOfThreads <= 8; ++numOfThreads) {
+		EXPECT_EQ(expected, verifyPieces(files, 16, PieceHashes(hashes),
+			numOfThreads));
+	}
+	EXPECT_FALSE(expected[0]);
+	EXPECT_TRUE(expected[1]);
+}
+
+TEST_F(PiecesTests,
+VerifyPiecesVerifiesPiecesLongerThanBuffer) {
+	std::string content(3 * 1024 * 1024 + 5, 'a');
+	std::vector<PayloadFile> files{createFile("1", content)};
+	std::string hashes(sha1(content.substr(0, 2 * 1024 * 1024 + 1)) +
+		sha1(content.substr(2 * 1024 * 1024 + 1)));
+
+	auto result = verifyPieces(files, 2 * 1024 * 1024 + 1,
+		PieceHashes(hashes), 2);
+
+	EXPECT_EQ(std::vector<bool>({true, true}), result);
+}
+
+TEST_F(PiecesTests,
+VerifyPiecesDoesNotAllocatePieceLengthForHugePieceLengthAndSmallPayload) {
+	std::vector<PayloadFile> files{createFile("1", "abcd")};
+	std::string hashes(sha1("abcd"));
+
+	auto result = verifyPieces(files, std::uint64_t(1) << 40,
+		PieceHashes(hashes));
+
+	EXPECT_EQ(std::vector<bool>({true}), result);
+}
+
+TEST_F(PiecesTests,
+VerifyPiecesThrowsInvalidArgumentWhenNumberOfHashesDoesNotMatch) {
+	std::vector<PayloadFile> files{createFile("1", "abcde")};
+	std::string hashes(sha1("abcd"));
+
+	EXPECT_THROW(verifyPieces(files, 4, PieceHashes(hashes)),
+		std::invalid_argument);
+}
+
+TEST_F(PiecesTests,
+VerifyPiecesThrowsInvalidArgumentForV2HashesOrZeroPieceLength) {
+	std::vector<PayloadFile> files{createFile("1", "abcd")};
+	std::string v2Hashes(sha256("abcd"));
+	std::string v1Hashes(sha1("abcd"));
+
+	EXPECT_THROW(verifyPieces(files, 4,
+		PieceHashes(v2Hashes, PieceHashes::V2_HASH_SIZE)),
+		std::invalid_argument);
+	EXPECT_THROW(verifyPieces(files, 0, PieceHashes(v1Hashes)),
+		std::invalid_argument);
+}
+
+} // namespace tests
+} // namespace bencoding
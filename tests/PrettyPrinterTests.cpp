@@ -5,6 +5,9 @@
 * @brief     Tests for the PrettyPrinter class.
 */
 
+#include <sstream>
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include "BDictionary.h"
@@ -102,6 +105,18 @@ PrettyReprOfListWithTwoStringsIsCorrect) {
 		printer->getPrettyRepr(bList));
 }
 
+TEST_F(PrettyPrinterTests,
+PrettyReprOfPackedListsIsCorrectAndKeepsListsPacked) {
+	auto integers = BList::createPackedIntegers({1, -2});
+	auto strings = BList::createPackedStrings({"te\"st", "hello"});
+
+	EXPECT_EQ("[\n    1,\n    -2\n]", printer->getPrettyRepr(integers));
+	EXPECT_EQ("[\n    \"te\\\"st\",\n    \"hello\"\n]",
+		printer->getPrettyRepr(strings));
+	EXPECT_EQ(BList::Storage::PackedIntegers, integers->storage());
+	EXPECT_EQ(BList::Storage::PackedStrings, strings->storage());
+}
+
 //
 // String representation.
 //
@@ -127,6 +142,76 @@ QuoteInsideStringIsPrefixedWithBackslash) {
 	EXPECT_EQ(R"("te\"st")", printer->getPrettyRepr(data));
 }
 
+TEST_F(PrettyPrinterTests,
+BackslashAndControlCharactersInsideStringAreEscaped) {
+	std::shared_ptr<BItem> data(BString::create(
+		std::string("a\\b\nc\td\re\x01" "f\x7f") + '\0'));
+
+	EXPECT_EQ(R"("a\\b\nc\td\re\x01f\x7f\x00")", printer->getPrettyRepr(data));
+}
+
+TEST_F(PrettyPrinterTests,
+CharactersToEscapeAreFoundInLongStrings) {
+	// Characters to be escaped at different positions in 16-byte chunks.
+	std::string str(100, 'x');
+	str[15] = '"';
+	str[16] = '\\';
+	str[50] = '\x1f';
+	str[99] = '"';
+	std::shared_ptr<BItem> data(BString::create(str));
+
+	EXPECT_EQ('"' + std::string(15, 'x') + R"(\"\\)" + std::string(33, 'x') +
+		R"(\x1f)" + std::string(48, 'x') + R"(\"")",
+		printer->getPrettyRepr(data));
+}
+
+TEST_F(PrettyPrinterTests,
+NonAsciiCharactersInsideStringAreNotEscaped) {
+	std::shared_ptr<BItem> data(BString::create("\xc5\xbelu\xc5\xa5ou\xc4\x8dk\xc3\xbd"));
+
+	EXPECT_EQ("\"\xc5\xbelu\xc5\xa5ou\xc4\x8dk\xc3\xbd\"", printer->getPrettyRepr(data));
+}
+
+//
+// Binary strings.
+//
+
+TEST_F(PrettyPrinterTests,
+BinaryStringIsEscapedByDefault) {
+	std::shared_ptr<BItem> data(BString::create(std::string("\x3f\x1a", 2)));
+
+	EXPECT_EQ(BinaryStringFormat::Escaped, printer->getBinaryStringFormat());
+	EXPECT_EQ(R"("?\x1a")", printer->getPrettyRepr(data));
+}
+
+TEST_F(PrettyPrinterTests,
+BinaryStringIsPrintedInHexWhenHexFormatIsSet) {
+	std::shared_ptr<BItem> data(BString::create(std::string("\x3f\x1a\xff", 3)));
+	printer->setBinaryStringFormat(BinaryStringFormat::Hex);
+
+	EXPECT_EQ("<3f1aff>", printer->getPrettyRepr(data));
+}
+
+TEST_F(PrettyPrinterTests,
+BinaryStringIsSummarizedWhenSummaryFormatIsSet) {
+	std::shared_ptr<BList> data(BList::create({
+		BString::create(std::string(20000, '\x01')),
+		BString::create(std::string("\x3f\x1a", 2))
+	}));
+	printer->setBinaryStringFormat(BinaryStringFormat::Summary);
+
+	EXPECT_EQ("[\n    <20000 bytes: 0101010101010101...>,\n"
+		"    <2 bytes: 3f1a>\n]", printer->getPrettyRepr(data));
+}
+
+TEST_F(PrettyPrinterTests,
+TextStringsAreNotConsideredBinary) {
+	std::shared_ptr<BItem> data(BString::create("line 1\n\tline 2\r\n"));
+	printer->setBinaryStringFormat(BinaryStringFormat::Summary);
+
+	EXPECT_EQ(R"("line 1\n\tline 2\r\n")", printer->getPrettyRepr(data));
+}
+
 //
 // Other.
 //
@@ -139,5 +224,60 @@ GetPrettyReprFunctionWorksAsCreatingPrettyPrinterAndCallingGetPrettyRepr) {
 	EXPECT_EQ("{\n    \"test\": 1\n}", getPrettyRepr(bDictionary));
 }
 
+TEST_F(PrettyPrinterTests,
+IndentationOfNestedContainersIsCorrectWhenPrinterIsReused) {
+	std::shared_ptr<BList> bList(BList::create({
+		BList::create({BList::create({BInteger::create(1)})}),
+		BInteger::create(2)
+	}));
+
+	EXPECT_EQ("[\n    [\n        [\n            1\n        ]\n    ],\n    2\n]",
+		printer->getPrettyRepr(bList));
+	EXPECT_EQ("[\n\t[\n\t\t[\n\t\t\t1\n\t\t]\n\t],\n\t2\n]",
+		printer->getPrettyRepr(bList, "\t"));
+}
+
+//
+// Printing into a stream.
+//
+
+TEST_F(PrettyPrinterTests,
+PrintPrettyReprWritesSameReprAsGetPrettyRepr) {
+	std::shared_ptr<BDictionary> bDictionary(BDictionary::create());
+	(*bDictionary)[BString::create("a")] = BList::create({
+		BInteger::create(1), BString::create("x\"y")
+	});
+	(*bDictionary)[BString::create("b")] = BDictionary::create();
+	std::ostringstream output;
+
+	printer->printPrettyRepr(bDictionary, output, "  ");
+
+	EXPECT_EQ(printer->getPrettyRepr(bDictionary, "  "), output.str());
+}
+
+TEST_F(PrettyPrinterTests,
+PrintPrettyReprWritesLargeReprCorrectly) {
+	std::shared_ptr<BList> bList(BList::create());
+	for (int i = 0; i < 20000; ++i) {
+		bList->push_back(BString::create(std::string(i % 100, '"')));
+	}
+	bList->push_back(BString::create(std::string(200000, 'x') + '"'));
+	std::ostringstream output;
+
+	printer->printPrettyRepr(bList, output);
+
+	EXPECT_EQ(getPrettyRepr(bList), output.str());
+}
+
+TEST_F(PrettyPrinterTests,
+PrintPrettyReprFunctionWorksAsCreatingPrettyPrinterAndCallingPrintPrettyRepr) {
+	std::shared_ptr<BItem> data(BInteger::create(42));
+	std::ostringstream output;
+
+	printPrettyRepr(data, output);
+
+	EXPECT_EQ("42", output.str());
+}
+
 } // namespace tests
 } // namespace bencoding
@@ -0,0 +1,268 @@
+/**
+* @file      ScannerTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the Scanner class.
+*/
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Decoder.h"
+#include "Scanner.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class ScannerTests: public Test {
+protected:
+	static std::int64_t readIntegerFrom(const std::string &data);
+};
+
+/**
+* @brief Scans @a data as a single integer and returns its value.
+*/
+std::int64_t ScannerTests::readIntegerFrom(const std::string &data) {
+	Scanner scanner(data);
+	return scanner.readInteger();
+}
+
+//
+// StringRef
+//
+
+TEST_F(ScannerTests,
+StringRefsWithEqualBytesAreEqual) {
+	std::string data("abcabc");
+
+	EXPECT_EQ(StringRef(data.data(), 3), StringRef(data.data() + 3, 3));
+	EXPECT_EQ(StringRef("abc"), StringRef(data.data(), 3));
+}
+
+TEST_F(ScannerTests,
+StringRefsAreOrderedLikeStdStrings) {
+	EXPECT_TRUE(StringRef("ab") < StringRef("abc"));
+	EXPECT_TRUE(StringRef("abc") < StringRef("abd"));
+	EXPECT_FALSE(StringRef("abc") < StringRef("abc"));
+	EXPECT_TRUE(StringRef("a") < StringRef("\xff"));
+}
+
+//
+// Strings
+//
+
+TEST_F(ScannerTests,
+ReadStringReturnsReferenceIntoScannedData) {
+	std::string data("4:test");
+	Scanner scanner(data);
+
+	StringRef str = scanner.readString();
+	EXPECT_EQ("test", str.str());
+	EXPECT_EQ(data.data() + 2, str.data());
+	EXPECT_TRUE(scanner.atEnd());
+}
+
+TEST_F(ScannerTests,
+ReadStringThrowsDecodingErrorWhenLengthExceedsData) {
+	std::string data("99999999999:x");
+	Scanner scanner(data);
+
+	EXPECT_THROW(scanner.readString(), DecodingError);
+}
+
+TEST_F(ScannerTests,
+ReadStringThrowsDecodingErrorWhenColonIsMissing) {
+	std::string data("4test");
+	Scanner scanner(data);
+
+	EXPECT_THROW(scanner.readString(), DecodingError);
+}
+
+//
+// Integers
+//
+
+TEST_F(ScannerTests,
+ReadIntegerReturnsCorrectValue) {
+	EXPECT_EQ(0, readIntegerFrom("i0e"));
+	EXPECT_EQ(42, readIntegerFrom("i42e"));
+	EXPECT_EQ(-42, readIntegerFrom("i-42e"));
+}
+
+TEST_F(ScannerTests,
+ReadIntegerHandlesLimitsOf64BitIntegers) {
+	EXPECT_EQ(std::numeric_limits<std::int64_t>::max(),
+		readIntegerFrom("i9223372036854775807e"));
+	EXPECT_EQ(std::numeric_limits<std::int64_t>::min(),
+		readIntegerFrom("i-9223372036854775808e"));
+}
+
+TEST_F(ScannerTests,
+ReadIntegerThrowsDecodingErrorWhenIntegerDoesNotFitInto64Bits) {
+	EXPECT_THROW(readIntegerFrom("i9223372036854775808e"),
+		DecodingError);
+	EXPECT_THROW(readIntegerFrom("i-9223372036854775809e"),
+		DecodingError);
+}
+
+TEST_F(ScannerTests,
+ReadIntegerThrowsDecodingErrorWhenIntegerIsInvalid) {
+	EXPECT_THROW(readIntegerFrom("ie"), DecodingError);
+	EXPECT_THROW(readIntegerFrom("i-e"), DecodingError);
+	EXPECT_THROW(readIntegerFrom("i03e"), DecodingError);
+	EXPECT_THROW(readIntegerFrom("i3"), DecodingError);
+	EXPECT_THROW(readIntegerFrom("i3xe"), DecodingError);
+}
+
+//
+// Containers
+//
+
+TEST_F(ScannerTests,
+DictionaryCanBeScannedItemByItem) {
+	std::string data("d3:cow3:moo4:spami1ee");
+	Scanner scanner(data);
+
+	scanner.enterDictionary();
+	ASSERT_FALSE(scanner.atContainerEnd());
+	EXPECT_EQ("cow", scanner.readString().str());
+	EXPECT_EQ("moo", scanner.readString().str());
+	ASSERT_FALSE(scanner.atContainerEnd());
+	EXPECT_EQ("spam", scanner.readString().str());
+	EXPECT_EQ(1, scanner.readInteger());
+	ASSERT_TRUE(scanner.atContainerEnd());
+	scanner.leaveContainer();
+	EXPECT_TRUE(scanner.atEnd());
+}
+
+TEST_F(ScannerTests,
+ListCanBeScannedItemByItem) {
+	std::string data("li1e1:ae");
+	Scanner scanner(data);
+
+	scanner.enterList();
+	EXPECT_EQ(1, scanner.readInteger());
+	EXPECT_EQ("a", scanner.readString().str());
+	ASSERT_TRUE(scanner.atContainerEnd());
+	scanner.leaveContainer();
+	EXPECT_TRUE(scanner.atEnd());
+}
+
+TEST_F(ScannerTests,
+AtContainerEndThrowsDecodingErrorWhenContainerIsNotTerminated) {
+	std::string data("l");
+	Scanner scanner(data);
+
+	scanner.enterList();
+	EXPECT_THROW(scanner.atContainerEnd(), DecodingError);
+}
+
+//
+// Skipping
+//
+
+TEST_F(ScannerTests,
+SkipItemReturnsReferenceToEncodedItem) {
+	std::string data("d1:ali1ei2eee4:rest");
+	Scanner scanner(data);
+
+	StringRef item = scanner.skipItem();
+	EXPECT_EQ("d1:ali1ei2eee", item.str());
+	EXPECT_EQ(data.data(), item.data());
+	EXPECT_EQ("rest", scanner.readString().str());
+}
+
+TEST_F(ScannerTests,
+SkipItemSkipsStringsContainingContainerCharacters) {
+	std::string data("l3:eeee");
+	Scanner scanner(data);
+
+	EXPECT_EQ("l3:eeee", scanner.skipItem().str());
+	EXPECT_TRUE(scanner.atEnd());
+}
+
+TEST_F(ScannerTests,
+SkipItemHandlesDeeplyNestedLists) {
+	std::string data(std::string(100000, 'l') + std::string(100000, 'e'));
+	Scanner scanner(data);
+
+	EXPECT_EQ(data.size(), scanner.skipItem().size());
+}
+
+TEST_F(ScannerTests,
+SkipItemThrowsDecodingErrorWhenContainerIsNotTerminated) {
+	std::string data("ld1:a1:b");
+	Scanner scanner(data);
+
+	EXPECT_THROW(scanner.skipItem(), DecodingError);
+}
+
+TEST_F(ScannerTests,
+SkipItemThrowsDecodingErrorWhenIntegerIsMalformed) {
+	for (std::string data : {"iGARBAGEe", "ie", "i-e", "i01e", "li1xee"}) {
+		Scanner scanner(data);
+
+		EXPECT_THROW(scanner.skipItem(), DecodingError) << data;
+	}
+}
+
+TEST_F(ScannerTests,
+SkipItemThrowsDecodingErrorOnUnexpectedEnd) {
+	std::string data("e");
+	Scanner scanner(data);
+
+	EXPECT_THROW(scanner.skipItem(), DecodingError);
+}
+
+//
+// walk()
+//
+
+namespace {
+
+/**
+* @brief Handler for Scanner::walk() that records the reported parts.
+*/
+class RecordingHandler {
+public:
+	void startDictionary() { record += '{'; }
+	void startList() { record += '['; }
+	void endContainer(bool isDictionary) { record += isDictionary ? '}' : ']'; }
+	void key(const StringRef &key) { record += key.str() + ':'; }
+	void integer(std::int64_t value) { record += std::to_string(value); }
+	void string(const StringRef &value) { record += value.str(); }
+	void separator() { record += ','; }
+
+	std::string record;
+};
+
+} // anonymous namespace
+
+TEST_F(ScannerTests,
+WalkReportsAllPartsOfItemInOrder) {
+	std::string data("d1:ali1e1:bdelee1:d2:xye");
+	Scanner scanner(data);
+	RecordingHandler handler;
+
+	scanner.walk(handler);
+
+	EXPECT_EQ("{a:[1,b,{},[]],d:xy}", handler.record);
+	EXPECT_TRUE(scanner.atEnd());
+}
+
+TEST_F(ScannerTests,
+WalkThrowsDecodingErrorWhenThereAreCharactersAfterItem) {
+	std::string data("i1ei2e");
+	Scanner scanner(data);
+	RecordingHandler handler;
+
+	EXPECT_THROW(scanner.walk(handler), DecodingError);
+}
+
+} // namespace tests
+} // namespace bencoding
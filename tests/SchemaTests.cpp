@@ -0,0 +1,236 @@
+/**
+* @file      SchemaTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the binding of bencoded data to C++ structures.
+*/
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "BInteger.h"
+#include "BList.h"
+#include "Schema.h"
+
+namespace bencoding {
+namespace tests {
+
+namespace {
+
+struct FileEntry {
+	std::int64_t length = 0;
+	std::vector<std::string> path;
+};
+
+BENCODING_SCHEMA(FileEntry,
+	BENCODING_FIELD(FileEntry, "length", length),
+	BENCODING_FIELD(FileEntry, "path", path)
+);
+
+struct TorrentInfo {
+	std::vector<FileEntry> files;
+	std::string name;
+	std::uint32_t pieceLength = 0;
+	std::string pieces;
+};
+
+BENCODING_SCHEMA(TorrentInfo,
+	BENCODING_FIELD(TorrentInfo, "files", files),
+	BENCODING_FIELD(TorrentInfo, "name", name),
+	BENCODING_FIELD(TorrentInfo, "piece length", pieceLength),
+	BENCODING_FIELD(TorrentInfo, "pieces", pieces)
+);
+
+struct Message {
+	std::shared_ptr<BItem> arguments;
+	std::map<std::string, std::int16_t> counters;
+	std::int8_t type = 0;
+};
+
+BENCODING_SCHEMA(Message,
+	BENCODING_FIELD(Message, "a", arguments),
+	BENCODING_FIELD(Message, "c", counters),
+	BENCODING_FIELD(Message, "t", type)
+);
+
+} // anonymous namespace
+
+using namespace testing;
+
+class SchemaTests: public Test {};
+
+TEST_F(SchemaTests,
+KeysOfFieldsAreCheckedForOrderAtCompileTime) {
+	static_assert(makeSchemaFields(
+		BENCODING_FIELD(FileEntry, "a", length),
+		BENCODING_FIELD(FileEntry, "b", path)).areKeysSorted(), "");
+	static_assert(!makeSchemaFields(
+		BENCODING_FIELD(FileEntry, "b", length),
+		BENCODING_FIELD(FileEntry, "a", path)).areKeysSorted(), "");
+	static_assert(!makeSchemaFields(
+		BENCODING_FIELD(FileEntry, "a", length),
+		BENCODING_FIELD(FileEntry, "a", path)).areKeysSorted(), "");
+	static_assert(makeSchemaFields(
+		BENCODING_FIELD(FileEntry, "piece length", length),
+		BENCODING_FIELD(FileEntry, "pieces", path)).areKeysSorted(), "");
+}
+
+TEST_F(SchemaTests,
+StructureIsDecodedFromDictionary) {
+	auto info = decodeAs<TorrentInfo>(
+		"d"
+			"5:filesl"
+				"d6:lengthi10e4:pathl1:a1:bee"
+				"d6:lengthi20e4:pathl1:cee"
+			"e"
+			"4:name4:test"
+			"12:piece lengthi16384e"
+			"6:pieces3:xyz"
+		"e"
+	);
+
+	ASSERT_EQ(2, info.files.size());
+	EXPECT_EQ(10, info.files[0].length);
+	EXPECT_EQ(std::vector<std::string>({"a", "b"}), info.files[0].path);
+	EXPECT_EQ(20, info.files[1].length);
+	EXPECT_EQ(std::vector<std::string>({"c"}), info.files[1].path);
+	EXPECT_EQ("test", info.name);
+	EXPECT_EQ(16384, info.pieceLength);
+	EXPECT_EQ("xyz", info.pieces);
+}
+
+TEST_F(SchemaTests,
+UnknownKeysAreSkipped) {
+	auto info = decodeAs<TorrentInfo>(
+		"d1:ali1ee4:name4:test5:otherd1:xi1ee6:pieces3:xyz1:zi0ee");
+
+	EXPECT_EQ("test", info.name);
+	EXPECT_EQ("xyz", info.pieces);
+}
+
+TEST_F(SchemaTests,
+MembersWithMissingKeysKeepTheirValues) {
+	TorrentInfo info;
+	info.name = "default";
+	info.pieceLength = 42;
+
+	decodeInto("d6:pieces3:xyze", info);
+
+	EXPECT_EQ("default", info.name);
+	EXPECT_EQ(42, info.pieceLength);
+	EXPECT_EQ("xyz", info.pieces);
+}
+
+TEST_F(SchemaTests,
+UnsortedKeysAreDecodedCorrectly) {
+	auto info = decodeAs<TorrentInfo>(
+		"d6:pieces3:xyz4:name4:test12:piece lengthi1ee");
+
+	EXPECT_EQ("test", info.name);
+	EXPECT_EQ(1, info.pieceLength);
+	EXPECT_EQ("xyz", info.pieces);
+}
+
+TEST_F(SchemaTests,
+ArbitraryItemsAndDictionariesAreDecoded) {
+	auto message = decodeAs<Message>("d1:ali1ei2ee1:cd1:xi1e1:yi-2ee1:ti3ee");
+
+	auto arguments = message.arguments->as<BList>();
+	ASSERT_TRUE(arguments != nullptr);
+	EXPECT_EQ(2, arguments->size());
+	EXPECT_EQ(2, message.counters.size());
+	EXPECT_EQ(1, message.counters["x"]);
+	EXPECT_EQ(-2, message.counters["y"]);
+	EXPECT_EQ(3, message.type);
+}
+
+TEST_F(SchemaTests,
+DecodingThrowsDecodingErrorWhenTypeDoesNotMatch) {
+	EXPECT_THROW(decodeAs<TorrentInfo>("d4:namei1ee"), DecodingError);
+	EXPECT_THROW(decodeAs<TorrentInfo>("l4:namee"), DecodingError);
+	EXPECT_THROW(decodeAs<std::vector<std::string>>("li1ee"), DecodingError);
+}
+
+TEST_F(SchemaTests,
+DecodingThrowsDecodingErrorWhenIntegerDoesNotFitIntoMember) {
+	EXPECT_THROW(decodeAs<TorrentInfo>("d12:piece lengthi-1ee"), DecodingError);
+	EXPECT_THROW(decodeAs<TorrentInfo>("d12:piece lengthi4294967296ee"),
+		DecodingError);
+	EXPECT_THROW(decodeAs<Message>("d1:ti128ee"), DecodingError);
+	EXPECT_EQ(-128, decodeAs<Message>("d1:ti-128ee").type);
+}
+
+TEST_F(SchemaTests,
+DecodingThrowsDecodingErrorWhenThereAreUndecodedCharacters) {
+	EXPECT_THROW(decodeAs<TorrentInfo>("de1:x"), DecodingError);
+}
+
+TEST_F(SchemaTests,
+DecodingThrowsDecodingErrorWhenDataAreMalformed) {
+	EXPECT_THROW(decodeAs<TorrentInfo>("d4:name4:test"), DecodingError);
+	EXPECT_THROW(decodeAs<TorrentInfo>("d4:name99:teste"), DecodingError);
+}
+
+TEST_F(SchemaTests,
+StructureIsEncodedAsDictionaryWithSortedKeys) {
+	TorrentInfo info;
+	FileEntry file;
+	file.length = 10;
+	file.path = {"a", "b"};
+	info.files.push_back(file);
+	info.name = "test";
+	info.pieceLength = 16384;
+	info.pieces = "xyz";
+
+	EXPECT_EQ(
+		"d"
+			"5:filesld6:lengthi10e4:pathl1:a1:beee"
+			"4:name4:test"
+			"12:piece lengthi16384e"
+			"6:pieces3:xyz"
+		"e",
+		encodeFrom(info)
+	);
+}
+
+TEST_F(SchemaTests,
+LargestUnsignedIntegerFittingIntoInt64IsEncodedAndDecodedBack) {
+	std::uint64_t value = std::numeric_limits<std::int64_t>::max();
+
+	EXPECT_EQ("i9223372036854775807e", encodeFrom(value));
+	EXPECT_EQ(value, decodeAs<std::uint64_t>(encodeFrom(value)));
+}
+
+TEST_F(SchemaTests,
+EncodingThrowsOutOfRangeWhenUnsignedIntegerDoesNotFitIntoInt64) {
+	std::uint64_t value = std::numeric_limits<std::int64_t>::max();
+
+	EXPECT_THROW(encodeFrom(value + 1), std::out_of_range);
+	EXPECT_THROW(encodeFrom(std::numeric_limits<std::uint64_t>::max()),
+		std::out_of_range);
+}
+
+TEST_F(SchemaTests,
+EncodedStructureIsDecodedBackIntoEqualStructure) {
+	Message message;
+	message.arguments = BInteger::create(-5);
+	message.counters["x"] = 7;
+	message.type = -1;
+
+	auto decodedMessage = decodeAs<Message>(encodeFrom(message));
+
+	ASSERT_TRUE(decodedMessage.arguments->as<BInteger>() != nullptr);
+	EXPECT_EQ(-5, decodedMessage.arguments->as<BInteger>()->value());
+	EXPECT_EQ(message.counters, decodedMessage.counters);
+	EXPECT_EQ(-1, decodedMessage.type);
+}
+
+} // namespace tests
+} // namespace bencoding
@@ -0,0 +1,133 @@
+/**
+* @file      ShaTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the SHA-1 and SHA-256 hash functions.
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Sha.h"
+#include "TestUtils.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class ShaTests: public Test {
+protected:
+	static std::string dataOfSize(std::size_t size);
+};
+
+/**
+* @brief Returns deterministic pseudo-random data of the given @a size.
+*/
+std::string ShaTests::dataOfSize(std::size_t size) {
+	std::string data(size, char());
+	unsigned x = 12345;
+	for (auto &c : data) {
+		x = x * 1103515245 + 12345;
+		c = static_cast<char>(x >> 16);
+	}
+	return data;
+}
+
+//
+// SHA-1
+//
+
+TEST_F(ShaTests,
+Sha1OfEmptyDataIsCorrect) {
+	EXPECT_EQ("da39a3ee5e6b4b0d3255bfef95601890afd80709", toHex(sha1("")));
+}
+
+TEST_F(ShaTests,
+Sha1OfShortDataIsCorrect) {
+	EXPECT_EQ("a9993e364706816aba3e25717850c26c9cd0d89d", toHex(sha1("abc")));
+	EXPECT_EQ("2fd4e1c67a2d28fced849ee1bb76e7391b93eb12",
+		toHex(sha1("The quick brown fox jumps over the lazy dog")));
+}
+
+TEST_F(ShaTests,
+Sha1OfMillionCharactersIsCorrect) {
+	EXPECT_EQ("34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+		toHex(sha1(std::string(1000000, 'a'))));
+}
+
+TEST_F(ShaTests,
+Sha1IsTheSameWhenDataAreHashedIncrementally) {
+	std::string data(dataOfSize(1000));
+	Sha1 hash;
+	for (std::size_t i = 0; i < data.size(); i += 7) {
+		hash.update(data.substr(i, 7));
+	}
+
+	EXPECT_EQ(sha1(data), hash.digest());
+}
+
+TEST_F(ShaTests,
+Sha1ImplementationsProduceSameDigestsForAllPaddingLengths) {
+	for (std::size_t size = 0; size < 300; ++size) {
+		std::string data(dataOfSize(size));
+		Sha1 portable(ShaImplementation::Portable);
+		portable.update(data);
+		Sha1 automatic(ShaImplementation::Auto);
+		automatic.update(data);
+
+		ASSERT_EQ(portable.digest(), automatic.digest()) << "size: " << size;
+	}
+}
+
+//
+// SHA-256
+//
+
+TEST_F(ShaTests,
+Sha256OfEmptyDataIsCorrect) {
+	EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+		toHex(sha256("")));
+}
+
+TEST_F(ShaTests,
+Sha256OfShortDataIsCorrect) {
+	EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+		toHex(sha256("abc")));
+	EXPECT_EQ("d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592",
+		toHex(sha256("The quick brown fox jumps over the lazy dog")));
+}
+
+TEST_F(ShaTests,
+Sha256OfMillionCharactersIsCorrect) {
+	EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+		toHex(sha256(std::string(1000000, 'a'))));
+}
+
+TEST_F(ShaTests,
+Sha256IsTheSameWhenDataAreHashedIncrementally) {
+	std::string data(dataOfSize(1000));
+	Sha256 hash;
+	for (std::size_t i = 0; i < data.size(); i += 13) {
+		hash.update(data.substr(i, 13));
+	}
+
+	EXPECT_EQ(sha256(data), hash.digest());
+}
+
+TEST_F(ShaTests,
+Sha256ImplementationsProduceSameDigestsForAllPaddingLengths) {
+	for (std::size_t size = 0; size < 300; ++size) {
+		std::string data(dataOfSize(size));
+		Sha256 portable(ShaImplementation::Portable);
+		portable.update(data);
+		Sha256 automatic(ShaImplementation::Auto);
+		automatic.update(data);
+
+		ASSERT_EQ(portable.digest(), automatic.digest()) << "size: " << size;
+	}
+}
+
+} // namespace tests
+} // namespace bencoding
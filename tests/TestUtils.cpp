@@ -26,5 +26,43 @@ void putIntoEOFState(std::istream &stream) {
 	stream.setstate(std::ios::eofbit);
 }
 
+/**
+* @brief Returns a lowercase hexadecimal representation of @a data.
+*/
+std::string toHex(const std::string &data) {
+	static const char digits[] = "0123456789abcdef";
+	std::string hex;
+	for (auto c : data) {
+		auto byte = static_cast<unsigned char>(c);
+		hex += digits[byte >> 4];
+		hex += digits[byte & 0xf];
+	}
+	return hex;
+}
+
+/**
+* @brief Returns bencoded metadata of a torrent with @a numOfFiles files.
+*
+* The lengths of the files are stored in a dictionary, which gets a hash index
+* when there are at least BDictionary::HASH_INDEX_THRESHOLD files. The paths
+* of the files are decoded as packed lists of strings.
+*/
+std::string createTorrent(std::size_t numOfFiles) {
+	std::string data("d4:infod5:filesl");
+	for (std::size_t i = 0; i < numOfFiles; ++i) {
+		std::string name("file" + std::to_string(i));
+		data += "l3:dir" + std::to_string(name.size()) + ":" + name + "e";
+	}
+	data += "e7:lengthsd";
+	for (std::size_t i = 0; i < numOfFiles; ++i) {
+		// Keys have to be sorted, so they have the same length.
+		std::string key(std::to_string(100000 + i));
+		data += std::to_string(key.size()) + ":" + key + "i" +
+			std::to_string(i) + "e";
+	}
+	data += "e4:name4:testee";
+	return data;
+}
+
 } // namespace tests
 } // namespace bencoding
@@ -8,6 +8,7 @@
 #ifndef BENCODING_TEST_UTILS_H
 #define BENCODING_TEST_UTILS_H
 
+#include <cstddef>
 #include <istream>
 #include <string>
 
@@ -29,6 +30,8 @@ namespace tests {
 
 void putIntoErrorState(std::istream &stream);
 void putIntoEOFState(std::istream &stream);
+std::string toHex(const std::string &data);
+std::string createTorrent(std::size_t numOfFiles);
 
 } // namespace tests
 } // namespace bencoding
@@ -5,6 +5,9 @@
 * @brief     Tests for the utilities.
 */
 
+#include <cstdint>
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "TestUtils.h"
@@ -121,6 +124,174 @@ StrToNumWithInvalidHexadecimalIntegerFails) {
 	EXPECT_EQ(-1, num);
 }
 
+//
+// writeDecimal()
+//
+
+TEST_F(UtilsTests,
+WriteDecimalWritesCorrectRepresentation) {
+	char buffer[MAX_DECIMAL_LENGTH];
+
+	EXPECT_EQ("0", std::string(buffer, writeDecimal(buffer, 0)));
+	EXPECT_EQ("7", std::string(buffer, writeDecimal(buffer, 7)));
+	EXPECT_EQ("10", std::string(buffer, writeDecimal(buffer, 10)));
+	EXPECT_EQ("99", std::string(buffer, writeDecimal(buffer, 99)));
+	EXPECT_EQ("100", std::string(buffer, writeDecimal(buffer, 100)));
+	EXPECT_EQ("12345", std::string(buffer, writeDecimal(buffer, 12345)));
+	EXPECT_EQ("-1", std::string(buffer, writeDecimal(buffer, -1)));
+	EXPECT_EQ("-1000", std::string(buffer, writeDecimal(buffer, -1000)));
+}
+
+TEST_F(UtilsTests,
+WriteDecimalHandlesLimitsOf64BitIntegers) {
+	char buffer[MAX_DECIMAL_LENGTH];
+
+	EXPECT_EQ("9223372036854775807", std::string(buffer,
+		writeDecimal(buffer, std::numeric_limits<std::int64_t>::max())));
+	EXPECT_EQ("-9223372036854775808", std::string(buffer,
+		writeDecimal(buffer, std::numeric_limits<std::int64_t>::min())));
+	EXPECT_EQ("18446744073709551615", std::string(buffer,
+		writeUnsignedDecimal(buffer, std::numeric_limits<std::uint64_t>::max())));
+}
+
+TEST_F(UtilsTests,
+WriteDecimalWorksAsToStringForAllMagnitudes) {
+	char buffer[MAX_DECIMAL_LENGTH];
+	std::int64_t num = 1;
+	for (int i = 0; i < 18; ++i, num *= 10) {
+		EXPECT_EQ(std::to_string(num - 1), std::string(buffer, writeDecimal(buffer, num - 1)));
+		EXPECT_EQ(std::to_string(num), std::string(buffer, writeDecimal(buffer, num)));
+		EXPECT_EQ(std::to_string(-num), std::string(buffer, writeDecimal(buffer, -num)));
+	}
+}
+
+TEST_F(UtilsTests,
+AppendDecimalAppendsRepresentation) {
+	std::string str("i");
+	appendDecimal(str, -42);
+
+	EXPECT_EQ("i-42", str);
+}
+
+//
+// writeEncodedInteger(), writeEncodedStringHeader()
+//
+
+TEST_F(UtilsTests,
+WriteEncodedIntegerWritesIntegerInBencoding) {
+	char buffer[MAX_ENCODED_INTEGER_LENGTH];
+
+	EXPECT_EQ("i0e", std::string(buffer, writeEncodedInteger(buffer, 0)));
+	EXPECT_EQ("i-9223372036854775808e", std::string(buffer,
+		writeEncodedInteger(buffer, std::numeric_limits<std::int64_t>::min())));
+}
+
+TEST_F(UtilsTests,
+WriteEncodedStringHeaderWritesLengthAndColon) {
+	char buffer[MAX_ENCODED_STRING_HEADER_LENGTH];
+
+	EXPECT_EQ("0:", std::string(buffer, writeEncodedStringHeader(buffer, 0)));
+	EXPECT_EQ("4294967295:", std::string(buffer,
+		writeEncodedStringHeader(buffer, 4294967295u)));
+}
+
+TEST_F(UtilsTests,
+AppendEncodedIntegerAndStringHeaderAppendToString) {
+	std::string str("l");
+	appendEncodedInteger(str, 42);
+	appendEncodedStringHeader(str, 4);
+
+	EXPECT_EQ("li42e4:", str);
+}
+
+//
+// parseDecimal()
+//
+
+TEST_F(UtilsTests,
+ParseDecimalWithValidIntegerSucceeds) {
+	const std::string data("0 7 -42 1000");
+	std::int64_t num = 0;
+
+	EXPECT_TRUE(parseDecimal(&data[0], &data[1], num));
+	EXPECT_EQ(0, num);
+	EXPECT_TRUE(parseDecimal(&data[2], &data[3], num));
+	EXPECT_EQ(7, num);
+	EXPECT_TRUE(parseDecimal(&data[4], &data[7], num));
+	EXPECT_EQ(-42, num);
+	EXPECT_TRUE(parseDecimal(&data[8], &data[12], num));
+	EXPECT_EQ(1000, num);
+}
+
+TEST_F(UtilsTests,
+ParseDecimalHandlesLimitsOf64BitIntegers) {
+	const std::string max("9223372036854775807");
+	const std::string min("-9223372036854775808");
+	std::int64_t num = 0;
+
+	EXPECT_TRUE(parseDecimal(max.data(), max.data() + max.size(), num));
+	EXPECT_EQ(std::numeric_limits<std::int64_t>::max(), num);
+	EXPECT_TRUE(parseDecimal(min.data(), min.data() + min.size(), num));
+	EXPECT_EQ(std::numeric_limits<std::int64_t>::min(), num);
+}
+
+TEST_F(UtilsTests,
+ParseDecimalWithInvalidIntegerFailsAndKeepsNumUnchanged) {
+	const std::string invalid[] = {"", "-", "+1", "1a", " 1", "1.0",
+		"9223372036854775808", "-9223372036854775809"};
+	for (const auto &data : invalid) {
+		std::int64_t num = 13;
+		EXPECT_FALSE(parseDecimal(data.data(), data.data() + data.size(), num))
+			<< "data: '" << data << "'";
+		EXPECT_EQ(13, num);
+	}
+}
+
+TEST_F(UtilsTests,
+ParseUnsignedDecimalHandlesLimitOf64BitIntegers) {
+	const std::string max("18446744073709551615");
+	const std::string tooBig("18446744073709551616");
+	std::uint64_t num = 0;
+
+	EXPECT_TRUE(parseUnsignedDecimal(max.data(), max.data() + max.size(), num));
+	EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), num);
+	EXPECT_FALSE(parseUnsignedDecimal(tooBig.data(),
+		tooBig.data() + tooBig.size(), num));
+}
+
+TEST_F(UtilsTests,
+ParseUnsignedDecimalRejectsSign) {
+	const std::string data("-1");
+	std::uint64_t num = 0;
+
+	EXPECT_FALSE(parseUnsignedDecimal(data.data(), data.data() + data.size(), num));
+}
+
+//
+// readDecimalDigits()
+//
+
+TEST_F(UtilsTests,
+ReadDecimalDigitsStopsAtFirstNonDigitAndAppliesSign) {
+	const std::string data("123e");
+	std::int64_t num = 0;
+
+	EXPECT_EQ(&data[3], readDecimalDigits(data.data(),
+		data.data() + data.size(), true, num));
+	EXPECT_EQ(-123, num);
+}
+
+TEST_F(UtilsTests,
+ReadDecimalDigitsHandlesLimitsOf64BitIntegersDependingOnSign) {
+	const std::string magnitude("9223372036854775808");
+	const char *last = magnitude.data() + magnitude.size();
+	std::int64_t num = 0;
+
+	EXPECT_EQ(last, readDecimalDigits(magnitude.data(), last, true, num));
+	EXPECT_EQ(std::numeric_limits<std::int64_t>::min(), num);
+	EXPECT_EQ(nullptr, readDecimalDigits(magnitude.data(), last, false, num));
+}
+
 //
 // readUpTo()
 //
@@ -286,5 +457,84 @@ ReplaceDeletesCharsInStringWhenWithWhatIsEmpty) {
 	EXPECT_EQ("bc", replace("abca", 'a', ""));
 }
 
+//
+// findSpecialChar()
+//
+
+TEST_F(UtilsTests,
+FindSpecialCharReturnsSizeWhenThereIsNoSpecialChar) {
+	const std::string data("plain text that is longer than sixteen characters");
+
+	EXPECT_EQ(data.size(), findSpecialChar(data.data(), data.size(),
+		SpecialChars::EscapedOrNonAscii));
+}
+
+TEST_F(UtilsTests,
+FindSpecialCharFindsQuotesBackslashesAndControlCharsInAndAfterFullChunks) {
+	const std::string prefix(20, 'a');
+
+	EXPECT_EQ(20, findSpecialChar((prefix + "\"").data(), 21,
+		SpecialChars::Escaped));
+	EXPECT_EQ(3, findSpecialChar("abc\\", 4, SpecialChars::Escaped));
+	EXPECT_EQ(20, findSpecialChar((prefix + "\x1f").data(), 21,
+		SpecialChars::Escaped));
+}
+
+TEST_F(UtilsTests,
+FindSpecialCharFindsDelAndNonAsciiCharsOnlyWhenRequested) {
+	const std::string del(std::string(20, 'a') + "\x7f");
+	const std::string nonAscii(std::string(20, 'a') + "\xc3\xa1");
+
+	EXPECT_EQ(del.size(), findSpecialChar(del.data(), del.size(),
+		SpecialChars::Escaped));
+	EXPECT_EQ(20, findSpecialChar(del.data(), del.size(),
+		SpecialChars::EscapedOrDel));
+	EXPECT_EQ(nonAscii.size(), findSpecialChar(nonAscii.data(),
+		nonAscii.size(), SpecialChars::EscapedOrDel));
+	EXPECT_EQ(20, findSpecialChar(nonAscii.data(), nonAscii.size(),
+		SpecialChars::EscapedOrNonAscii));
+}
+
+//
+// containsBinaryChar()
+//
+
+TEST_F(UtilsTests,
+ContainsBinaryCharIgnoresTabsNewlinesAndCarriageReturns) {
+	const std::string text(std::string(20, 'a') + "\t\n\r");
+	const std::string binary(std::string(20, 'a') + '\0');
+
+	EXPECT_FALSE(containsBinaryChar(text.data(), text.size()));
+	EXPECT_TRUE(containsBinaryChar(binary.data(), binary.size()));
+}
+
+//
+// sipHash()
+//
+
+namespace {
+
+const std::uint64_t SIP_KEY0 = 0x0706050403020100ULL;
+const std::uint64_t SIP_KEY1 = 0x0f0e0d0c0b0a0908ULL;
+
+} // anonymous namespace
+
+TEST_F(UtilsTests,
+SipHashReturnsReferenceHashOfEmptyData) {
+	EXPECT_EQ(0x726fdb47dd0e0e31ULL, sipHash("", 0, SIP_KEY0, SIP_KEY1));
+}
+
+TEST_F(UtilsTests,
+SipHashReturnsReferenceHashOfDataNotAlignedToEightBytes) {
+	const char data[] = "\x00\x01\x02\x03\x04\x05\x06\x07"
+		"\x08\x09\x0a\x0b\x0c\x0d\x0e";
+	EXPECT_EQ(0xa129ca6149be45e5ULL, sipHash(data, 15, SIP_KEY0, SIP_KEY1));
+}
+
+TEST_F(UtilsTests,
+SipHashReturnsDifferentHashesForDifferentKeys) {
+	EXPECT_NE(sipHash("abc", 3, 0, 0), sipHash("abc", 3, 0, 1));
+}
+
 } // namespace tests
 } // namespace bencoding
@@ -0,0 +1,129 @@
+/**
+* @file      ValidatorTests.cpp
+* @copyright (c) 2014 by Petr Zemek (s3rvac@gmail.com) and contributors
+* @license   BSD, see the @c LICENSE file for more details
+* @brief     Tests for the validation of canonical bencoded data.
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Decoder.h"
+#include "Validator.h"
+
+namespace bencoding {
+namespace tests {
+
+using namespace testing;
+
+class ValidatorTests: public Test {};
+
+TEST_F(ValidatorTests,
+CanonicalDataAreValid) {
+	EXPECT_TRUE(isCanonical("i0e"));
+	EXPECT_TRUE(isCanonical("i-42e"));
+	EXPECT_TRUE(isCanonical("0:"));
+	EXPECT_TRUE(isCanonical("4:spam"));
+	EXPECT_TRUE(isCanonical("le"));
+	EXPECT_TRUE(isCanonical("de"));
+	EXPECT_TRUE(isCanonical("d3:cow3:moo4:spaml1:a1:bee"));
+	EXPECT_TRUE(isCanonical("d1:a0:2:aa0:1:bi1ee"));
+}
+
+TEST_F(ValidatorTests,
+ValidateDoesNotThrowForCanonicalData) {
+	EXPECT_NO_THROW(validate("d4:infod6:lengthi6e4:name8:file.txtee"));
+}
+
+TEST_F(ValidatorTests,
+DictionaryWithUnsortedKeysIsNotCanonical) {
+	EXPECT_FALSE(isCanonical("d4:spam4:eggs3:cow3:mooe"));
+}
+
+TEST_F(ValidatorTests,
+DictionaryWithDuplicateKeysIsNotCanonical) {
+	EXPECT_FALSE(isCanonical("d3:cowi1e3:cowi2ee"));
+}
+
+TEST_F(ValidatorTests,
+KeysAreComparedAsRawBytes) {
+	EXPECT_TRUE(isCanonical("d1:Z0:1:a0:1:\xff" "0:e"));
+	EXPECT_FALSE(isCanonical("d1:\xff" "0:1:a0:e"));
+}
+
+TEST_F(ValidatorTests,
+KeyOrderIsCheckedInNestedDictionaries) {
+	EXPECT_FALSE(isCanonical("ld1:bi1e1:ai2eee"));
+}
+
+TEST_F(ValidatorTests,
+IntegerWithLeadingZerosIsNotCanonical) {
+	EXPECT_FALSE(isCanonical("i03e"));
+	EXPECT_FALSE(isCanonical("i-03e"));
+	EXPECT_FALSE(isCanonical("i00e"));
+}
+
+TEST_F(ValidatorTests,
+NegativeZeroIsNotCanonical) {
+	EXPECT_FALSE(isCanonical("i-0e"));
+}
+
+TEST_F(ValidatorTests,
+ExplicitlyPositiveIntegerIsNotCanonical) {
+	EXPECT_FALSE(isCanonical("i+1e"));
+}
+
+TEST_F(ValidatorTests,
+IntegerNotFittingInto64BitsIsNotCanonical) {
+	EXPECT_TRUE(isCanonical("i9223372036854775807e"));
+	EXPECT_TRUE(isCanonical("i-9223372036854775808e"));
+	EXPECT_FALSE(isCanonical("i9223372036854775808e"));
+	EXPECT_FALSE(isCanonical("i-9223372036854775809e"));
+}
+
+TEST_F(ValidatorTests,
+StringLengthWithLeadingZerosIsNotCanonical) {
+	EXPECT_FALSE(isCanonical("04:spam"));
+	EXPECT_FALSE(isCanonical("00:"));
+}
+
+TEST_F(ValidatorTests,
+MalformedDataAreNotCanonical) {
+	EXPECT_FALSE(isCanonical(""));
+	EXPECT_FALSE(isCanonical("i1"));
+	EXPECT_FALSE(isCanonical("ie"));
+	EXPECT_FALSE(isCanonical("l"));
+	EXPECT_FALSE(isCanonical("d"));
+	EXPECT_FALSE(isCanonical("di1ei2ee"));
+	EXPECT_FALSE(isCanonical("5:spam"));
+	EXPECT_FALSE(isCanonical("99999999999:x"));
+	EXPECT_FALSE(isCanonical("4spam"));
+	EXPECT_FALSE(isCanonical("e"));
+}
+
+TEST_F(ValidatorTests,
+DataWithTrailingCharactersAreNotCanonical) {
+	EXPECT_FALSE(isCanonical("i1ei2e"));
+}
+
+TEST_F(ValidatorTests,
+TooDeeplyNestedDataAreNotCanonical) {
+	std::size_t depth = MAX_VALIDATED_NESTING_DEPTH + 1;
+
+	EXPECT_FALSE(isCanonical(std::string(depth, 'l') + std::string(depth, 'e')));
+}
+
+TEST_F(ValidatorTests,
+ValidateThrowsDecodingErrorDescribingViolation) {
+	try {
+		validate("d1:bi1e1:ai2ee");
+		FAIL() << "expected DecodingError";
+	} catch (const DecodingError &ex) {
+		EXPECT_EQ("dictionary keys are not sorted at offset 7",
+			std::string(ex.what()));
+	}
+}
+
+} // namespace tests
+} // namespace bencoding